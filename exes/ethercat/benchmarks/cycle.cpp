@@ -0,0 +1,109 @@
+/** \file
+ * \brief Cost of the process data cycle per slave count, measured against a simulated bus
+ *
+ * Usage: ethercat_cycle_benchmark --slaves 1 8 32 128 --cycles 10000
+ *
+ * The line is made of EL1008, EL2008, ATV320 and Eilersen 4x60a slaves in turn. Each cycle exchanges with the
+ * simulated bus and dispatches every device, the io context is run between cycles outside of the measurement.
+ * Signals and slots are registered with a mocked ipc-ruler on the default bus, the session bus when there is one,
+ * so neither the system bus nor a running ipc-ruler is needed.
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <fmt/chrono.h>
+#include <fmt/core.h>
+#include <boost/asio/io_context.hpp>
+#include <boost/program_options.hpp>
+#include <sdbusplus/asio/connection.hpp>
+
+#include <tfc/ec/devices/beckhoff/EL1xxx_impl.hpp>
+#include <tfc/ec/devices/beckhoff/EL2xxx_impl.hpp>
+#include <tfc/ec/devices/beckhoff/EL3xxx_impl.hpp>
+#include <tfc/ec/simulation.hpp>
+#include <tfc/ec/telemetry.hpp>
+#include <tfc/ipc.hpp>
+#include <tfc/ipc/details/dbus_client_iface_mock.hpp>
+#include <tfc/progbase.hpp>
+
+namespace po = boost::program_options;
+namespace simulation = tfc::ec::simulation;
+namespace telemetry = tfc::ec::telemetry;
+
+namespace {
+auto make_line(std::size_t slave_count) -> simulation::bus {
+  simulation::bus bus;
+  for (std::size_t idx = 0; idx < slave_count; idx++) {
+    switch (idx % 4) {
+      case 0:
+        bus.add(simulation::models::el1008{ 10 });
+        break;
+      case 1:
+        bus.add(simulation::models::el2008{});
+        break;
+      case 2:
+        bus.add(simulation::models::atv320{});
+        break;
+      default:
+        bus.add(simulation::models::e4x60a{ 5 });
+        break;
+    }
+  }
+  return bus;
+}
+}  // namespace
+
+auto main(int argc, char* argv[]) -> int {
+  auto description{ tfc::base::default_description() };
+  std::vector<std::size_t> slave_counts{};
+  std::size_t cycles{};
+  description.add_options()("slaves", po::value<std::vector<std::size_t>>(&slave_counts)->multitoken(),
+                            "Slave counts to measure, 1 8 32 128 if none are given")(
+      "cycles", po::value<std::size_t>(&cycles)->default_value(10'000), "Measured cycles per slave count");
+  tfc::base::init(argc, argv, description);
+  if (slave_counts.empty()) {
+    slave_counts = { 1, 8, 32, 128 };
+  }
+
+  static constexpr std::array quantiles{ 0.5, 0.99, 0.999 };
+  static constexpr std::size_t warmup_cycles{ 100 };
+
+  fmt::println("{:>8} {:>10} {:>10} {:>10} {:>10} {:>10} {:>10} {:>12} {:>8}", "slaves", "cycles", "mean", "p50", "p99",
+               "p99.9", "max", "mean/slave", "wkc err");
+  for (auto const slave_count : slave_counts) {
+    boost::asio::io_context ctx;
+    auto connection{ std::make_shared<sdbusplus::asio::connection>(ctx) };
+    tfc::ipc_ruler::ipc_manager_client_mock client{ connection };
+    auto bus{ make_line(slave_count) };
+    simulation::context<tfc::ipc_ruler::ipc_manager_client_mock> simulated{ connection, client, bus };
+
+    for (std::size_t cycle = 0; cycle < warmup_cycles; cycle++) {
+      simulated.processdata();
+      ctx.poll();
+    }
+
+    telemetry::histogram histogram;
+    std::size_t mismatches{};
+    for (std::size_t cycle = 0; cycle < cycles; cycle++) {
+      auto const start{ std::chrono::steady_clock::now() };
+      auto const wkc{ simulated.processdata() };
+      histogram.record(std::chrono::steady_clock::now() - start);
+      if (wkc != simulated.expected_wkc()) {
+        mismatches++;
+      }
+      ctx.poll();
+    }
+
+    auto const result{ telemetry::summarize(histogram.take_snapshot(), quantiles) };
+    auto const per_slave{ result.mean / static_cast<std::chrono::nanoseconds::rep>(std::max(slave_count, 1UZ)) };
+    fmt::println("{:>8} {:>10} {:>10} {:>10} {:>10} {:>10} {:>10} {:>12} {:>8}", slave_count, result.count, result.mean,
+                 result.percentiles[0].value, result.percentiles[1].value, result.percentiles[2].value, result.max,
+                 per_slave, mismatches);
+  }
+  return 0;
+}
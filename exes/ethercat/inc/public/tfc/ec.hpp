@@ -2,20 +2,35 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <cassert>
 #include <chrono>
+#include <memory>
+#include <stop_token>
+#include <thread>
 #include <vector>
 
 #include <fmt/chrono.h>
+#include <glaze/glaze.hpp>
+#include <sdbusplus/asio/object_server.hpp>
 #include <tfc/confman.hpp>
 #include <tfc/dbus/sd_bus.hpp>
 #include <tfc/dbus/string_maker.hpp>
 #include <tfc/ec/common.hpp>
 #include <tfc/ec/config/bus.hpp>
 #include <tfc/ec/devices/device.hpp>
+#include <tfc/ec/realtime.hpp>
+#include <tfc/ec/schedule.hpp>
+#include <tfc/ec/supervision.hpp>
+#include <tfc/ec/telemetry.hpp>
+#include <tfc/ipc.hpp>
+#include <tfc/ipc/details/shm.hpp>
 #include <tfc/ec/soem_interface.hpp>
 #include <tfc/motor/dbus_tags.hpp>
+#include <tfc/stx/glaze_meta.hpp>
 
 namespace tfc::ec {
 using std::chrono::duration;
@@ -31,15 +46,10 @@ public:
   static constexpr std::string_view dbus_name{
     motor::dbus::detail::service
   };  // needs to match the name in motor/dbus_tags.hpp
-  // There is support in SOEM and ethercat to split
-  // your network into groups. There can even be
-  // Many processing loops operating on the same
-  // network at different frequencies and with
-  // different slaves. This is neat but currently
-  // Not beneficial to our use case.
-  // This number indicates that "all" groups
-  // are to be addressed when our code is
-  // interacting with groups.
+  // SOEM can split the network into groups, each with its own part of the io map and its own frames.
+  // Slaves listed in the configured groups are exchanged at their group's cycle time, the others at cycle_time.
+  // SOEM addresses every slave through group 0, so once groups are configured the main group becomes group 1.
+  // The context owns its group list of max_groups, so it is not limited by the EC_MAXGROUP SOEM was built with.
 
   explicit context_t(boost::asio::io_context& ctx) : ctx_(ctx), client_(ctx_) {
     dbus_->request_name(dbus::make_dbus_name(dbus_name).c_str());
@@ -48,7 +58,7 @@ public:
     context_.slavecount = &slave_count_;
     context_.slavelist = slavelist_.data();
     context_.maxslave = ecx::constants::max_slave;
-    context_.maxgroup = ecx::constants::max_group;
+    context_.maxgroup = static_cast<int>(max_groups);
     context_.grouplist = grouplist_.data();
     context_.esibuf = esibuf_.data();
     context_.esimap = esimap_.data();
@@ -74,6 +84,11 @@ public:
       config_.make_change()->primary_interface = config::network_interface{ interfaces[0] };
     }
     logger_.trace("Network interface used: {}", config_->primary_interface.value);
+
+    telemetry_interface_->register_property_r<std::string>(
+        std::string{ statistics_property }, sdbusplus::vtable::property_::emits_change,
+        [this]([[maybe_unused]] std::string const& old_value) -> std::string { return statistics_json_; });
+    telemetry_interface_->initialize();
   }
 
   context_t(const context_t&) = delete;
@@ -81,9 +96,11 @@ public:
   auto operator=(const context_t&) -> context_t& = delete;
 
   ~context_t() {
-    running_ = false;
-    if (check_thread_ != nullptr) {
-      check_thread_->join();
+    cycle_thread_.reset();
+    if (check_thread_.joinable()) {
+      check_thread_.request_stop();
+      supervision_.request();
+      check_thread_.join();
     }
     // Use slave 0 -> virtual for all
     // Set state to init
@@ -96,28 +113,120 @@ public:
   }
 
   auto processdata(std::chrono::microseconds timeout) -> ecx::working_counter_t {
-    ecx_send_overlap_processdata(&context_);
-    auto wkc = ecx::recieve_processdata(&context_, timeout);
-    std::span<std::uint8_t> input;
-    std::span<std::uint8_t> output;
+    auto const sampled_at{ std::chrono::steady_clock::now() };
+    auto wkc = exchange(schedule_.all(), timeout);
+    dispatch(io_, sampled_at);
+    return wkc;
+  }
+
+  /// Send the outputs of a group's part of the io map and receive its inputs
+  auto exchange_group(std::uint8_t group, std::chrono::microseconds timeout) -> ecx::working_counter_t {
+    ecx_send_overlap_processdata_group(&context_, group);
+    return ecx::recieve_processdata_group(&context_, group, timeout);
+  }
+
+  /**
+   * Exchange the process data of the due groups
+   * @param due bit n for the group at index n of the schedule
+   * @return the sum of the latest working counter of every group
+   */
+  auto exchange(group_schedule::mask_t due, std::chrono::microseconds timeout) -> ecx::working_counter_t {
+    ecx::working_counter_t wkc{ 0 };
+    for (std::size_t idx = 0; idx < groups_.size(); idx++) {
+      if ((due >> idx & 1U) != 0) {
+        group_wkc_[idx] = exchange_group(groups_[idx], timeout);
+      }
+      wkc += group_wkc_[idx];
+    }
+    return wkc;
+  }
+
+  /**
+   * Let the slaves of the due groups process their part of a process image.
+   * @param image either the io map itself or a copy of it, slaves are located by their offset into the io map
+   * @param sampled_at time the inputs of the image were exchanged, the values the slaves publish are stamped with it
+   * @param due bit n for the group at index n of the schedule
+   */
+  auto dispatch(std::span<std::byte, pdo_buffer_size> image,
+                std::chrono::steady_clock::time_point sampled_at,
+                group_schedule::mask_t due = ~group_schedule::mask_t{ 0 }) -> void {
+    ipc::details::shm::sample_time const sampled{ sampled_at };
+    health_.load_if_changed(health_view_, health_sequence_);
+    std::span<std::uint8_t> const bytes{ reinterpret_cast<std::uint8_t*>(image.data()), image.size() };
+    for (std::size_t idx = 0; idx < groups_.size(); idx++) {
+      if ((due >> idx & 1U) != 0) {
+        devices::dispatch(dispatch_tables_[groups_[idx]], bytes,
+                          [this](std::uint16_t slave_index) { return health_view_.slaves[slave_index].lost; });
+      }
+    }
+  }
+
+  /**
+   * Put the slaves of each configured group in a SOEM group of its own and schedule the groups.
+   * Without configured groups every slave stays in group 0 at cycle_time.
+   */
+  auto assign_groups() -> void {
+    groups_.assign(1, 0);
+    std::vector<std::chrono::nanoseconds> periods{ config_->cycle_time };
+    if (!config_->groups.empty()) {
+      groups_.front() = 1;
+      for (auto& slave : slave_list_as_span()) {
+        slave.group = 1;
+      }
+      for (auto const& configured : config_->groups) {
+        auto const group{ groups_.size() + 1 };
+        if (group >= max_groups) {
+          logger_.error("At most {} process data groups are supported, the remaining groups stay at cycle_time",
+                        max_groups - 2);
+          break;
+        }
+        for (auto const slave_index : configured.slaves) {
+          if (slave_index == 0 || slave_index > slave_count()) {
+            logger_.warn("Slave {} of process data group {} is not on the bus", slave_index, group - 1);
+            continue;
+          }
+          slavelist_[slave_index].group = static_cast<std::uint8_t>(group);
+        }
+        groups_.emplace_back(static_cast<std::uint8_t>(group));
+        periods.emplace_back(configured.cycle_time);
+      }
+    }
+    schedule_ = group_schedule{ periods };
+    tick_ = 0;
+    group_wkc_.fill(0);
+    logger_.trace("{} process data groups scheduled every {}", groups_.size(), schedule_.tick());
+  }
+
+  /// Map the process data of each group into its own region of the io map, one after the other
+  auto map_groups() -> void {
+    std::size_t used{ 0 };
+    for (auto const group : groups_) {
+      used += ecx::config_overlap_map_group(&context_, std::span(io_.data() + used, io_.size() - used), group);
+    }
+    logger_.trace("Io map uses {} of {} bytes", used, io_.size());
+  }
+
+  /// Resolve each slave's process_data and the location of its process data in the io map, once the io map is configured
+  auto build_dispatch_table() -> void {
+    for (auto& table : dispatch_tables_) {
+      table.clear();
+    }
     for (size_t i = 1; i < slave_count() + 1; i++) {
-      auto& slave{ slavelist_[i] };
+      auto const& slave{ slavelist_[i] };
+      auto const [process_data, device]{ slaves_[i].resolve_process_data() };
+      devices::dispatch_entry entry{ .process_data = process_data,
+                                     .device = device,
+                                     .slave_index = static_cast<std::uint16_t>(i) };
       if (slave.inputs != nullptr) {
-        std::size_t input_size{ slave.Ibytes == 0 ? !!slave.Ibits : slave.Ibytes };
-        input = std::span{ slave.inputs, input_size };
+        entry.input_offset = static_cast<std::uint32_t>(offset_of(slave.inputs));
+        entry.input_size = slave.Ibytes == 0 ? !!slave.Ibits : slave.Ibytes;
       }
       if (slave.outputs != nullptr) {
-        std::size_t output_size{ slave.Obytes == 0 ? !!slave.Obits : slave.Obytes };
-        output = std::span{ slave.outputs, output_size };
-      }
-      if (slave.islost) {
-        slaves_[i].process_data({}, {});
-      } else {
-        slaves_[i].process_data(input, output);
+        entry.output_offset = static_cast<std::uint32_t>(offset_of(slave.outputs));
+        entry.output_size = slave.Obytes == 0 ? !!slave.Obits : slave.Obytes;
       }
+      dispatch_tables_.at(slave.group).emplace_back(entry);
     }
-
-    return wkc;
   }
 
   /**
@@ -130,6 +239,9 @@ public:
       return false;
     }
     // Insert the base device into the vector.
+    for (auto& table : dispatch_tables_) {
+      table.clear();
+    }
     slaves_.clear();
     slaves_.reserve(slave_count() + 1);
     slaves_.emplace_back(std::in_place_type<devices::default_device>, 0);
@@ -143,6 +255,7 @@ public:
       });
       slavelist_[i].PO2SOconfigx = slave_config_callback;
     }
+    assign_groups();
     slave_list_as_span_with_master()[0].state = EC_STATE_PRE_OP | EC_STATE_ACK;
     ecx_writestate(&context_, 0);
     auto lowest = ecx::statecheck(&context_, 0, EC_STATE_PRE_OP, milliseconds(100));
@@ -190,7 +303,8 @@ public:
       logger_.trace("Slave count is correct, current slave count: {}", slave_count());
     }
 
-    ecx::config_overlap_map_group(&context_, std::span(io_.data(), io_.size()), 0);
+    map_groups();
+    build_dispatch_table();
 
     if (!configdc()) {
       throw std::runtime_error("Failed to configure dc");
@@ -215,60 +329,145 @@ public:
 
     processdata(milliseconds{ 2000 });
     // Start async loop
-    expected_wkc_ = context_.grouplist->outputsWKC * 2 + context_.grouplist->inputsWKC;
+    expected_wkc_ = 0;
+    for (auto const group : groups_) {
+      expected_wkc_ += grouplist_[group].outputsWKC * 2 + grouplist_[group].inputsWKC;
+    }
     // Start in ok
     wkc_ = expected_wkc_;
-    async_wait(true);
-    check_thread_ = std::make_unique<std::thread>(&context_t::check_state, this, 0);
+    if (config_->realtime_cycle.enabled) {
+      image_ = io_;
+      cycle_thread_ = std::make_unique<rt::cycle_thread>(config_->realtime_cycle, schedule_.tick(),
+                                                         [this] { realtime_roundtrip(); });
+    } else {
+      async_wait(true);
+    }
+    async_publish_telemetry();
+    check_thread_ = std::jthread{ [this](std::stop_token const& token) { check_state(token, 0); } };
     return {};
   }
 
 private:
   auto async_wait(bool first_iteration = false) -> void {
-    auto timer = std::make_shared<boost::asio::steady_timer>(ctx_);
     if (first_iteration) {
-      timer->expires_after(std::chrono::microseconds(0));
+      cycle_timer_.expires_after(std::chrono::microseconds(0));
     } else {
-      auto sleep_time = config_->cycle_time - (std::chrono::high_resolution_clock::now() - cycle_start_);
-      timer->expires_after(sleep_time);
+      // Deadlines follow the previous deadline so the time spent processing does not accumulate as drift
+      auto const now{ boost::asio::steady_timer::clock_type::now() };
+      auto const deadline{ cycle_timer_.expiry() + schedule_.tick() };
+      if (deadline < now) {
+        telemetry_.overruns.fetch_add(1, std::memory_order_relaxed);
+      }
+      cycle_timer_.expires_at(std::max(deadline, now));
     }
-    cycle_start_with_sleep_ = std::chrono::high_resolution_clock::now();
-    timer->async_wait([this, timer](auto&& PH1) { fieldbus_roundtrip(std::forward<decltype(PH1)>(PH1)); });
+    cycle_start_with_sleep_ = std::chrono::steady_clock::now();
+    cycle_timer_.async_wait([this](auto&& PH1) { fieldbus_roundtrip(std::forward<decltype(PH1)>(PH1)); });
   }
 
-  auto fieldbus_roundtrip(std::error_code err) -> void {
-    cycle_start_ = std::chrono::high_resolution_clock::now();
-    if (err) {
+  /**
+   * One tick of the real time thread.
+   * Only the process data exchange of the due groups happens here, their slaves are dispatched on the io context
+   * from the latest input image. Their outputs are handed back and sent the next time their group is due.
+   */
+  auto realtime_roundtrip() -> void {
+    auto const cycle_start{ std::chrono::steady_clock::now() };
+    record_period(cycle_start);
+    auto const due{ schedule_.due(tick_++) };
+    if (outputs_.fetch()) {
+      copy_regions(outputs_.read_buffer(), io_, &ec_groupt::outputs, &ec_groupt::Obytes);
+    }
+    int32_t const wkc{ exchange(due, microseconds{ 1000 }) };
+    telemetry_.roundtrip.record(std::chrono::steady_clock::now() - cycle_start);
+    wkc_ = wkc;
+    if (wkc < expected_wkc_) {
+      telemetry_.working_counter_mismatches.fetch_add(1, std::memory_order_relaxed);
+      supervision_.request();
+    }
+    copy_regions(io_, inputs_.write_buffer().io, &ec_groupt::inputs, &ec_groupt::Ibytes);
+    inputs_.write_buffer().sampled_at = cycle_start;
+    // Groups due while a dispatch is pending are dispatched together with it. They are marked before the image is
+    // published, so a dispatch which fetches this image also sees its groups.
+    pending_groups_.fetch_or(due, std::memory_order_release);
+    inputs_.publish();
+    // A single pending dispatch is enough, it will pick up whichever image is the latest when it runs
+    if (!dispatch_pending_.exchange(true, std::memory_order_acq_rel)) {
+      boost::asio::post(ctx_, [this] {
+        dispatch_pending_.store(false, std::memory_order_release);
+        realtime_dispatch();
+      });
+    }
+  }
+
+  /// The io context side of the real time cycle
+  auto realtime_dispatch() -> void {
+    if (!inputs_.fetch()) {
       return;
     }
-    int32_t last_wkc = wkc_;
-    wkc_ = processdata(microseconds{ 1000 });
-    if (wkc_ < expected_wkc_ && wkc_ != last_wkc) {  // Don't wot over an already logged fault.
-      last_cycle_with_sleep_ = std::chrono::high_resolution_clock::now() - cycle_start_with_sleep_;
-      logger_.warn("Working counter got {} expected {}, processdata recv took: {}", wkc_, expected_wkc_, last_cycle_with_sleep_);
+    auto const due{ pending_groups_.exchange(0, std::memory_order_acquire) };
+    copy_regions(inputs_.read_buffer().io, image_, &ec_groupt::inputs, &ec_groupt::Ibytes);
+    auto const dispatch_start{ std::chrono::steady_clock::now() };
+    dispatch(image_, inputs_.read_buffer().sampled_at, due);
+    telemetry_.processing.record(std::chrono::steady_clock::now() - dispatch_start);
+    // Every group's outputs are handed back, the buffer written to may hold an image older than the last one
+    copy_regions(image_, outputs_.write_buffer(), &ec_groupt::outputs, &ec_groupt::Obytes);
+    outputs_.publish();
+
+    int32_t const wkc{ wkc_ };
+    if (wkc < expected_wkc_ && wkc != last_dispatched_wkc_) {
+      logger_.warn("Working counter got {} expected {}", wkc, expected_wkc_);
     }
+    last_dispatched_wkc_ = wkc;
     while (ecx_iserror(&context_) != 0U) {
       logger_.error("Ethercat context error: {}", ecx_elist2string(&context_));
     }
-    // Update counter and timers now that this cycle is complete
-    last_cycle_with_sleep_ = std::chrono::high_resolution_clock::now() - cycle_start_with_sleep_;
-    min_cycle_with_sleep_ = std::min(min_cycle_with_sleep_, last_cycle_with_sleep_);
-    max_cycle_with_sleep_ = std::max(max_cycle_with_sleep_, last_cycle_with_sleep_);
-
-    last_cycle_ = std::chrono::high_resolution_clock::now() - cycle_start_;
-    min_cycle_ = std::min(min_cycle_, last_cycle_);
-    max_cycle_ = std::max(max_cycle_, last_cycle_);
+  }
 
-    if (cycle_count_ % 10'000 == 0 and false) {
-      // log the max cycle time
-      logger_.trace("Ethercat max cycle time: {} us", max_cycle_.count());
-      logger_.trace("Ethercat max cycle time with sleep: {} us", max_cycle_with_sleep_.count());
-      logger_.trace("Ethercat min cycle time: {} us", min_cycle_.count());
-      logger_.trace("Ethercat min cycle time with sleep: {} us", min_cycle_with_sleep_.count());
+  /// Copy either the outputs or the inputs of every group from one process image to another
+  auto copy_regions(std::array<std::byte, pdo_buffer_size> const& from,
+                    std::array<std::byte, pdo_buffer_size>& to,
+                    std::uint8_t* ec_groupt::*region,
+                    std::uint32_t ec_groupt::*size) -> void {
+    for (auto const group : groups_) {
+      auto const& soem_group{ grouplist_[group] };
+      if (soem_group.*size == 0) {
+        continue;
+      }
+      auto const offset{ offset_of(soem_group.*region) };
+      std::copy_n(std::next(from.begin(), offset), soem_group.*size, std::next(to.begin(), offset));
     }
+  }
 
-    cycle_count_++;
+  /// \return the offset of a pointer into the io map
+  [[nodiscard]] auto offset_of(std::uint8_t const* pointer) const noexcept -> std::size_t {
+    return static_cast<std::size_t>(reinterpret_cast<std::byte const*>(pointer) - io_.data());
+  }
 
+  auto fieldbus_roundtrip(std::error_code err) -> void {
+    if (err) {
+      return;
+    }
+    auto const cycle_start{ std::chrono::steady_clock::now() };
+    record_period(cycle_start);
+    auto const due{ schedule_.due(tick_++) };
+    int32_t last_wkc = wkc_;
+    int32_t const wkc = exchange(due, microseconds{ 1000 });
+    auto const exchanged{ std::chrono::steady_clock::now() };
+    telemetry_.roundtrip.record(exchanged - cycle_start);
+    wkc_ = wkc;
+    dispatch(io_, cycle_start, due);
+    telemetry_.processing.record(std::chrono::steady_clock::now() - exchanged);
+    if (wkc < expected_wkc_) {
+      telemetry_.working_counter_mismatches.fetch_add(1, std::memory_order_relaxed);
+      supervision_.request();
+      if (wkc != last_wkc) {  // Don't wot over an already logged fault.
+        logger_.warn("Working counter got {} expected {}, processdata recv took: {}", wkc, expected_wkc_,
+                     duration_cast<microseconds>(exchanged - cycle_start));
+      }
+    }
+    while (ecx_iserror(&context_) != 0U) {
+      logger_.error("Ethercat context error: {}", ecx_elist2string(&context_));
+    }
+    last_cycle_with_sleep_ = std::chrono::steady_clock::now() - cycle_start_with_sleep_;
     if (last_cycle_with_sleep_ > std::chrono::milliseconds(100)) {
       logger_.warn("Ethercat cycle time is too long: {}",
                    std::chrono::duration_cast<std::chrono::microseconds>(last_cycle_with_sleep_));
@@ -276,64 +475,142 @@ private:
     async_wait();
   }
 
+  auto record_period(std::chrono::steady_clock::time_point cycle_start) -> void {
+    if (last_cycle_start_ != std::chrono::steady_clock::time_point{}) {
+      telemetry_.period.record(cycle_start - last_cycle_start_);
+    }
+    last_cycle_start_ = cycle_start;
+  }
+
+  auto async_publish_telemetry() -> void {
+    telemetry_timer_.expires_after(config_->cycle_telemetry.interval);
+    telemetry_timer_.async_wait([this](std::error_code const& err) {
+      if (err) {
+        return;
+      }
+      publish_telemetry();
+      async_publish_telemetry();
+    });
+  }
+
+  /// Publish the cycle timing since the last report on ipc and dbus
+  auto publish_telemetry() -> void {
+    auto const period{ telemetry_.period.take_snapshot() };
+    auto const roundtrip{ telemetry_.roundtrip.take_snapshot() };
+    auto const processing{ telemetry_.processing.take_snapshot() };
+    auto const overruns{ telemetry_.overruns.load(std::memory_order_relaxed) +
+                         (cycle_thread_ ? cycle_thread_->overruns() : std::uint64_t{ 0 }) };
+    auto const mismatches{ telemetry_.working_counter_mismatches.load(std::memory_order_relaxed) };
+    std::span<double const> const quantiles{ config_->cycle_telemetry.percentiles };
+    telemetry::statistics const statistics{ .period = telemetry::summarize(period - last_period_, quantiles),
+                                            .roundtrip = telemetry::summarize(roundtrip - last_roundtrip_, quantiles),
+                                            .processing = telemetry::summarize(processing - last_processing_, quantiles),
+                                            .overruns = overruns - last_overruns_,
+                                            .working_counter_mismatches = mismatches - last_mismatches_ };
+    last_period_ = period;
+    last_roundtrip_ = roundtrip;
+    last_processing_ = processing;
+    last_overruns_ = overruns;
+    last_mismatches_ = mismatches;
+
+    auto json{ glz::write_json(statistics) };
+    if (!json) {
+      logger_.warn("Unable to serialize cycle statistics: {}", glz::format_error(json.error(), ""));
+      return;
+    }
+    statistics_json_ = std::move(json.value());
+    logger_.trace("Cycle statistics: {}", statistics_json_);
+    telemetry_interface_->set_property(std::string{ statistics_property }, statistics_json_);
+    auto const log_error{ [this](std::error_code const& send_err, std::size_t) {
+      if (send_err) {
+        logger_.warn("Unable to send cycle statistics: {}", send_err.message());
+      }
+    } };
+    statistics_signal_.async_send(statistics_json_, log_error);
+    overruns_signal_.async_send(overruns, log_error);
+    mismatches_signal_.async_send(mismatches, log_error);
+  }
+
   /**
    * Check the state of attached slaves.
    * If the slaves are no longer in operational mode. Attempt to
    * switch them to operational mode. And if the slaves have
    * been lost attempt to add them again.
+   * Instead of polling, the check sleeps until the cycle reports a working counter below the expected one.
+   * It then keeps checking every 10 ms until the bus has recovered.
    * @param group_index 0 for all groups
    */
-  auto check_state(uint8_t group_index = 0) -> void {
+  auto check_state(std::stop_token const& token, uint8_t group_index = 0) -> void {
     auto& grp = group_list_as_span()[group_index];
-    while (running_) {
-      if (grp.docheckstate == 1 || wkc_ < expected_wkc_) {
-        grp.docheckstate = FALSE;
-        ecx_readstate(&context_);
-        auto slaves = slave_list_as_span();
-        uint16_t slave_index = 1;
-        for (ec_slave& slave : slaves) {
-          if (slave.state != EC_STATE_OPERATIONAL) {
-            grp.docheckstate = TRUE;
-            if (slave.state == EC_STATE_SAFE_OP + EC_STATE_ERROR) {
-              logger_.warn("Slave {}, {} is in SAFE_OP+ERROR, attempting ACK", slave_index, slave.name);
-              slave.state = EC_STATE_SAFE_OP + EC_STATE_ACK;
-              ecx_writestate(&context_, slave_index);
-            } else if (slave.state == EC_STATE_SAFE_OP) {
-              logger_.warn("Slave {}, {} is in SAFE_OP, change to OPERATIONAL", slave_index, slave.name);
-              slave.state = EC_STATE_OPERATIONAL;
-              ecx_writestate(&context_, slave_index);
-            } else if (slave.state > EC_STATE_NONE) {
-              if (ecx_reconfig_slave(&context_, slave_index, EC_TIMEOUTRET) != 0) {
-                slave.islost = FALSE;
-                logger_.warn("Slave {}, {} reconfigured", slave_index, slave.name);
-              }
-            } else if (slave.islost == 0) {
-              ecx_statecheck(&context_, slave_index, EC_STATE_OPERATIONAL, EC_TIMEOUTRET);
-              if (slave.state == EC_STATE_NONE) {
-                slave.islost = TRUE;
-                logger_.warn("Slave {}, {} lost", slave_index, slave.name);
-              }
-            }
-          }
-          if (slave.islost == 1) {
-            if (slave.state != EC_STATE_NONE) {
-              slave.islost = FALSE;
-              logger_.info("Slave {}, {} found", slave_index, slave.name);
-            } else if (ecx_recover_slave(&context_, slave_index, EC_TIMEOUTRET) != 0) {
+    bool recovering{ false };
+    while (!token.stop_requested()) {
+      if (recovering) {
+        std::this_thread::sleep_for(milliseconds(10));
+      } else {
+        supervision_.wait();
+        if (token.stop_requested()) {
+          return;
+        }
+      }
+      grp.docheckstate = FALSE;
+      ecx_readstate(&context_);
+      auto slaves = slave_list_as_span();
+      uint16_t slave_index = 1;
+      for (ec_slave& slave : slaves) {
+        if (slave.state != EC_STATE_OPERATIONAL) {
+          grp.docheckstate = TRUE;
+          if (slave.state == EC_STATE_SAFE_OP + EC_STATE_ERROR) {
+            logger_.warn("Slave {}, {} is in SAFE_OP+ERROR, attempting ACK", slave_index, slave.name);
+            slave.state = EC_STATE_SAFE_OP + EC_STATE_ACK;
+            ecx_writestate(&context_, slave_index);
+          } else if (slave.state == EC_STATE_SAFE_OP) {
+            logger_.warn("Slave {}, {} is in SAFE_OP, change to OPERATIONAL", slave_index, slave.name);
+            slave.state = EC_STATE_OPERATIONAL;
+            ecx_writestate(&context_, slave_index);
+          } else if (slave.state > EC_STATE_NONE) {
+            if (ecx_reconfig_slave(&context_, slave_index, EC_TIMEOUTRET) != 0) {
               slave.islost = FALSE;
-              logger_.info("Slave {}, {} recovered", slave_index, slave.name);
+              logger_.warn("Slave {}, {} reconfigured", slave_index, slave.name);
+            }
+          } else if (slave.islost == 0) {
+            ecx_statecheck(&context_, slave_index, EC_STATE_OPERATIONAL, EC_TIMEOUTRET);
+            if (slave.state == EC_STATE_NONE) {
+              slave.islost = TRUE;
+              logger_.warn("Slave {}, {} lost", slave_index, slave.name);
             }
           }
-          slave_index++;
         }
-        if (context_.grouplist->docheckstate == 0) {
-          logger_.info("All slaves resumed OPERATIONAL");
+        if (slave.islost == 1) {
+          if (slave.state != EC_STATE_NONE) {
+            slave.islost = FALSE;
+            logger_.info("Slave {}, {} found", slave_index, slave.name);
+          } else if (ecx_recover_slave(&context_, slave_index, EC_TIMEOUTRET) != 0) {
+            slave.islost = FALSE;
+            logger_.info("Slave {}, {} recovered", slave_index, slave.name);
+          }
         }
+        slave_index++;
       }
-      std::this_thread::sleep_for(milliseconds(10));
+      publish_health();
+      if (grp.docheckstate == FALSE && recovering) {
+        logger_.info("All slaves resumed OPERATIONAL");
+      }
+      recovering = grp.docheckstate == TRUE || wkc_ < expected_wkc_;
     }
   }
 
+  /// Publish the slave states read by the supervisor for the cycle and other threads
+  auto publish_health() -> void {
+    health_t health{};
+    auto const slaves{ slave_list_as_span_with_master() };
+    for (std::size_t idx = 1; idx < slaves.size(); idx++) {
+      health.slaves[idx] = { .state = slaves[idx].state,
+                             .al_status_code = slaves[idx].ALstatuscode,
+                             .lost = slaves[idx].islost != FALSE };
+    }
+    health_.store(health);
+  }
+
   /**
    * A callback function used to get passed the void* behaviour
    * of the underlying library. We only get a single void*
@@ -370,12 +647,14 @@ private:
   boost::asio::io_context& ctx_;
   ecx_contextt context_{};
   std::vector<devices::device<ipc_ruler::ipc_manager_client>> slaves_;
+  // Dispatch tables indexed by SOEM group
+  std::array<std::vector<devices::dispatch_entry>, max_groups> dispatch_tables_;
 
   // Stack allocations for pointers inside ec_contextt.
   ecx_portt port_;
   std::array<ec_slavet, ecx::constants::max_slave> slavelist_;
   int slave_count_ = 0;
-  std::array<ec_groupt, ecx::constants::max_group> grouplist_;
+  std::array<ec_groupt, max_groups> grouplist_;
   std::array<uint8, ecx::constants::max_eeprom_buffer> esibuf_;
   std::array<uint32, ecx::constants::max_eeprom_bitmap> esimap_;
   ec_eringt elist_;
@@ -387,29 +666,68 @@ private:
   std::array<ec_PDOdesct, ecx::constants::max_concurrent_map_thread> PDOdesc_;
   ec_eepromSMt eep_SM_;
   ec_eepromFMMUt eepFMMU_;
-  bool running_ = true;
 
   tfc::ipc_ruler::ipc_manager_client client_;
 
   // Timing related variables
-  std::chrono::nanoseconds min_cycle_with_sleep_ = std::chrono::nanoseconds::max();
-  std::chrono::nanoseconds max_cycle_with_sleep_ = std::chrono::nanoseconds::min();
   std::chrono::nanoseconds last_cycle_with_sleep_ = std::chrono::nanoseconds::zero();
-  std::chrono::nanoseconds last_cycle_ = std::chrono::nanoseconds::zero();
-  std::chrono::nanoseconds min_cycle_ = std::chrono::nanoseconds::max();
-  std::chrono::nanoseconds max_cycle_ = std::chrono::nanoseconds::min();
-  std::chrono::time_point<std::chrono::high_resolution_clock> cycle_start_with_sleep_;
-  std::chrono::time_point<std::chrono::high_resolution_clock> cycle_start_;
-  size_t cycle_count_ = 0;
+  std::chrono::steady_clock::time_point cycle_start_with_sleep_;
+  std::chrono::steady_clock::time_point last_cycle_start_;
+  telemetry::cycle_recorder telemetry_;
+  // SOEM groups in the order of the schedule, their latest working counters and the tick of the schedule
+  std::vector<std::uint8_t> groups_{ 0 };
+  group_schedule schedule_{};
+  std::uint64_t tick_{ 0 };
+  std::array<ecx::working_counter_t, max_groups> group_wkc_{};
   int32_t expected_wkc_ = 0;
-  int32_t wkc_ = 0;
+  std::atomic<int32_t> wkc_ = 0;
+  int32_t last_dispatched_wkc_ = 0;
   std::array<std::byte, pdo_buffer_size> io_;
-  std::unique_ptr<std::thread> check_thread_;
+  boost::asio::steady_timer cycle_timer_{ ctx_ };
+
+  // Hand-off of process images between the real time thread and the io context
+  struct input_image {
+    std::array<std::byte, pdo_buffer_size> io{};
+    std::chrono::steady_clock::time_point sampled_at{};  // start of the exchange which received the inputs
+  };
+  rt::triple_buffer<input_image> inputs_;
+  rt::triple_buffer<std::array<std::byte, pdo_buffer_size>> outputs_;
+  std::array<std::byte, pdo_buffer_size> image_{};
+  std::atomic<bool> dispatch_pending_{ false };
+  std::atomic<group_schedule::mask_t> pending_groups_{ 0 };
+  std::unique_ptr<rt::cycle_thread> cycle_thread_;
+
+  // Slave supervision, the supervisor thread is the only writer of slave states
+  using health_t = supervision::bus_health<ecx::constants::max_slave>;
+  supervision::trigger supervision_;
+  supervision::seqlock<health_t> health_;
+  health_t health_view_{};
+  std::uint64_t health_sequence_{ 0 };
+  std::jthread check_thread_;
   std::shared_ptr<sdbusplus::asio::connection> dbus_{
     std::make_shared<sdbusplus::asio::connection>(ctx_, dbus::sd_bus_open_system())
   };
   tfc::confman::config<config::ethercat> config_{ dbus_, "ethercat" };
   tfc::logger::logger logger_{ "ethercat" };
+
+  // Cycle timing reports, the last snapshots are kept to report each interval on its own
+  static constexpr std::string_view statistics_property{ "CycleStatistics" };
+  boost::asio::steady_timer telemetry_timer_{ ctx_ };
+  telemetry::histogram::snapshot last_period_{};
+  telemetry::histogram::snapshot last_roundtrip_{};
+  telemetry::histogram::snapshot last_processing_{};
+  std::uint64_t last_overruns_{};
+  std::uint64_t last_mismatches_{};
+  std::string statistics_json_{ "{}" };
+  std::shared_ptr<sdbusplus::asio::dbus_interface> telemetry_interface_{
+    std::make_shared<sdbusplus::asio::dbus_interface>(dbus_,
+                                                      dbus::make_dbus_path("ethercat"),
+                                                      dbus::make_dbus_name("Ethercat"))
+  };
+  ipc::json_signal statistics_signal_{ ctx_, client_, "cycle_statistics", "Cycle timing statistics of the last interval" };
+  ipc::uint_signal overruns_signal_{ ctx_, client_, "cycle_overruns", "Count of cycles which missed their deadline" };
+  ipc::uint_signal mismatches_signal_{ ctx_, client_, "working_counter_mismatches",
+                                       "Count of cycles with a lower working counter than expected" };
 };
 
 // Template deduction guide
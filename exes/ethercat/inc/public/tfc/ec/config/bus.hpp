@@ -1,5 +1,8 @@
 #pragma once
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -39,15 +42,64 @@ struct glz::detail::to_json_schema<tfc::ec::config::network_interface> {
 };
 
 namespace tfc::ec::config {
+struct realtime {
+  bool enabled{ false };
+  std::optional<int> priority{ 80 };
+  std::optional<std::size_t> cpu{ std::nullopt };
+  bool lock_memory{ true };
+  struct glaze {
+    // clang-format off
+    static constexpr auto value{ glz::object("enabled", &realtime::enabled, "Run the process data cycle in a dedicated real time thread",
+                                             "priority", &realtime::priority, "SCHED_FIFO priority of the cycle thread, empty keeps the default scheduler",
+                                             "cpu", &realtime::cpu, "Pin the cycle thread to this cpu",
+                                             "lock_memory", &realtime::lock_memory, "Lock the process memory to avoid page faults in the cycle"
+                                             ) };
+    // clang-format on
+    static constexpr std::string_view name{ "config::realtime" };
+  };
+};
+
+struct telemetry {
+  std::vector<double> percentiles{ 0.5, 0.9, 0.99, 0.999 };
+  std::chrono::seconds interval{ 10 };
+  struct glaze {
+    // clang-format off
+    static constexpr auto value{ glz::object("percentiles", &telemetry::percentiles, "Quantiles of the cycle timing to report, each in the range [0, 1]",
+                                             "interval", &telemetry::interval, "Interval between cycle timing reports"
+                                             ) };
+    // clang-format on
+    static constexpr std::string_view name{ "config::telemetry" };
+  };
+};
+
+struct process_data_group {
+  std::vector<std::uint16_t> slaves{};
+  std::chrono::microseconds cycle_time{ std::chrono::milliseconds{ 10 } };
+  struct glaze {
+    // clang-format off
+    static constexpr auto value{ glz::object("slaves", &process_data_group::slaves, "Indexes of the slaves in this group, starting at 1",
+                                             "cycle_time", &process_data_group::cycle_time, "The scan time of this group"
+                                             ) };
+    // clang-format on
+    static constexpr std::string_view name{ "config::process_data_group" };
+  };
+};
+
 struct ethercat {
   network_interface primary_interface{ common::get_interfaces().at(0) };
   confman::observable<std::optional<std::size_t>> required_slave_count{ std::nullopt };
   std::chrono::microseconds cycle_time{ std::chrono::milliseconds{ 1 } };
+  realtime realtime_cycle{};
+  telemetry cycle_telemetry{};
+  std::vector<process_data_group> groups{};
   struct glaze {
     // clang-format off
     static constexpr auto value{ glz::object("primary_interface", &ethercat::primary_interface, "Primary interface",
                                              "required_slave_count", &ethercat::required_slave_count, "Required slave count",
-                                             "cycle_time", &ethercat::cycle_time, "The scan time for the ethercat network, between each poll."
+                                             "cycle_time", &ethercat::cycle_time, "The scan time for the ethercat network, between each poll.",
+                                             "realtime", &ethercat::realtime_cycle, "Real time cycle thread",
+                                             "telemetry", &ethercat::cycle_telemetry, "Cycle timing statistics",
+                                             "groups", &ethercat::groups, "Slaves exchanging process data at their own scan time, the other slaves stay at cycle_time"
                                              ) };
     // clang-format on
     static constexpr std::string_view name{ "config::ethercat" };
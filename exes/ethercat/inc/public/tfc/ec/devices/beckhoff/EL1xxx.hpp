@@ -2,10 +2,13 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <span>
 #include <vector>
 
+#include <tfc/confman.hpp>
 #include <tfc/ec/devices/base.hpp>
+#include <tfc/ec/devices/beckhoff/digital_io.hpp>
 #include <tfc/ipc/details/dbus_client_iface.hpp>
 #include <tfc/ipc/details/type_description.hpp>
 #include <tfc/ipc_fwd.hpp>
@@ -21,8 +24,9 @@ template <typename manager_client_type,
           std::array<std::size_t, size> entries,
           uint32_t pc,
           stx::basic_fixed_string name_v,
-          template <typename description_t, typename manager_client_t> typename signal_t = ipc::signal>
-class el1xxx final : public base<el1xxx<manager_client_type, size, entries, pc, name_v, signal_t>> {
+          template <typename description_t, typename manager_client_t> typename signal_t = ipc::signal,
+          template <typename, typename, typename> typename confman_t = confman::config>
+class el1xxx final : public base<el1xxx<manager_client_type, size, entries, pc, name_v, signal_t, confman_t>> {
 public:
   using input_pdo = std::array<std::uint8_t, (size / 9) + 1>;
 
@@ -36,25 +40,49 @@ public:
   void pdo_cycle(input_pdo const& input, std::span<std::uint8_t>) noexcept;
 
   auto transmitters() const noexcept -> auto const& { return transmitters_; }
+  /// Signal carrying all inputs of the terminal in one word, input n in bit n
+  auto packed_transmitter() const noexcept -> auto const& { return packed_transmitter_; }
+  /// Configuration shared by every terminal of this type
+  auto config() const noexcept -> auto const& { return config_; }
 
 private:
-  std::array<std::optional<bool>, size> last_values_{};
   using bool_signal_t = signal_t<ipc::details::type_bool, manager_client_type&>;
+  using uint_signal_t = signal_t<ipc::details::type_uint, manager_client_type&>;
+  std::optional<std::uint64_t> last_word_{};
+  // channel signals are not updated while they are off
+  bool channel_signals_on_{ true };
   std::array<std::shared_ptr<bool_signal_t>, size> transmitters_;
+  std::shared_ptr<uint_signal_t> packed_transmitter_;
+  using config_t =
+      confman_t<digital_io_config, confman::file_storage<digital_io_config>, confman::detail::config_dbus_client>;
+  std::shared_ptr<config_t> config_;
 };
 
-template <typename manager_client_type, template <typename, typename> typename signal_t = ipc::signal>
-using el1002 = el1xxx<manager_client_type, 2, std::to_array<std::size_t>({ 1, 5 }), 0x3ea3052, "el1002", signal_t>;
-template <typename manager_client_type, template <typename, typename> typename signal_t = ipc::signal>
-using el1008 =
-    el1xxx<manager_client_type, 8, std::to_array<std::size_t>({ 1, 5, 2, 6, 3, 7, 4, 8 }), 0x3f03052, "el1008", signal_t>;
-template <typename manager_client_type, template <typename, typename> typename signal_t = ipc::signal>
+template <typename manager_client_type,
+          template <typename, typename> typename signal_t = ipc::signal,
+          template <typename, typename, typename> typename confman_t = confman::config>
+using el1002 =
+    el1xxx<manager_client_type, 2, std::to_array<std::size_t>({ 1, 5 }), 0x3ea3052, "el1002", signal_t, confman_t>;
+template <typename manager_client_type,
+          template <typename, typename> typename signal_t = ipc::signal,
+          template <typename, typename, typename> typename confman_t = confman::config>
+using el1008 = el1xxx<manager_client_type,
+                      8,
+                      std::to_array<std::size_t>({ 1, 5, 2, 6, 3, 7, 4, 8 }),
+                      0x3f03052,
+                      "el1008",
+                      signal_t,
+                      confman_t>;
+template <typename manager_client_type,
+          template <typename, typename> typename signal_t = ipc::signal,
+          template <typename, typename, typename> typename confman_t = confman::config>
 using el1809 = el1xxx<manager_client_type,
                       16,
                       std::to_array<std::size_t>({ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 }),
                       0x7113052,
                       "el1809",
-                      signal_t>;
+                      signal_t,
+                      confman_t>;
 
 using imc = tfc::ipc_ruler::ipc_manager_client;
 extern template class el1xxx<imc, el1002<imc>::size_v, el1002<imc>::entries_v, el1002<imc>::product_code, el1002<imc>::name>;
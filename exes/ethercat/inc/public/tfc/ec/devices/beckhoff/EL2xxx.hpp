@@ -9,6 +9,7 @@
 #include <vector>
 
 #include <tfc/ec/devices/base.hpp>
+#include <tfc/ec/devices/beckhoff/digital_io.hpp>
 #include <tfc/ipc/details/type_description.hpp>
 #include <tfc/ipc_fwd.hpp>
 #include <tfc/stx/basic_fixed_string.hpp>
@@ -38,10 +39,13 @@ public:
   void pdo_cycle(std::span<std::uint8_t>, output_pdo& output) noexcept;
 
   auto set_output(size_t position, bool value) -> void { output_states_.set(position, value); }
+  /// Set every output at once, output n from bit n
+  auto set_outputs(std::uint64_t value) -> void { output_states_ = std::bitset<size>{ value & channel_mask<size> }; }
 
 private:
   std::bitset<size> output_states_;
   std::vector<std::shared_ptr<ipc::slot<ipc::details::type_bool, manager_client_type&>>> bool_receivers_;
+  std::shared_ptr<ipc::slot<ipc::details::type_uint, manager_client_type&>> packed_receiver_;
 };
 
 template <typename manager_client_type>
@@ -6,6 +6,7 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <span>
 #include <string_view>
 #include <system_error>
@@ -13,22 +14,39 @@
 
 #include <fmt/format.h>
 #include <boost/asio.hpp>
+#include <tfc/confman.hpp>
 #include <tfc/ec/devices/base.hpp>
+#include <tfc/ec/devices/beckhoff/digital_io.hpp>
 #include <tfc/ipc.hpp>
 
 namespace tfc::ec::devices::beckhoff {
 
 namespace asio = boost::asio;
 
-template <typename manager_client_type, template <typename, typename> typename signal_t = ipc::signal>
-class eq2339 final : public base<eq2339<manager_client_type, signal_t>> {
+template <typename manager_client_type,
+          template <typename, typename> typename signal_t = ipc::signal,
+          template <typename, typename, typename> typename confman_t = confman::config>
+class eq2339 final : public base<eq2339<manager_client_type, signal_t, confman_t>> {
 public:
   static constexpr size_t size = 16;
   static constexpr std::string_view name{ "EQ2339" };
   static constexpr auto product_code = 0x9234452;
   static constexpr uint32_t vendor_id = 0x2;
 
-  eq2339(asio::io_context& ctx, manager_client_type& client, uint16_t slave_index) : base<eq2339>(slave_index) {
+  eq2339(asio::io_context& ctx, manager_client_type& client, uint16_t slave_index)
+      : base<eq2339>(slave_index),
+        packed_receiver_{ std::make_shared<tfc::ipc::slot<ipc::details::type_uint, manager_client_type&>>(
+            ctx,
+            client,
+            fmt::format("{}.slave{}.out", name, slave_index),
+            "Digital outputs, output n in bit n",
+            std::bind_front(&eq2339::set_outputs, this)) },
+        packed_transmitter_{ std::make_shared<signal_t<ipc::details::type_uint, manager_client_type&>>(
+            ctx,
+            client,
+            fmt::format("{}.slave{}.in", name, slave_index),
+            "Digital inputs, input n in bit n") },
+        config_{ shared_config<eq2339, config_t>(client.connection(), name) } {
     for (size_t i = 0; i < size; i++) {
       receivers_.emplace_back(std::make_shared<tfc::ipc::slot<ipc::details::type_bool, manager_client_type&>>(
           ctx, client, fmt::format("{}.slave{}.out{}", name, slave_index, i), "Digital output",
@@ -40,19 +58,28 @@ public:
   }
 
   void pdo_cycle(std::span<std::uint8_t> input, std::span<std::uint8_t> output) noexcept {
-    for (size_t byte = 0; byte <= 1; byte++) {
-      for (size_t bits = 0; bits < 8 && size - ((byte * 8) + bits) > 0; bits++) {
-        auto const value = static_cast<bool>(input[byte] & (1 << bits));
-        const size_t bit_index = byte * 8 + bits;
-        if (value != last_values_[bit_index]) {
-          transmitters_[bit_index]->async_send(value, [this](std::error_code error, size_t) {
-            if (error) {
-              this->logger_.error("Ethercat {}, error transmitting : {}", name, error.message());
-            }
-          });
-        }
-        last_values_[bit_index] = value;
+    auto const word{ pack<size>(input) };
+    // Inputs are compared against all off on the first cycle, so only the set inputs are sent on their own signals.
+    // The packed word is always sent on the first cycle.
+    auto const changed{ word ^ last_word_.value_or(0) };
+    auto const first_cycle{ !last_word_.has_value() };
+    last_word_ = word;
+    auto const channel_signals{ config_->value().channel_signals };
+    // Every input is sent on the channel signals when they are turned back on, they are stale after being off
+    auto const channels_changed{ channel_signals && !channel_signals_on_ ? channel_mask<size> : changed };
+    channel_signals_on_ = channel_signals;
+    auto const on_error{ [this](std::error_code error, size_t) {
+      if (error) {
+        this->logger_.error("Ethercat {}, error transmitting : {}", name, error.message());
       }
+    } };
+    if (changed != 0 || first_cycle) {
+      packed_transmitter_->async_send(word, on_error);
+    }
+    if (channel_signals) {
+      for_each_changed(channels_changed, word, [this, &on_error](size_t channel, bool value) {
+        transmitters_[channel]->async_send(value, on_error);
+      });
     }
 
     output[0] = static_cast<std::uint8_t>(output_states_.to_ulong() & 0xff);
@@ -60,13 +87,26 @@ public:
   }
 
   auto set_output(size_t position, bool value) -> void { output_states_.set(position, value); }
+  /// Set every output at once, output n from bit n
+  auto set_outputs(std::uint64_t value) -> void { output_states_ = std::bitset<size>{ value & channel_mask<size> }; }
 
   auto transmitters() const noexcept -> auto const& { return transmitters_; }
+  /// Signal carrying all inputs of the terminal in one word, input n in bit n
+  auto packed_transmitter() const noexcept -> auto const& { return packed_transmitter_; }
+  /// Configuration shared by every terminal of this type
+  auto config() const noexcept -> auto const& { return config_; }
 
 private:
   std::bitset<size> output_states_;
-  std::array<bool, size> last_values_{};
+  std::optional<std::uint64_t> last_word_{};
+  // channel signals are not updated while they are off
+  bool channel_signals_on_{ true };
   std::vector<std::shared_ptr<ipc::slot<ipc::details::type_bool, manager_client_type&>>> receivers_;
   std::vector<std::shared_ptr<signal_t<ipc::details::type_bool, manager_client_type&>>> transmitters_;
+  std::shared_ptr<ipc::slot<ipc::details::type_uint, manager_client_type&>> packed_receiver_;
+  std::shared_ptr<signal_t<ipc::details::type_uint, manager_client_type&>> packed_transmitter_;
+  using config_t =
+      confman_t<digital_io_config, confman::file_storage<digital_io_config>, confman::detail::config_dbus_client>;
+  std::shared_ptr<config_t> config_;
 };
 }  // namespace tfc::ec::devices::beckhoff
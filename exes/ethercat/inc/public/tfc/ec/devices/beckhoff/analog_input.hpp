@@ -0,0 +1,125 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include <glaze/core/common.hpp>
+#include <mp-units/systems/si.h>
+
+#include <tfc/ipc/details/type_description.hpp>
+#include <tfc/utils/units_glaze_meta.hpp>
+
+namespace tfc::ec::devices::beckhoff {
+
+using current_t = ipc::details::current_t;
+using temperature_t = ipc::details::temperature_t;
+
+/// Configuration shared by the 4-20 mA analog input terminals
+struct analog_input_config {
+  using micro_ampere_t = mp_units::quantity<mp_units::si::micro<mp_units::si::ampere>, std::int64_t>;
+  using celsius_t = mp_units::quantity<mp_units::si::degree_Celsius, double>;
+  micro_ampere_t deadband{ 10 * micro_ampere_t::reference };
+  celsius_t temperature_at_4mA{ -20.0 * celsius_t::reference };
+  celsius_t temperature_at_20mA{ 100.0 * celsius_t::reference };
+  struct glaze {
+    // clang-format off
+    static constexpr auto value{ glz::object("deadband", &analog_input_config::deadband, "Changes in current up to this are not published",
+                                             "temperature_at_4mA", &analog_input_config::temperature_at_4mA, "Temperature of the sensor at 4 mA",
+                                             "temperature_at_20mA", &analog_input_config::temperature_at_20mA, "Temperature of the sensor at 20 mA"
+                                             ) };
+    // clang-format on
+    static constexpr std::string_view name{ "analog_input_config" };
+  };
+};
+
+/// Compact process data of one channel with siemens bits enabled.
+/// The three least significant bits are status, out of range in bit 0, followed by 12 data bits and the sign bit.
+namespace compact {
+inline constexpr std::uint16_t out_of_range_bit{ 0x1 };
+inline constexpr std::uint16_t sign_bit{ 0x8000 };
+inline constexpr unsigned value_shift{ 3 };
+/// The value counts up to 2^full_scale_bits at 20 mA
+inline constexpr std::int64_t full_scale_bits{ 12 };
+inline constexpr std::int64_t min_nano_ampere{ 4'000'000 };
+inline constexpr std::int64_t span_nano_ampere{ 16'000'000 };
+}  // namespace compact
+
+/// Scale the compact value of every channel to nano amperes without regard to its status.
+/// Branch free integer arithmetic, so the loop vectorises over the channels.
+template <std::size_t channels>
+constexpr auto scale_currents(std::span<std::uint16_t const, channels> raw) noexcept -> std::array<std::int64_t, channels> {
+  std::array<std::int64_t, channels> nano_ampere{};
+  for (std::size_t idx = 0; idx < channels; idx++) {
+    auto const counts{ static_cast<std::int64_t>(raw[idx] >> compact::value_shift) };
+    nano_ampere[idx] = compact::min_nano_ampere + ((counts * compact::span_nano_ampere) >> compact::full_scale_bits);
+  }
+  return nano_ampere;
+}
+
+/// \return the current of a channel from its compact value and scaled nano amperes, or why it is out of range
+constexpr auto to_current(std::uint16_t raw, std::int64_t nano_ampere) noexcept -> current_t {
+  using ipc::details::current_error_e;
+  if ((raw & compact::sign_bit) != 0) {
+    return std::unexpected{ current_error_e::under_range };
+  }
+  if ((raw & compact::out_of_range_bit) != 0) {
+    // The terminal saturates its value at the end of the range which was exceeded
+    return std::unexpected{ nano_ampere < compact::min_nano_ampere + compact::span_nano_ampere / 2
+                                ? current_error_e::under_range
+                                : current_error_e::over_range };
+  }
+  return nano_ampere * current_t::value_type::reference;
+}
+
+/// \return the temperature of a sensor linear in current from 4 to 20 mA
+constexpr auto to_temperature(current_t const& current, analog_input_config const& config) noexcept -> temperature_t {
+  using ipc::details::current_error_e;
+  using ipc::details::sensor_error_e;
+  if (!current.has_value()) {
+    switch (current.error()) {
+      case current_error_e::under_range:
+        return std::unexpected{ sensor_error_e::under_range };
+      case current_error_e::over_range:
+        return std::unexpected{ sensor_error_e::over_range };
+      default:
+        return std::unexpected{ sensor_error_e::unknown_error };
+    }
+  }
+  auto const low{ config.temperature_at_4mA.numerical_value_in(mp_units::si::degree_Celsius) };
+  auto const high{ config.temperature_at_20mA.numerical_value_in(mp_units::si::degree_Celsius) };
+  auto const fraction{ static_cast<double>(current.value().numerical_value_in(current_t::value_type::unit) -
+                                           compact::min_nano_ampere) /
+                       static_cast<double>(compact::span_nano_ampere) };
+  auto const micro_celsius{ (low + (fraction * (high - low))) * 1'000'000.0 };
+  return static_cast<std::int64_t>(micro_celsius < 0 ? micro_celsius - 0.5 : micro_celsius + 0.5) *
+         temperature_t::value_type::reference;
+}
+
+/// \return whether next should be published given the last published value,
+/// values are published when they move further than the deadband and errors whenever they change
+template <typename value_t>
+constexpr auto exceeds_deadband(std::optional<value_t> const& last,
+                                value_t const& next,
+                                auto const& deadband) noexcept -> bool {
+  if (!last.has_value() || last->has_value() != next.has_value()) {
+    return true;
+  }
+  if (!next.has_value()) {
+    return last->error() != next.error();
+  }
+  auto const delta{ next.value() - last->value() };
+  return delta > deadband || -delta > deadband;
+}
+
+namespace detail {
+inline constexpr std::array<std::uint16_t, 2> raw_example{ 0, 2048 << compact::value_shift };
+}  // namespace detail
+static_assert(scale_currents<2>(detail::raw_example)[0] == 4'000'000);
+static_assert(scale_currents<2>(detail::raw_example)[1] == 12'000'000);
+
+}  // namespace tfc::ec::devices::beckhoff
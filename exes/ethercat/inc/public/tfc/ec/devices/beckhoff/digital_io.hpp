@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <utility>
+
+#include <glaze/core/common.hpp>
+
+#include <tfc/utils/pragmas.hpp>
+
+namespace tfc::ec::devices::beckhoff {
+
+/// Configuration shared by every digital input terminal of a device type
+struct digital_io_config {
+  bool channel_signals{ true };
+  struct glaze {
+    // clang-format off
+    static constexpr auto value{ glz::object("channel_signals", &digital_io_config::channel_signals,
+                                             "Publish each input on its own signal in addition to the packed signal of the whole terminal") };
+    // clang-format on
+    static constexpr std::string_view name{ "digital_io_config" };
+  };
+};
+
+/// \return the configuration of the device type device_t, created by its first terminal and kept while any exists
+template <typename device_t, typename config_t>
+auto shared_config(auto&& connection, std::string_view key) -> std::shared_ptr<config_t> {
+  // clang-format off
+  PRAGMA_CLANG_WARNING_PUSH_OFF(-Wexit-time-destructors)
+  // clang-format on
+  static std::weak_ptr<config_t> current{};
+  PRAGMA_CLANG_WARNING_POP
+  if (auto existing{ current.lock() }) {
+    return existing;
+  }
+  auto created{ std::make_shared<config_t>(std::forward<decltype(connection)>(connection), key) };
+  current = created;
+  return created;
+}
+
+/// Word with a bit set for every channel of a terminal
+template <std::size_t channels>
+  requires(channels <= 64)
+inline constexpr std::uint64_t channel_mask{ channels == 64 ? ~std::uint64_t{ 0 } : (std::uint64_t{ 1 } << channels) - 1 };
+
+/// \return the process data of a digital terminal as a single word, channel n in bit n
+template <std::size_t channels>
+constexpr auto pack(std::span<std::uint8_t const> bytes) noexcept -> std::uint64_t {
+  std::uint64_t word{};
+  for (std::size_t idx = 0; idx < bytes.size() && idx < sizeof(word); idx++) {
+    word |= std::uint64_t{ bytes[idx] } << (idx * 8);
+  }
+  return word & channel_mask<channels>;
+}
+
+/// Invoke callback with the channel and its value for each channel set in changed, lowest channel first
+constexpr void for_each_changed(std::uint64_t changed, std::uint64_t word, auto&& callback) {
+  while (changed != 0) {
+    auto const channel{ static_cast<std::size_t>(std::countr_zero(changed)) };
+    callback(channel, ((word >> channel) & 1U) != 0);
+    changed &= changed - 1;
+  }
+}
+
+static_assert(pack<2>(std::array<std::uint8_t, 1>{ 0b111 }) == 0b11);
+static_assert(pack<16>(std::array<std::uint8_t, 2>{ 0x01, 0x80 }) == 0x8001);
+
+}  // namespace tfc::ec::devices::beckhoff
@@ -1,6 +1,13 @@
 #pragma once
 
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
 #include <utility>
 #include <variant>
 
@@ -35,7 +42,7 @@ using devices_list = devices_type<
   beckhoff::el2008<manager_client_t>,
   beckhoff::el2809<manager_client_t>,
   beckhoff::eq2339<manager_client_t>,
-  beckhoff::el3054,
+  beckhoff::el3054<manager_client_t>,
   beckhoff::el4002,
   schneider::atv320::device<manager_client_t>,
   schneider::lxm32m<manager_client_t>,
@@ -58,7 +65,7 @@ using device_variant = std::variant<abt::easyecat<manager_client_t>,
                                     beckhoff::el2008<manager_client_t>,
                                     beckhoff::el2809<manager_client_t>,
                                     beckhoff::eq2339<manager_client_t>,
-                                    beckhoff::el3054,
+                                    beckhoff::el3054<manager_client_t>,
                                     beckhoff::el4002,
                                     schneider::atv320::device<manager_client_t>,
                                     schneider::lxm32m<manager_client_t>,
@@ -88,68 +95,158 @@ struct device {
   auto setup() -> int {
     return std::visit([](auto& impl) { return impl.setup(); }, *device_);
   }
+
+  using process_data_t = void (*)(void*, std::span<std::uint8_t>, std::span<std::uint8_t>);
+
+  /// \return process_data of the held device as a plain function and the device to call it with,
+  /// valid for the lifetime of this device, also when it is moved.
+  [[nodiscard]] auto resolve_process_data() -> std::pair<process_data_t, void*> {
+    return std::visit(
+        [](auto& impl) -> std::pair<process_data_t, void*> {
+          using impl_t = std::remove_cvref_t<decltype(impl)>;
+          return { [](void* self, std::span<std::uint8_t> input, std::span<std::uint8_t> output) {
+                    static_cast<impl_t*>(self)->process_data(input, output);
+                  },
+                   &impl };
+        },
+        *device_);
+  }
   // unique_ptr to make this struct movable with non movable items
   std::unique_ptr<device_variant<manager_client_t>> device_{};
 };
 
-template <typename device>
-auto devices_equal(auto vendor_id, auto product_code) {
-  return vendor_id == device::vendor_id && product_code == device::product_code;
-}
+/// A slave with its process_data resolved and its process data located, so the cycle neither visits nor chases pointers
+struct dispatch_entry {
+  void (*process_data)(void*, std::span<std::uint8_t>, std::span<std::uint8_t>){ nullptr };
+  void* device{ nullptr };
+  std::uint16_t slave_index{};
+  std::uint32_t input_offset{};
+  std::uint32_t input_size{};
+  std::uint32_t output_offset{};
+  std::uint32_t output_size{};
+};
 
-template <typename manager_client_type, typename device_t>
-auto get_impl(std::shared_ptr<sdbusplus::asio::connection>& connection,
-              manager_client_type& client,
-              uint16_t const slave_index,
-              auto vendor_id,
-              auto product_code,
-              std::optional<device<manager_client_type>>& output) -> bool {
-  if (devices_equal<device_t>(vendor_id, product_code)) {
-    if constexpr (std::is_constructible_v<device_t, std::shared_ptr<sdbusplus::asio::connection>, manager_client_type&,
-                                          uint16_t>) {
-      output =
-          std::make_optional<device<manager_client_type>>(std::in_place_type<device_t>, connection, client, slave_index);
-    } else if constexpr (std::is_constructible_v<device_t, boost::asio::io_context&, manager_client_type&, uint16_t>) {
-      output = std::make_optional<device<manager_client_type>>(std::in_place_type<device_t>, connection->get_io_context(),
-                                                               client, slave_index);
-    } else if constexpr (std::is_constructible_v<device_t, boost::asio::io_context&, uint16_t>) {
-      output = std::make_optional<device<manager_client_type>>(std::in_place_type<device_t>, connection->get_io_context(),
-                                                               slave_index);
-    } else if constexpr (std::is_constructible_v<device_t, uint16_t>) {
-      output = std::make_optional<device<manager_client_type>>(std::in_place_type<device_t>, slave_index);
+/**
+ * Let every slave of a dispatch table process its part of a process image.
+ * @param image either the io map itself or a copy of it, slaves are located by their offset into the io map
+ * @param is_lost invoked with a slave index, lost slaves are given empty process data
+ */
+void dispatch(std::span<dispatch_entry const> table, std::span<std::uint8_t> image, auto&& is_lost) {
+  for (auto const& entry : table) {
+    if (is_lost(entry.slave_index)) {
+      entry.process_data(entry.device, {}, {});
     } else {
-      // clang-format off
-      []<bool flag = false>() { static_assert(flag, "No matching constructor"); } ();
-      // clang-format on
+      entry.process_data(entry.device, image.subspan(entry.input_offset, entry.input_size),
+                         image.subspan(entry.output_offset, entry.output_size));
     }
-    return true;
   }
-  return false;
 }
 
-template <typename manager_client_type, typename... devices_t>
-auto get_impl(std::shared_ptr<sdbusplus::asio::connection>& connection,
-              manager_client_type& client,
-              uint16_t const slave_index,
-              auto vendor_id,
-              auto product_code,
-              devices_type<devices_t...>) -> device<manager_client_type> {
-  std::optional<device<manager_client_type>> result{};
-  (get_impl<manager_client_type, devices_t>(connection, client, slave_index, vendor_id, product_code, result) || ...);
-  if (result) {
-    return std::move(result.value());
+/// Construct a device from whichever of the supported constructors device_t has
+template <typename manager_client_type, typename device_t>
+auto make(std::shared_ptr<sdbusplus::asio::connection>& connection, manager_client_type& client, uint16_t const slave_index)
+    -> device<manager_client_type> {
+  if constexpr (std::is_constructible_v<device_t, std::shared_ptr<sdbusplus::asio::connection>, manager_client_type&,
+                                        uint16_t>) {
+    return device<manager_client_type>(std::in_place_type<device_t>, connection, client, slave_index);
+  } else if constexpr (std::is_constructible_v<device_t, boost::asio::io_context&, manager_client_type&, uint16_t>) {
+    return device<manager_client_type>(std::in_place_type<device_t>, connection->get_io_context(), client, slave_index);
+  } else if constexpr (std::is_constructible_v<device_t, boost::asio::io_context&, uint16_t>) {
+    return device<manager_client_type>(std::in_place_type<device_t>, connection->get_io_context(), slave_index);
+  } else if constexpr (std::is_constructible_v<device_t, uint16_t>) {
+    return device<manager_client_type>(std::in_place_type<device_t>, slave_index);
+  } else {
+    // clang-format off
+    []<bool flag = false>() { static_assert(flag, "No matching constructor"); } ();
+    // clang-format on
   }
-  tfc::logger::logger log("missing_implementation");
-  log.warn("No device found for slave: {}, vendor: {}, product_code: {} \n", slave_index, vendor_id, product_code);
-  return device<manager_client_type>(std::in_place_type<default_device>, slave_index);
 }
 
+template <typename>
+struct devices_count;
+
+template <typename... devices_t>
+struct devices_count<devices_type<devices_t...>> : std::integral_constant<std::size_t, sizeof...(devices_t)> {};
+
+/**
+ * Compile time hash table from vendor id and product code to the factory of the matching device in devices_list.
+ * Open addressing with linear probing, kept at most half full.
+ */
+template <typename manager_client_type>
+class registry {
+public:
+  using factory_t = device<manager_client_type> (*)(std::shared_ptr<sdbusplus::asio::connection>&,
+                                                    manager_client_type&,
+                                                    uint16_t);
+
+  /// \return the factory of the device with the given identity, nullptr if there is none
+  [[nodiscard]] static constexpr auto find(std::uint32_t vendor_id, std::uint32_t product_code) noexcept -> factory_t {
+    for (std::size_t idx = hash(vendor_id, product_code) & mask;; idx = (idx + 1) & mask) {
+      auto const& candidate{ table[idx] };
+      if (candidate.factory == nullptr) {
+        return nullptr;
+      }
+      if (candidate.vendor_id == vendor_id && candidate.product_code == product_code) {
+        return candidate.factory;
+      }
+    }
+  }
+
+private:
+  struct entry {
+    std::uint32_t vendor_id{};
+    std::uint32_t product_code{};
+    factory_t factory{ nullptr };
+  };
+
+  static constexpr auto hash(std::uint32_t vendor_id, std::uint32_t product_code) noexcept -> std::size_t {
+    // Finalizer of murmur3, spreads the few differing bits of similar product codes over the whole index
+    std::uint64_t key{ (std::uint64_t{ vendor_id } << 32U) | product_code };
+    key ^= key >> 33U;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33U;
+    return static_cast<std::size_t>(key);
+  }
+
+  static constexpr std::size_t capacity{ std::bit_ceil(devices_count<devices_list<manager_client_type>>::value * 2) };
+  static constexpr std::size_t mask{ capacity - 1 };
+
+  template <typename... devices_t>
+  static consteval auto build(devices_type<devices_t...>) -> std::array<entry, capacity> {
+    std::array<entry, capacity> result{};
+    auto const insert{ [&result](entry const& item) {
+      std::size_t idx{ hash(item.vendor_id, item.product_code) & mask };
+      while (result[idx].factory != nullptr) {
+        if (result[idx].vendor_id == item.vendor_id && result[idx].product_code == item.product_code) {
+          throw std::logic_error{ "Two devices in devices_list have the same vendor id and product code" };
+        }
+        idx = (idx + 1) & mask;
+      }
+      result[idx] = item;
+    } };
+    (insert(entry{ .vendor_id = static_cast<std::uint32_t>(devices_t::vendor_id),
+                   .product_code = static_cast<std::uint32_t>(devices_t::product_code),
+                   .factory = &make<manager_client_type, devices_t> }),
+     ...);
+    return result;
+  }
+
+  static constexpr std::array<entry, capacity> table{ build(devices_list<manager_client_type>{}) };
+};
+
 template <typename manager_client_type>
 auto get(std::shared_ptr<sdbusplus::asio::connection>& connection,
          manager_client_type& client,
          uint16_t const slave_index,
          auto vendor_id,
          auto product_code) -> device<manager_client_type> {
-  return get_impl(connection, client, slave_index, vendor_id, product_code, devices_list<manager_client_type>{});
+  auto const factory{ registry<manager_client_type>::find(static_cast<std::uint32_t>(vendor_id),
+                                                          static_cast<std::uint32_t>(product_code)) };
+  if (factory != nullptr) {
+    return factory(connection, client, slave_index);
+  }
+  tfc::logger::logger log("missing_implementation");
+  log.warn("No device found for slave: {}, vendor: {}, product_code: {} \n", slave_index, vendor_id, product_code);
+  return device<manager_client_type>(std::in_place_type<default_device>, slave_index);
 }
 }  // namespace tfc::ec::devices
@@ -3,10 +3,12 @@
 #include <mp-units/math.h>
 
 #include <array>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <new>
+#include <optional>
 #include <span>
 #include <variant>
 
@@ -18,6 +20,7 @@
 #include <tfc/utils/units_glaze_meta.hpp>
 
 #include "tfc/ec/devices/base.hpp"
+#include "tfc/ec/devices/eilersen/weighing.hpp"
 
 namespace tfc::ec::devices::eilersen::e4x60a {
 enum struct cell_mode_e : std::uint8_t {
@@ -46,7 +49,7 @@ namespace tfc::ec::devices::eilersen::e4x60a {
 namespace asio = boost::asio;
 static constexpr std::size_t max_cells{ 4 };
 using signal_t = std::int32_t;
-using mass_t = mp_units::quantity<mp_units::si::milli<mp_units::si::gram>, std::int64_t>;
+using mass_t = weighing::mass_t;
 
 struct calibration_zero_t {
   std::int64_t read{};  // read_only
@@ -164,6 +167,7 @@ using variations_t = std::array<calibration_config_t, max_cells>;
 struct config {
   variations_t variations{ calibration_config{}, calibration_config{}, calibration_config{}, calibration_config{} };
   // any related config parameters that apply to the whole device can be added here
+  weighing::config weighing{};
 };
 }  // namespace tfc::ec::devices::eilersen::e4x60a
 
@@ -249,8 +253,11 @@ template <>
 struct meta<e4x60a::config> {
   using type = e4x60a::config;
   static constexpr std::string_view name{ "e4x60a::config" };
-  static constexpr auto value{ glz::object("variations", &type::variations  // todo json schema set as hidden
-                                           ) };
+  static constexpr auto value{ glz::object("variations",
+                                           &type::variations,  // todo json schema set as hidden
+                                           "weighing",
+                                           &type::weighing,
+                                           "Filtering and motion detection of the weight") };
 };
 }  // namespace glz
 
@@ -370,6 +377,8 @@ PRAGMA_GCC_WARNING_POP
   }
 
   void pdo_cycle(pdo_input const& input, [[maybe_unused]] pdo_output& out) {
+    filter_.configure(config_->weighing.filter);
+    stability_.configure(config_->weighing.stability.band, config_->weighing.stability.settle_time);
     // todo support multiple variations
     auto& group_1{ config_->variations.at(0) };
     auto value{ std::visit(
@@ -380,6 +389,7 @@ PRAGMA_GCC_WARNING_POP
           for (auto using_cell : group_1_cal.get_cells()) {
             if (using_cell) {
               if (input.status.broken(idx)) {
+                filter_.reset();
                 return std::unexpected{ ipc::details::mass_error_e::cell_fault };
               }
               // clang-format off
@@ -390,6 +400,8 @@ PRAGMA_CLANG_WARNING_POP
             }
             idx++;
           }
+          // calibration reads the filtered signal as well
+          last_cumilated_signal_ = filter_.push(last_cumilated_signal_);
           auto calculated_signal{ last_cumilated_signal_ };
           auto zero{ group_1_cal.get_zero() };
           if (zero) {
@@ -419,12 +431,33 @@ PRAGMA_CLANG_WARNING_POP
           return result;
         },
         group_1) };
+    if (!value) {
+      stability_.reset();
+    }
+    auto const on_error{ [this](std::error_code const& err, auto) {
+      if (err) {
+        this->logger_.warn("Unable to send mass signal: {}", err.message());
+      }
+    } };
     if (value != mass_.value()) {
-      mass_.async_send(value, [this](std::error_code const& err, auto) {
-        if (err) {
-          this->logger_.warn("Unable to send mass signal: {}", err.message());
-        }
-      });
+      mass_.async_send(value, on_error);
+    }
+    bool const stable{ value.has_value() && filter_.converged() &&
+                       stability_.push(value.value(), std::chrono::steady_clock::now()) };
+    if (stable != stable_.value()) {
+      stable_.async_send(stable, on_error);
+    }
+    // the settled weight is published once each time the weight comes to rest and errors once each time they change
+    if (!value) {
+      if (settled_ != value) {
+        settled_ = value;
+        settled_mass_.async_send(value, on_error);
+      }
+    } else if (!stable) {
+      settled_.reset();
+    } else if (!settled_.has_value() || !settled_->has_value()) {
+      settled_ = value;
+      settled_mass_.async_send(value, on_error);
     }
   }
 
@@ -439,5 +472,15 @@ PRAGMA_CLANG_WARNING_POP
   ipc_signal_t<ipc::details::type_mass, ipc_ruler::ipc_manager_client&> mass_{
     ctx_, client_, fmt::format("eilersen_4x60a.s{}.group_1", this->slave_index_), "Weigher output for group 1"
   };
+  weighing::signal_filter filter_{};
+  weighing::stability_detector<mass_t> stability_{};
+  std::optional<ipc::details::mass_t> settled_{};
+  ipc_signal_t<ipc::details::type_mass, ipc_ruler::ipc_manager_client&> settled_mass_{
+    ctx_, client_, fmt::format("eilersen_4x60a.s{}.group_1.settled", this->slave_index_),
+    "Weight of group 1 each time it comes to rest"
+  };
+  ipc_signal_t<ipc::details::type_bool, ipc_ruler::ipc_manager_client&> stable_{
+    ctx_, client_, fmt::format("eilersen_4x60a.s{}.group_1.stable", this->slave_index_), "Weight of group 1 is at rest"
+  };
 };
 }  // namespace tfc::ec::devices::eilersen::e4x60a
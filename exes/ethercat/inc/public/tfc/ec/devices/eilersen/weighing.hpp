@@ -0,0 +1,210 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include <glaze/core/common.hpp>
+#include <mp-units/systems/si.h>
+
+#include <tfc/stx/glaze_meta.hpp>
+#include <tfc/utils/units_glaze_meta.hpp>
+
+namespace tfc::ec::devices::eilersen::weighing {
+enum struct filter_e : std::uint8_t {
+  none = 0,
+  median,
+  ema,
+  fir,
+};
+}  // namespace tfc::ec::devices::eilersen::weighing
+
+template <>
+struct glz::meta<tfc::ec::devices::eilersen::weighing::filter_e> {
+  static constexpr std::string_view name{ "weighing::filter" };
+  using enum tfc::ec::devices::eilersen::weighing::filter_e;
+  // clang-format off
+  static constexpr auto value{ glz::enumerate(
+    "None", none,
+    "Median", median,
+    "Exponential moving average", ema,
+    "Moving average", fir
+  ) };
+  // clang-format on
+};
+
+/// Filtering and stability detection of load cell signals, run in the process data cycle
+namespace tfc::ec::devices::eilersen::weighing {
+
+using mass_t = mp_units::quantity<mp_units::si::milli<mp_units::si::gram>, std::int64_t>;
+
+static constexpr std::size_t max_window{ 32 };
+
+struct filter_config {
+  filter_e type{ filter_e::none };
+  std::size_t window{ 8 };
+  std::uint8_t ema_shift{ 4 };
+  constexpr auto operator==(filter_config const&) const noexcept -> bool = default;
+  struct glaze {
+    // clang-format off
+    static constexpr auto value{ glz::object("type", &filter_config::type, "Filter applied to the summed signal of the cells every cycle",
+                                             "window", &filter_config::window, "Samples in the median and moving average, at most 32",
+                                             "ema_shift", &filter_config::ema_shift, "The exponential moving average moves 1/2^ema_shift of the way to each sample"
+                                             ) };
+    // clang-format on
+    static constexpr std::string_view name{ "weighing::filter_config" };
+  };
+};
+
+struct stability_config {
+  mass_t band{ 20 * mass_t::reference };
+  std::chrono::milliseconds settle_time{ 300 };
+  struct glaze {
+    // clang-format off
+    static constexpr auto value{ glz::object("band", &stability_config::band, "The weight is in motion when it moves further than this",
+                                             "settle_time", &stability_config::settle_time, "Time the weight must stay within the band to be settled"
+                                             ) };
+    // clang-format on
+    static constexpr std::string_view name{ "weighing::stability_config" };
+  };
+};
+
+struct config {
+  filter_config filter{};
+  stability_config stability{};
+  struct glaze {
+    // clang-format off
+    static constexpr auto value{ glz::object("filter", &config::filter, "Filtering of the cell signals",
+                                             "stability", &config::stability, "Motion detection, a settled weight is published once it is stable"
+                                             ) };
+    // clang-format on
+    static constexpr std::string_view name{ "weighing::config" };
+  };
+};
+
+/**
+ * Filter of the summed cell signal in integer arithmetic.
+ * The exponential moving average keeps 16 fractional bits so steps smaller than 2^ema_shift are not lost to rounding.
+ */
+class signal_filter {
+public:
+  static constexpr std::uint8_t fraction_bits{ 16 };
+
+  constexpr signal_filter() noexcept { apply(filter_config{}); }
+
+  /// Use the given configuration, the filter starts over when it differs from the current one
+  constexpr void configure(filter_config const& config) noexcept {
+    if (config != config_) {
+      apply(config);
+    }
+  }
+
+  constexpr void reset() noexcept {
+    count_ = 0;
+    next_ = 0;
+    sum_ = 0;
+    ema_ = 0;
+    samples_.fill(0);
+  }
+
+  /// Add a sample
+  /// \return the filtered signal
+  constexpr auto push(std::int64_t sample) noexcept -> std::int64_t {
+    count_ = std::min(count_ + 1, max_count());
+    switch (config_.type) {
+      case filter_e::ema:
+        if (count_ == 1) {
+          ema_ = sample * (std::int64_t{ 1 } << fraction_bits);
+        } else {
+          ema_ += (sample * (std::int64_t{ 1 } << fraction_bits) - ema_) >> config_.ema_shift;
+        }
+        return (ema_ + (std::int64_t{ 1 } << (fraction_bits - 1))) >> fraction_bits;
+      case filter_e::median:
+      case filter_e::fir: {
+        sum_ += sample - samples_[next_];
+        samples_[next_] = sample;
+        next_ = (next_ + 1) % window_;
+        auto const filled{ std::min(count_, window_) };
+        if (config_.type == filter_e::fir) {
+          return sum_ / static_cast<std::int64_t>(filled);
+        }
+        std::array<std::int64_t, max_window> sorted{};
+        std::copy_n(samples_.begin(), filled, sorted.begin());
+        auto const middle{ std::next(sorted.begin(), static_cast<std::ptrdiff_t>(filled / 2)) };
+        std::nth_element(sorted.begin(), middle, std::next(sorted.begin(), static_cast<std::ptrdiff_t>(filled)));
+        return *middle;
+      }
+      case filter_e::none:
+      default:
+        return sample;
+    }
+  }
+
+  /// \return whether the filter has seen enough samples for its output to follow the signal
+  [[nodiscard]] constexpr auto converged() const noexcept -> bool { return count_ >= max_count(); }
+
+private:
+  constexpr void apply(filter_config const& config) noexcept {
+    config_ = config;
+    config_.ema_shift = std::min<std::uint8_t>(config_.ema_shift, fraction_bits);
+    window_ = std::clamp<std::size_t>(config_.window, 1, max_window);
+    reset();
+  }
+
+  /// Samples until converged, a window for the median and moving average and a time constant for the moving average
+  [[nodiscard]] constexpr auto max_count() const noexcept -> std::size_t {
+    switch (config_.type) {
+      case filter_e::median:
+      case filter_e::fir:
+        return window_;
+      case filter_e::ema:
+        return std::size_t{ 1 } << config_.ema_shift;
+      case filter_e::none:
+      default:
+        return 1;
+    }
+  }
+
+  filter_config config_{};
+  std::size_t window_{ 1 };
+  std::size_t count_{};
+  std::size_t next_{};
+  std::int64_t sum_{};
+  std::int64_t ema_{};
+  std::array<std::int64_t, max_window> samples_{};
+};
+
+/// Motion detection, a value is stable once it has stayed within the band of where it came to rest for the settle time
+template <typename value_t>
+class stability_detector {
+public:
+  using clock = std::chrono::steady_clock;
+
+  constexpr void configure(value_t band, clock::duration settle_time) noexcept {
+    band_ = band;
+    settle_time_ = settle_time;
+  }
+
+  constexpr void reset() noexcept { anchor_.reset(); }
+
+  /// \return whether the value is stable
+  constexpr auto push(value_t value, clock::time_point now) noexcept -> bool {
+    if (!anchor_.has_value() || value - *anchor_ > band_ || *anchor_ - value > band_) {
+      anchor_ = value;
+      since_ = now;
+    }
+    return now - since_ >= settle_time_;
+  }
+
+private:
+  value_t band_{};
+  clock::duration settle_time_{};
+  std::optional<value_t> anchor_{};
+  clock::time_point since_{};
+};
+
+}  // namespace tfc::ec::devices::eilersen::weighing
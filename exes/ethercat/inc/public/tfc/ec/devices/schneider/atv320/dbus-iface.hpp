@@ -5,7 +5,11 @@
 */
 #pragma once
 
+#include <memory>
+#include <optional>
+#include <random>
 #include <string>
+#include <utility>
 
 #include <mp-units/format.h>
 #include <mp-units/framework/quantity.h>
@@ -18,6 +22,7 @@
 #include <tfc/ec/devices/schneider/atv320/pdo.hpp>
 #include <tfc/motor/dbus_tags.hpp>
 #include <tfc/motor/enums.hpp>
+#include <tfc/motor/mailbox.hpp>
 #include <tfc/motor/positioner.hpp>
 #include <tfc/stx/concepts.hpp>
 #include <tfc/utils/asio_condition_variable.hpp>
@@ -26,6 +31,7 @@ namespace tfc::ec::devices::schneider::atv320 {
 namespace asio = boost::asio;
 namespace method = motor::dbus::method;
 namespace message = motor::dbus::message;
+namespace mailbox = motor::mailbox;
 using speedratio_t = motor::dbus::types::speedratio_t;
 using micrometre_t = motor::dbus::types::micrometre_t;
 using velocity_t = motor::dbus::types::velocity_t;
@@ -774,6 +780,21 @@ struct dbus_iface {
     object_server_ = std::make_unique<sdbusplus::asio::object_server>(connection, false);
     dbus_interface_ = object_server_->add_unique_interface(path_, interface_);
 
+    // The peer reads these once it has opened its mailbox, until then it is limited to D-Bus
+    using mailbox::channel_e;
+    if (auto responses{ mailbox::writer<mailbox::response>::create(
+            mailbox::region_name(impl_name, slave_id_, channel_e::responses)) }) {
+      responses_.emplace(std::move(responses.value()));
+    } else {
+      logger_.warn("Unable to create mailbox responses: {}", responses.error().message());
+    }
+    if (auto status{
+            mailbox::writer<mailbox::status>::create(mailbox::region_name(impl_name, slave_id_, channel_e::status)) }) {
+      status_.emplace(std::move(status.value()));
+    } else {
+      logger_.warn("Unable to create mailbox status: {}", status.error().message());
+    }
+
     /**
      * Never set long_living_ping from a program. This parameter is only here
      * for convinience while testing motor directions and fault finding during
@@ -803,6 +824,7 @@ struct dbus_iface {
                 }
               });
               peer_ = "";
+              close_mailbox();
               dbus_interface_->set_property(connected_peer, peer_);
             });
             return true;
@@ -967,6 +989,30 @@ struct dbus_iface {
                                        return { err, err != motor::errors::err_enum::success };
                                      });
 
+    dbus_interface_->register_method(
+        std::string{ method::open_mailbox }, [this](const sdbusplus::message_t& msg) -> message::open_mailbox {
+          using enum motor::errors::err_enum;
+          if (!validate_peer(msg.get_sender())) {
+            return { permission_denied };
+          }
+          if (!responses_.has_value() || !status_.has_value()) {
+            return { motor_method_not_implemented };
+          }
+          auto commands{ mailbox::reader<mailbox::command>::open(
+              ctx_.get_executor(), mailbox::region_name(impl_name, slave_id_, mailbox::channel_e::commands)) };
+          if (!commands) {
+            logger_.warn("Unable to open mailbox of peer: {}, {}", peer_, commands.error().message());
+            return { unknown };
+          }
+          commands_ = std::move(commands.value());
+          lost_commands_ = 0;
+          mailbox_peer_ = peer_;
+          // never 0, which the status carries while no mailbox is open
+          session_ = std::uniform_int_distribution<std::uint64_t>{ 1 }(session_source_);
+          receive_commands();
+          return { success, session_ };
+        });
+
     dbus_interface_->register_property<std::string>(connected_peer, peer_);
     dbus_interface_->register_property<std::string>(state_402, "");
     dbus_interface_->register_property<std::string>(hmis, "");
@@ -1001,6 +1047,106 @@ struct dbus_iface {
       dbus_interface_->set_property(current, static_cast<double>(in.current) / 10.0);
     }
     last_in_ = in;
+    if (status_.has_value()) {
+      status_->post({ .position_from_home = ctrl_.positioner()
+                                                .position_from_home()
+                                                .force_in(micrometre_t::reference)
+                                                .numerical_value_in(micrometre_t::unit),
+                      .frequency = in.frequency.numerical_value_in(decifrequency_signed::unit),
+                      .current = in.current,
+                      .state_402 = static_cast<std::uint8_t>(in.status_word.parse_state()),
+                      .drive_error = ctrl_.driver_error(),
+                      .session = session_,
+                      .commands_read = commands_ ? commands_->read_index() : 0 });
+    }
+  }
+
+  void receive_commands() {
+    commands_->async_wait([this, alive = commands_->alive()](std::error_code const&) {
+      // a command may replace the mailbox through its completion, check the reader is still alive after each of them
+      while (!alive.expired()) {
+        auto cmd{ commands_->next() };
+        if (!cmd) {
+          break;
+        }
+        dispatch(cmd.value());
+      }
+      if (alive.expired()) {
+        return;
+      }
+      if (commands_->lost() != lost_commands_) {
+        lost_commands_ = commands_->lost();
+        logger_.error("Mailbox commands lost, {} in total", lost_commands_);
+      }
+      if (commands_->detached()) {
+        logger_.info("Peer: {} closed its mailbox", peer_);
+        close_mailbox();
+        return;
+      }
+      receive_commands();
+    });
+  }
+
+  void close_mailbox() {
+    commands_.reset();
+    mailbox_peer_.clear();
+    session_ = 0;
+  }
+
+  /// Run a command from the mailbox, same as its D-Bus method, its response is posted when it completes
+  void dispatch(mailbox::command const& cmd) {
+    using mailbox::command_e;
+    auto respond{ [this, id = cmd.id](std::error_code const& err, micrometre_t length = 0L * micrometre_t::reference) {
+      if (responses_.has_value()) {
+        responses_->post(
+            { .id = id, .err = motor::motor_enum(err), .micrometre = length.numerical_value_in(micrometre_t::unit) });
+      }
+    } };
+    // the peer owning the drive may have changed since the mailbox was opened, its commands are checked like D-Bus calls
+    if (cmd.session != session_ || !validate_peer(mailbox_peer_)) {
+      logger_.warn("Mailbox command {} rejected, session: {}", cmd.id, cmd.session);
+      return respond(motor::motor_error(motor::errors::err_enum::permission_denied));
+    }
+    // the sender has already been told the command failed, running it now would surprise it
+    if (mailbox::stale(cmd.read_by)) {
+      logger_.warn("Mailbox command {} read after its deadline, not run", cmd.id);
+      return respond(std::make_error_code(std::errc::timed_out));
+    }
+    speedratio_t const speedratio{ cmd.speedratio * mp_units::percent };
+    micrometre_t const length{ cmd.micrometre * micrometre_t::reference };
+    microsecond_t const time{ cmd.microsecond * microsecond_t::reference };
+    auto const configured_speedratio{ cmd.direction == motor::direction_e::forward ? config_speedratio_
+                                                                                    : -config_speedratio_ };
+    switch (cmd.type) {
+      case command_e::run:
+        return ctrl_.run(configured_speedratio, respond);
+      case command_e::run_at_speedratio:
+        return ctrl_.run(speedratio, respond);
+      case command_e::run_microsecond:
+        return ctrl_.run(configured_speedratio, time, respond);
+      case command_e::run_at_speedratio_microsecond:
+        return ctrl_.run(speedratio, time, respond);
+      case command_e::stop:
+        return ctrl_.stop(respond);
+      case command_e::quick_stop:
+        return ctrl_.quick_stop(respond);
+      case command_e::reset:
+        return ctrl_.reset(respond);
+      case command_e::convey_micrometre:
+        return ctrl_.convey(config_speedratio_, length, respond);
+      case command_e::move_micrometre:
+        return ctrl_.move(config_speedratio_, length, respond);
+      case command_e::move_speedratio_micrometre:
+        return ctrl_.move(speedratio, length, respond);
+      case command_e::move_home:
+        return ctrl_.move_home(respond);
+      case command_e::notify_after_micrometre:
+        return ctrl_.notify_after(length, respond);
+      case command_e::notify_from_home_micrometre:
+        return ctrl_.notify_from_home(length, respond);
+    }
+    logger_.warn("Unknown mailbox command: {}", std::to_underlying(cmd.type));
+    respond(motor::motor_error(motor::errors::err_enum::motor_method_not_implemented));
   }
 
   asio::io_context& ctx_;
@@ -1017,6 +1163,15 @@ struct dbus_iface {
   logger::logger logger_;
   input_t last_in_{};
 
+  // Shared memory mailbox of the peer, see tfc/motor/mailbox.hpp
+  std::optional<mailbox::writer<mailbox::response>> responses_{};
+  std::optional<mailbox::writer<mailbox::status>> status_{};
+  std::unique_ptr<mailbox::reader<mailbox::command>> commands_{};
+  std::uint64_t lost_commands_{};
+  std::string mailbox_peer_{};
+  std::uint64_t session_{};
+  std::mt19937_64 session_source_{ std::random_device{}() };
+
   /**
    * \brief has_peer
    * \return true if the dbus interface is being used to control the drive.
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include <thread>
+
+#include <tfc/ec/config/bus.hpp>
+#include <tfc/logger.hpp>
+
+namespace tfc::ec::rt {
+
+/**
+ * Lock-free exchange of the latest value between a single producer and a single consumer.
+ * The producer fills write_buffer() and publishes it, the consumer fetches the most recently published buffer.
+ * Neither side ever waits for the other, intermediate values are overwritten if the consumer is slower than the producer.
+ */
+template <typename value_t>
+class triple_buffer {
+public:
+  /// \return the buffer owned by the producer, valid until the next publish()
+  [[nodiscard]] auto write_buffer() noexcept -> value_t& { return buffers_[write_index_]; }
+
+  /// Hand the write buffer over to the consumer and take ownership of a free one
+  void publish() noexcept {
+    auto const published{ static_cast<std::uint8_t>(write_index_ | fresh_bit) };
+    write_index_ = static_cast<std::uint8_t>(state_.exchange(published, std::memory_order_acq_rel) & index_mask);
+  }
+
+  /// Take ownership of the most recently published buffer
+  /// \return true if a buffer has been published since the last fetch
+  [[nodiscard]] auto fetch() noexcept -> bool {
+    if ((state_.load(std::memory_order_relaxed) & fresh_bit) == 0) {
+      return false;
+    }
+    read_index_ = static_cast<std::uint8_t>(state_.exchange(read_index_, std::memory_order_acq_rel) & index_mask);
+    return true;
+  }
+
+  /// \return the buffer owned by the consumer, valid until the next fetch()
+  [[nodiscard]] auto read_buffer() const noexcept -> value_t const& { return buffers_[read_index_]; }
+
+private:
+  static constexpr std::uint8_t index_mask{ 0b011 };
+  static constexpr std::uint8_t fresh_bit{ 0b100 };
+  static constexpr std::size_t cache_line{ 64 };
+
+  std::array<value_t, 3> buffers_{};
+  alignas(cache_line) std::uint8_t write_index_{ 0 };
+  alignas(cache_line) std::uint8_t read_index_{ 1 };
+  alignas(cache_line) std::atomic<std::uint8_t> state_{ 2 };
+};
+
+/**
+ * Set the scheduling policy and cpu affinity of the calling thread.
+ * @param priority SCHED_FIFO priority, the scheduling policy is left untouched if empty
+ * @param cpu the cpu to pin the thread to, the affinity is left untouched if empty
+ */
+auto set_thread_scheduling(std::optional<int> priority, std::optional<std::size_t> cpu) -> std::error_code;
+
+/// Lock all current and future pages of the process into memory so the cycle never page faults
+auto lock_memory() -> std::error_code;
+
+/**
+ * A dedicated thread invoking a callback at absolute deadlines.
+ * Deadlines are computed from the previous deadline and not the previous wakeup, so jitter does not accumulate as drift.
+ * If a cycle overruns past the following deadline the missed deadlines are skipped and counted as overruns.
+ */
+class cycle_thread {
+public:
+  cycle_thread(config::realtime const& config, std::chrono::nanoseconds period, std::function<void()> cycle);
+  cycle_thread(cycle_thread const&) = delete;
+  cycle_thread(cycle_thread&&) = delete;
+  auto operator=(cycle_thread const&) -> cycle_thread& = delete;
+  auto operator=(cycle_thread&&) -> cycle_thread& = delete;
+  ~cycle_thread();
+
+  /// Stop the thread and wait for the current cycle to complete
+  void stop();
+
+  /// \return the count of cycles which started after the following deadline had already passed
+  [[nodiscard]] auto overruns() const noexcept -> std::uint64_t { return overruns_.load(std::memory_order_relaxed); }
+
+  /// \return the count of completed cycles
+  [[nodiscard]] auto cycles() const noexcept -> std::uint64_t { return cycles_.load(std::memory_order_relaxed); }
+
+  static constexpr std::string_view name{ "cycle_thread" };
+
+private:
+  void run(std::stop_token const& token);
+
+  config::realtime config_;
+  std::chrono::nanoseconds period_;
+  std::function<void()> cycle_;
+  std::atomic<std::uint64_t> overruns_{ 0 };
+  std::atomic<std::uint64_t> cycles_{ 0 };
+  tfc::logger::logger logger_{ name };
+  std::jthread thread_;
+};
+
+}  // namespace tfc::ec::rt
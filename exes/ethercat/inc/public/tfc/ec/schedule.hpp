@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+
+namespace tfc::ec {
+
+/// Most process data groups on a bus, SOEM's group 0 which addresses every slave included
+inline constexpr std::size_t max_groups{ 8 };
+
+/**
+ * Schedule of process data groups running at different periods from a single timing source.
+ * The source ticks at the greatest common divisor of the periods and each group is due every period / tick ticks.
+ * Groups are offset by their index, so slow groups spread their exchanges over the ticks instead of piling up on one.
+ */
+class group_schedule {
+public:
+  /// Set of groups, bit n for the group at index n
+  using mask_t = std::uint32_t;
+  static_assert(max_groups <= sizeof(mask_t) * 8);
+
+  constexpr group_schedule() : group_schedule(std::array{ std::chrono::nanoseconds{ std::chrono::milliseconds{ 1 } } }) {}
+
+  /**
+   * @param periods the period of each group
+   * @throws std::invalid_argument if there are no groups, more than max_groups or a period is not positive
+   */
+  explicit constexpr group_schedule(std::span<std::chrono::nanoseconds const> periods) : size_{ periods.size() } {
+    if (periods.empty() || periods.size() > max_groups) {
+      throw std::invalid_argument{ "A group schedule needs at least one and at most max_groups groups" };
+    }
+    std::chrono::nanoseconds::rep tick{};
+    for (auto const period : periods) {
+      if (period.count() <= 0) {
+        throw std::invalid_argument{ "Group periods must be positive" };
+      }
+      tick = std::gcd(tick, period.count());
+    }
+    tick_ = std::chrono::nanoseconds{ tick };
+    for (std::size_t idx = 0; idx < size_; idx++) {
+      dividers_[idx] = static_cast<std::uint64_t>(periods[idx].count() / tick);
+      phases_[idx] = idx % dividers_[idx];
+    }
+  }
+
+  /// \return the period of the timing source
+  [[nodiscard]] constexpr auto tick() const noexcept -> std::chrono::nanoseconds { return tick_; }
+
+  [[nodiscard]] constexpr auto size() const noexcept -> std::size_t { return size_; }
+
+  /// \return the number of ticks in the period of a group
+  [[nodiscard]] constexpr auto divider(std::size_t group) const noexcept -> std::uint64_t { return dividers_[group]; }
+
+  [[nodiscard]] constexpr auto all() const noexcept -> mask_t {
+    return size_ == sizeof(mask_t) * 8 ? ~mask_t{ 0 } : (mask_t{ 1 } << size_) - 1;
+  }
+
+  /// \return the groups due at the given tick
+  [[nodiscard]] constexpr auto due(std::uint64_t tick) const noexcept -> mask_t {
+    mask_t mask{};
+    for (std::size_t idx = 0; idx < size_; idx++) {
+      if ((tick + phases_[idx]) % dividers_[idx] == 0) {
+        mask |= mask_t{ 1 } << idx;
+      }
+    }
+    return mask;
+  }
+
+private:
+  std::size_t size_{};
+  std::chrono::nanoseconds tick_{};
+  std::array<std::uint64_t, max_groups> dividers_{};
+  std::array<std::uint64_t, max_groups> phases_{};
+};
+
+static_assert(group_schedule{}.tick() == std::chrono::milliseconds{ 1 });
+static_assert(group_schedule{}.due(0) == 1 && group_schedule{}.due(1) == 1);
+
+}  // namespace tfc::ec
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <tfc/ec/devices/device.hpp>
+#include <tfc/ec/simulation/models.hpp>
+#include <tfc/ec/soem_interface.hpp>
+#include <tfc/ipc/details/shm.hpp>
+
+/// Simulated EtherCAT bus, runs the devices and their process data cycle without a network interface or slaves
+namespace tfc::ec::simulation {
+
+/// Location of a slave's process data in the io map
+struct slave_layout {
+  std::uint32_t input_offset{};
+  std::uint32_t input_size{};
+  std::uint32_t output_offset{};
+  std::uint32_t output_size{};
+};
+
+/**
+ * A line of simulated slaves answering the process data and SDO exchanges of the master.
+ * The io map is laid out the way SOEM's overlapping map does it, the outputs of every slave followed by the inputs of
+ * every slave, and one exchange counts the working counter the way a logical read write frame does.
+ */
+class bus {
+public:
+  /// Add a slave at the end of the line
+  /// \return its slave index, starting at 1 as on a real bus
+  auto add(models::model added) -> std::uint16_t;
+
+  [[nodiscard]] auto slave_count() const noexcept -> std::size_t { return slaves_.size(); }
+
+  /// \return vendor id and product code of a slave
+  [[nodiscard]] auto identity(std::uint16_t slave_index) const -> std::pair<std::uint32_t, std::uint32_t>;
+
+  /// \return the model of a slave
+  template <typename model_t>
+  [[nodiscard]] auto model(std::uint16_t slave_index) -> model_t& {
+    return std::get<model_t>(slaves_.at(slave_index - 1).model);
+  }
+
+  /**
+   * Lay out the process data of every slave in the io map
+   * @return the number of bytes used
+   * @throws std::length_error if the process data does not fit the io map
+   */
+  auto map(std::span<std::byte> io) -> std::size_t;
+
+  [[nodiscard]] auto layout(std::uint16_t slave_index) const -> slave_layout const& {
+    return slaves_.at(slave_index - 1).layout;
+  }
+
+  /// \return the working counter of an exchange where every slave answers
+  [[nodiscard]] auto expected_wkc() const noexcept -> ecx::working_counter_t;
+
+  /// Let every slave read its outputs from and write its inputs to the io map
+  /// \return the working counter, lost slaves do not count
+  auto exchange() -> ecx::working_counter_t;
+
+  auto sdo_write(std::uint16_t slave_index,
+                 ecx::index_t index,
+                 ecx::complete_access_t access,
+                 std::span<std::byte> data,
+                 std::chrono::microseconds timeout) -> ecx::working_counter_t;
+
+  [[nodiscard]] auto sdo_writes(std::uint16_t slave_index) const -> std::size_t {
+    return slaves_.at(slave_index - 1).sdo_writes;
+  }
+
+  /// A lost slave neither answers exchanges nor SDOs, as if it was disconnected
+  void set_lost(std::uint16_t slave_index, bool lost) { slaves_.at(slave_index - 1).lost = lost; }
+
+  [[nodiscard]] auto lost(std::uint16_t slave_index) const -> bool { return slaves_.at(slave_index - 1).lost; }
+
+private:
+  struct slave {
+    models::model model;
+    slave_layout layout{};
+    bool lost{ false };
+    std::size_t sdo_writes{};
+  };
+  std::vector<slave> slaves_;
+  std::span<std::byte> io_;
+};
+
+/**
+ * The process data cycle of context_t run against a simulated bus.
+ * Devices are made from the device registry by the identity of each simulated slave, set up over the simulated SDO
+ * channel and dispatched from the same dispatch table as on a real bus.
+ */
+template <typename manager_client_type, std::size_t pdo_buffer_size = 4096>
+class context {
+public:
+  context(std::shared_ptr<sdbusplus::asio::connection> connection, manager_client_type& client, bus& simulated)
+      : connection_{ std::move(connection) }, bus_{ simulated } {
+    slaves_.reserve(bus_.slave_count() + 1);
+    slaves_.emplace_back(std::in_place_type<devices::default_device>, 0);
+    for (std::uint16_t slave_index = 1; slave_index <= bus_.slave_count(); slave_index++) {
+      auto const [vendor_id, product_code]{ bus_.identity(slave_index) };
+      slaves_.emplace_back(devices::get(connection_, client, slave_index, vendor_id, product_code));
+      slaves_.back().set_sdo_write_cb([this, slave_index](ecx::index_t idx, ecx::complete_access_t acc,
+                                                          std::span<std::byte> data, std::chrono::microseconds timeout) {
+        return bus_.sdo_write(slave_index, idx, acc, data, timeout);
+      });
+      slaves_.back().setup();
+    }
+    bus_.map(io_);
+    dispatch_table_.reserve(bus_.slave_count());
+    for (std::uint16_t slave_index = 1; slave_index <= bus_.slave_count(); slave_index++) {
+      auto const [process_data, device]{ slaves_[slave_index].resolve_process_data() };
+      auto const& layout{ bus_.layout(slave_index) };
+      dispatch_table_.emplace_back(devices::dispatch_entry{ .process_data = process_data,
+                                                            .device = device,
+                                                            .slave_index = slave_index,
+                                                            .input_offset = layout.input_offset,
+                                                            .input_size = layout.input_size,
+                                                            .output_offset = layout.output_offset,
+                                                            .output_size = layout.output_size });
+    }
+  }
+
+  context(context const&) = delete;
+  auto operator=(context const&) -> context& = delete;
+
+  /// One process data cycle, exchange with the bus and dispatch the slaves
+  /// \return the working counter of the exchange
+  auto processdata() -> ecx::working_counter_t {
+    // same as the real bus, the values the slaves publish are stamped with the time of the exchange
+    ipc::details::shm::sample_time const sampled{ std::chrono::steady_clock::now() };
+    auto const wkc{ bus_.exchange() };
+    std::span<std::uint8_t> const bytes{ reinterpret_cast<std::uint8_t*>(io_.data()), io_.size() };
+    devices::dispatch(dispatch_table_, bytes, [this](std::uint16_t slave_index) { return bus_.lost(slave_index); });
+    return wkc;
+  }
+
+  [[nodiscard]] auto expected_wkc() const noexcept -> ecx::working_counter_t { return bus_.expected_wkc(); }
+
+  /// \return the device made for a slave
+  /// \throws std::bad_variant_access if the slave's device is not a device_t
+  template <typename device_t>
+  [[nodiscard]] auto device(std::uint16_t slave_index) -> device_t& {
+    return std::get<device_t>(*slaves_.at(slave_index).device_);
+  }
+
+private:
+  std::shared_ptr<sdbusplus::asio::connection> connection_;
+  bus& bus_;
+  std::vector<devices::device<manager_client_type>> slaves_;
+  std::vector<devices::dispatch_entry> dispatch_table_;
+  std::array<std::byte, pdo_buffer_size> io_{};
+};
+
+}  // namespace tfc::ec::simulation
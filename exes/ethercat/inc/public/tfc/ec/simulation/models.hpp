@@ -0,0 +1,252 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <variant>
+
+#include <tfc/cia/402.hpp>
+#include <tfc/ec/devices/beckhoff/EL1xxx.hpp>
+#include <tfc/ec/devices/beckhoff/EL2xxx.hpp>
+#include <tfc/ec/devices/beckhoff/digital_io.hpp>
+#include <tfc/ec/devices/eilersen/4x60a.hpp>
+#include <tfc/ec/devices/schneider/atv320.hpp>
+
+/// Models of slaves for the simulated bus, each answers the process data exchange the way its device would
+namespace tfc::ec::simulation::models {
+
+namespace details {
+template <typename pdo_t>
+  requires std::is_trivially_copyable_v<pdo_t>
+auto read(std::span<std::byte const> bytes) noexcept -> pdo_t {
+  pdo_t value{};
+  std::memcpy(static_cast<void*>(&value), bytes.data(), std::min(bytes.size(), sizeof(pdo_t)));
+  return value;
+}
+
+template <typename pdo_t>
+  requires std::is_trivially_copyable_v<pdo_t>
+void write(pdo_t const& value, std::span<std::byte> bytes) noexcept {
+  std::memcpy(bytes.data(), static_cast<void const*>(&value), std::min(bytes.size(), sizeof(pdo_t)));
+}
+}  // namespace details
+
+/// Beckhoff digital input terminal, the inputs count up every toggle_every cycles when it is not zero
+template <std::size_t channels, std::uint32_t pc>
+class digital_inputs {
+public:
+  static constexpr std::uint32_t vendor_id{ 0x2 };
+  static constexpr std::uint32_t product_code{ pc };
+  static constexpr std::size_t input_size{ (channels / 9) + 1 };
+  static constexpr std::size_t output_size{ 0 };
+
+  explicit digital_inputs(std::uint64_t toggle_every = 0) noexcept : toggle_every_{ toggle_every } {}
+
+  void set_inputs(std::uint64_t word) noexcept { word_ = word & devices::beckhoff::channel_mask<channels>; }
+  [[nodiscard]] auto inputs() const noexcept -> std::uint64_t { return word_; }
+
+  void exchange(std::span<std::byte const>, std::span<std::byte> inputs) noexcept {
+    if (toggle_every_ != 0 && ++cycle_ % toggle_every_ == 0) {
+      set_inputs(word_ + 1);
+    }
+    for (std::size_t idx = 0; idx < inputs.size(); idx++) {
+      inputs[idx] = static_cast<std::byte>(word_ >> (idx * 8));
+    }
+  }
+
+private:
+  std::uint64_t toggle_every_{};
+  std::uint64_t cycle_{};
+  std::uint64_t word_{};
+};
+
+/// Beckhoff digital output terminal, keeps the outputs of the last exchange
+template <std::size_t channels, std::uint32_t pc>
+class digital_outputs {
+public:
+  static constexpr std::uint32_t vendor_id{ 0x2 };
+  static constexpr std::uint32_t product_code{ pc };
+  static constexpr std::size_t input_size{ 0 };
+  static constexpr std::size_t output_size{ (channels / 9) + 1 };
+
+  [[nodiscard]] auto outputs() const noexcept -> std::uint64_t { return word_; }
+
+  void exchange(std::span<std::byte const> outputs, std::span<std::byte>) noexcept {
+    std::array<std::uint8_t, output_size> bytes{};
+    std::memcpy(bytes.data(), outputs.data(), std::min(outputs.size(), bytes.size()));
+    word_ = devices::beckhoff::pack<channels>(bytes);
+  }
+
+private:
+  std::uint64_t word_{};
+};
+
+using el1002 = digital_inputs<2, devices::beckhoff::el1002<devices::beckhoff::imc>::product_code>;
+using el1008 = digital_inputs<8, devices::beckhoff::el1008<devices::beckhoff::imc>::product_code>;
+using el1809 = digital_inputs<16, devices::beckhoff::el1809<devices::beckhoff::imc>::product_code>;
+using el2004 = digital_outputs<4, devices::beckhoff::el2004<devices::beckhoff::imc>::product_code>;
+using el2008 = digital_outputs<8, devices::beckhoff::el2008<devices::beckhoff::imc>::product_code>;
+using el2809 = digital_outputs<16, devices::beckhoff::el2809<devices::beckhoff::imc>::product_code>;
+
+/// Schneider ATV320 drive, follows the CiA 402 state machine and runs at the commanded frequency when enabled
+class atv320 {
+public:
+  using input_t = devices::schneider::atv320::input_t;
+  using output_t = devices::schneider::atv320::output_t;
+  static constexpr std::uint32_t vendor_id{ devices::schneider::atv320::device<ipc_ruler::ipc_manager_client>::vendor_id };
+  static constexpr std::uint32_t product_code{
+    devices::schneider::atv320::device<ipc_ruler::ipc_manager_client>::product_code
+  };
+  static constexpr std::size_t input_size{ sizeof(input_t) };
+  static constexpr std::size_t output_size{ sizeof(output_t) };
+
+  [[nodiscard]] auto state() const noexcept -> cia_402::states_e { return state_; }
+  /// Latch a fault, it is cleared by a fault reset from the master
+  void set_fault(devices::schneider::atv320::lft_e error) noexcept {
+    state_ = cia_402::states_e::fault;
+    last_error_ = error;
+  }
+
+  void exchange(std::span<std::byte const> outputs, std::span<std::byte> inputs) noexcept {
+    auto const command{ details::read<output_t>(outputs) };
+    state_ = next_state(state_, command.control);
+    if (state_ != cia_402::states_e::fault) {
+      last_error_ = devices::schneider::atv320::lft_e::no_fault;
+    }
+    bool const running{ state_ == cia_402::states_e::operation_enabled };
+    input_t status{};
+    status.status_word = status_word_of(state_);
+    status.frequency = running ? command.frequency : decltype(command.frequency){};
+    status.last_error = last_error_;
+    status.drive_state = running ? devices::schneider::atv320::hmis_e::run
+                         : state_ == cia_402::states_e::fault ? devices::schneider::atv320::hmis_e::fault
+                                                              : devices::schneider::atv320::hmis_e::rdy;
+    details::write(status, inputs);
+  }
+
+  /// \return the state the drive moves to from current on the given control word, one transition per cycle
+  [[nodiscard]] static constexpr auto next_state(cia_402::states_e current, cia_402::control_word control) noexcept
+      -> cia_402::states_e {
+    using enum cia_402::states_e;
+    if (current == fault || current == fault_reaction_active) {
+      return control.fault_reset ? switch_on_disabled : fault;
+    }
+    if (!control.enable_voltage) {
+      return switch_on_disabled;
+    }
+    if (!control.quick_stop) {
+      return current == operation_enabled || current == quick_stop_active ? quick_stop_active : switch_on_disabled;
+    }
+    switch (current) {
+      case not_ready_to_switch_on:
+        return switch_on_disabled;
+      case switch_on_disabled:
+      case quick_stop_active:
+        return ready_to_switch_on;
+      case ready_to_switch_on:
+        return control.switch_on ? switched_on : ready_to_switch_on;
+      case switched_on:
+      case operation_enabled:
+        if (!control.switch_on) {
+          return ready_to_switch_on;
+        }
+        return control.enable_operation ? operation_enabled : switched_on;
+      default:
+        return current;
+    }
+  }
+
+  /// \return the status word a drive reports in the given state
+  [[nodiscard]] static constexpr auto status_word_of(cia_402::states_e state) noexcept -> cia_402::status_word {
+    using enum cia_402::states_e;
+    switch (state) {
+      case switch_on_disabled:
+        return { .state_switch_on_disabled = true };
+      case ready_to_switch_on:
+        return { .state_ready_to_switch_on = true, .state_quick_stop = true };
+      case switched_on:
+        return { .state_ready_to_switch_on = true, .state_switched_on = true, .voltage_enabled = true,
+                 .state_quick_stop = true };
+      case operation_enabled:
+        return { .state_ready_to_switch_on = true, .state_switched_on = true, .state_operation_enabled = true,
+                 .voltage_enabled = true, .state_quick_stop = true };
+      case quick_stop_active:
+        return { .state_ready_to_switch_on = true, .state_switched_on = true, .state_operation_enabled = true,
+                 .voltage_enabled = true };
+      case fault_reaction_active:
+        return { .state_ready_to_switch_on = true, .state_switched_on = true, .state_operation_enabled = true,
+                 .state_fault = true };
+      case fault:
+        return { .state_fault = true };
+      case not_ready_to_switch_on:
+        return {};
+    }
+    return {};
+  }
+
+private:
+  cia_402::states_e state_{ cia_402::states_e::switch_on_disabled };
+  devices::schneider::atv320::lft_e last_error_{ devices::schneider::atv320::lft_e::no_fault };
+};
+
+/// Eilersen 4x60a load cell module, reports the set cell signals with deterministic noise on top
+class e4x60a {
+public:
+  using input_t = devices::eilersen::e4x60a::pdo_input;
+  using output_t = devices::eilersen::e4x60a::pdo_output;
+  using signals_t = std::array<devices::eilersen::e4x60a::signal_t, devices::eilersen::e4x60a::max_cells>;
+  static constexpr std::uint32_t vendor_id{
+    devices::eilersen::e4x60a::e4x60a<ipc_ruler::ipc_manager_client>::vendor_id
+  };
+  static constexpr std::uint32_t product_code{
+    devices::eilersen::e4x60a::e4x60a<ipc_ruler::ipc_manager_client>::product_code
+  };
+  static constexpr std::size_t input_size{ sizeof(input_t) };
+  static constexpr std::size_t output_size{ sizeof(output_t) };
+
+  /// @param noise the largest deviation from the set signals, zero for none
+  explicit e4x60a(devices::eilersen::e4x60a::signal_t noise = 0) noexcept : noise_{ noise } {}
+
+  void set_signals(signals_t const& signals) noexcept { signals_ = signals; }
+  void set_broken(std::size_t cell, bool broken) noexcept { broken_[cell] = broken; }
+
+  void exchange(std::span<std::byte const>, std::span<std::byte> inputs) noexcept {
+    input_t status{};
+    status.status = { .cell_1_broken = broken_[0],
+                      .cell_2_broken = broken_[1],
+                      .cell_3_broken = broken_[2],
+                      .cell_4_broken = broken_[3] };
+    status.nr_of_inputs = static_cast<std::uint8_t>(signals_.size());
+    for (std::size_t idx = 0; idx < signals_.size(); idx++) {
+      status.weight_signals[idx] = signals_[idx] + next_noise();
+    }
+    details::write(status, inputs);
+  }
+
+private:
+  auto next_noise() noexcept -> devices::eilersen::e4x60a::signal_t {
+    if (noise_ == 0) {
+      return 0;
+    }
+    // xorshift32, the same sequence on every run
+    seed_ ^= seed_ << 13U;
+    seed_ ^= seed_ >> 17U;
+    seed_ ^= seed_ << 5U;
+    auto const span{ static_cast<std::uint32_t>(noise_) * 2 + 1 };
+    return static_cast<devices::eilersen::e4x60a::signal_t>(seed_ % span) - noise_;
+  }
+
+  devices::eilersen::e4x60a::signal_t noise_{};
+  std::uint32_t seed_{ 0x9e3779b9 };
+  signals_t signals_{};
+  std::array<bool, devices::eilersen::e4x60a::max_cells> broken_{};
+};
+
+using model = std::variant<el1002, el1008, el1809, el2004, el2008, el2809, atv320, e4x60a>;
+
+}  // namespace tfc::ec::simulation::models
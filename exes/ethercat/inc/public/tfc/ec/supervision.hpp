@@ -0,0 +1,118 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace tfc::ec::supervision {
+
+/**
+ * Sequence lock for a single writer publishing a trivially copyable value to any number of readers.
+ * The writer never waits, readers retry if they raced with a write.
+ * The value is stored as relaxed atomic words so concurrent copies are well defined.
+ */
+template <typename value_t>
+  requires std::is_trivially_copyable_v<value_t> && std::is_default_constructible_v<value_t>
+class seqlock {
+public:
+  void store(value_t const& value) noexcept {
+    auto const sequence{ sequence_.load(std::memory_order_relaxed) };
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::array<std::uint64_t, word_count> words{};
+    std::memcpy(words.data(), &value, sizeof(value_t));
+    for (std::size_t idx = 0; idx < word_count; idx++) {
+      words_[idx].store(words[idx], std::memory_order_relaxed);
+    }
+    sequence_.store(sequence + 2, std::memory_order_release);
+  }
+
+  [[nodiscard]] auto load() const noexcept -> value_t {
+    value_t value{};
+    std::uint64_t sequence{};
+    while (!try_load(value, sequence)) {
+    }
+    return value;
+  }
+
+  /**
+   * Load the value if it has been stored since the given sequence number
+   * @param value updated with the latest value if it has changed
+   * @param sequence the sequence number of the value the caller has, updated with the sequence number of the new value
+   * @return true if value was updated
+   */
+  auto load_if_changed(value_t& value, std::uint64_t& sequence) const noexcept -> bool {
+    while (sequence_.load(std::memory_order_acquire) != sequence) {
+      if (try_load(value, sequence)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// \return the sequence number of the latest value, zero if nothing has been stored
+  [[nodiscard]] auto sequence() const noexcept -> std::uint64_t { return sequence_.load(std::memory_order_acquire); }
+
+private:
+  auto try_load(value_t& value, std::uint64_t& sequence) const noexcept -> bool {
+    auto const before{ sequence_.load(std::memory_order_acquire) };
+    if (before % 2 != 0) {
+      return false;
+    }
+    std::array<std::uint64_t, word_count> words{};
+    for (std::size_t idx = 0; idx < word_count; idx++) {
+      words[idx] = words_[idx].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence_.load(std::memory_order_relaxed) != before) {
+      return false;
+    }
+    std::memcpy(static_cast<void*>(&value), words.data(), sizeof(value_t));
+    sequence = before;
+    return true;
+  }
+
+  static constexpr std::size_t word_count{ (sizeof(value_t) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t) };
+  std::atomic<std::uint64_t> sequence_{ 0 };
+  std::array<std::atomic<std::uint64_t>, word_count> words_{};
+};
+
+/**
+ * Wakes a supervising thread on demand instead of having it poll.
+ * Requests made while one is already pending are merged, so requesting every cycle is cheap.
+ */
+class trigger {
+public:
+  void request() noexcept {
+    if (!pending_.exchange(true, std::memory_order_acq_rel)) {
+      pending_.notify_one();
+    }
+  }
+
+  /// Block until a request is made and consume it
+  void wait() noexcept {
+    pending_.wait(false, std::memory_order_acquire);
+    pending_.store(false, std::memory_order_release);
+  }
+
+private:
+  std::atomic<bool> pending_{ false };
+};
+
+/// State of a single slave as last read by the supervisor
+struct slave_health {
+  std::uint16_t state{};
+  std::uint16_t al_status_code{};
+  bool lost{};
+};
+
+/// State of every slave on the bus, indexed by slave index. Index 0 is the master and is unused.
+template <std::size_t max_slaves>
+struct bus_health {
+  std::array<slave_health, max_slaves> slaves{};
+};
+
+}  // namespace tfc::ec::supervision
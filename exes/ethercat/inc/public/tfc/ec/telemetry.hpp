@@ -0,0 +1,152 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <glaze/core/common.hpp>
+
+namespace tfc::ec::telemetry {
+
+/**
+ * Log-linear histogram of durations, in the spirit of HdrHistogram.
+ * Each power of two range is split into sub_bucket_count equal buckets, giving a relative error below 1/sub_bucket_count
+ * over the whole range from one nanosecond to max_value.
+ * Recording is wait free and meant for a single recording thread, any thread may take snapshots concurrently.
+ */
+class histogram {
+public:
+  static constexpr std::size_t sub_bucket_bits{ 4 };
+  static constexpr std::size_t sub_bucket_count{ std::size_t{ 1 } << sub_bucket_bits };
+  static constexpr std::size_t value_bits{ 40 };
+  static constexpr std::uint64_t max_value{ (std::uint64_t{ 1 } << value_bits) - 1 };  // about 18 minutes
+  static constexpr std::size_t bucket_count{ (value_bits - sub_bucket_bits + 1) * sub_bucket_count };
+
+  /// \return the bucket index of a value in nanoseconds, values above max_value land in the last bucket
+  [[nodiscard]] static constexpr auto bucket_of(std::uint64_t value) noexcept -> std::size_t {
+    value = std::min(value, max_value);
+    if (value < sub_bucket_count) {
+      return static_cast<std::size_t>(value);
+    }
+    auto const shift{ static_cast<std::size_t>(std::bit_width(value)) - 1 - sub_bucket_bits };
+    auto const sub_bucket{ static_cast<std::size_t>(value >> shift) - sub_bucket_count };
+    return (shift + 1) * sub_bucket_count + sub_bucket;
+  }
+
+  /// \return the highest value in nanoseconds that is recorded in the given bucket
+  [[nodiscard]] static constexpr auto upper_bound_of(std::size_t bucket) noexcept -> std::uint64_t {
+    auto const group{ bucket / sub_bucket_count };
+    auto const sub_bucket{ bucket % sub_bucket_count };
+    if (group == 0) {
+      return sub_bucket;
+    }
+    return ((std::uint64_t{ sub_bucket_count + sub_bucket + 1 }) << (group - 1)) - 1;
+  }
+
+  /// Counts of a histogram at a point in time
+  struct snapshot {
+    std::array<std::uint64_t, bucket_count> counts{};
+    std::uint64_t count{};
+    std::chrono::nanoseconds sum{};
+
+    /// \return the smallest recorded value which is greater or equal to the given quantile of all values
+    /// \param quantile in the range [0, 1]
+    [[nodiscard]] auto value_at(double quantile) const noexcept -> std::chrono::nanoseconds;
+
+    /// \return the mean of the recorded values
+    [[nodiscard]] auto mean() const noexcept -> std::chrono::nanoseconds;
+
+    /// \return the values recorded since an earlier snapshot of the same histogram
+    [[nodiscard]] auto operator-(snapshot const& earlier) const noexcept -> snapshot;
+  };
+
+  void record(std::chrono::nanoseconds value) noexcept {
+    auto const nanoseconds{ static_cast<std::uint64_t>(std::max(value.count(), std::chrono::nanoseconds::rep{ 0 })) };
+    // Single writer, a plain load and store avoids the locked read-modify-write instructions
+    auto& bucket{ counts_[bucket_of(nanoseconds)] };
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    sum_.store(sum_.load(std::memory_order_relaxed) + nanoseconds, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto take_snapshot() const noexcept -> snapshot;
+
+private:
+  std::array<std::atomic<std::uint64_t>, bucket_count> counts_{};
+  std::atomic<std::uint64_t> sum_{};
+};
+
+static_assert(histogram::bucket_of(0) == 0);
+static_assert(histogram::bucket_of(15) == 15);
+static_assert(histogram::bucket_of(16) == 16);
+static_assert(histogram::bucket_of(33) == histogram::bucket_of(32));
+static_assert(histogram::upper_bound_of(histogram::bucket_of(32)) == 33);
+static_assert(histogram::bucket_of(histogram::max_value) == histogram::bucket_count - 1);
+static_assert(histogram::bucket_of(histogram::max_value + 1) == histogram::bucket_count - 1);
+
+/// Timing counters of the process data cycle, written from the cycle and read by whoever publishes them
+struct cycle_recorder {
+  /// Time from the start of one cycle to the start of the next one
+  histogram period{};
+  /// Time spent sending and receiving process data
+  histogram roundtrip{};
+  /// Time spent by the slaves processing their process data
+  histogram processing{};
+  std::atomic<std::uint64_t> overruns{};
+  std::atomic<std::uint64_t> working_counter_mismatches{};
+};
+
+struct percentile {
+  double quantile{};
+  std::chrono::nanoseconds value{};
+  struct glaze {
+    static constexpr auto value{ glz::object("quantile", &percentile::quantile, "value", &percentile::value) };
+    static constexpr std::string_view name{ "percentile" };
+  };
+};
+
+struct distribution {
+  std::uint64_t count{};
+  std::chrono::nanoseconds mean{};
+  std::chrono::nanoseconds max{};
+  std::vector<percentile> percentiles{};
+  struct glaze {
+    // clang-format off
+    static constexpr auto value{ glz::object("count", &distribution::count,
+                                             "mean", &distribution::mean,
+                                             "max", &distribution::max,
+                                             "percentiles", &distribution::percentiles) };
+    // clang-format on
+    static constexpr std::string_view name{ "distribution" };
+  };
+};
+
+/// Cycle timing over one reporting interval
+struct statistics {
+  distribution period{};
+  distribution roundtrip{};
+  distribution processing{};
+  std::uint64_t overruns{};
+  std::uint64_t working_counter_mismatches{};
+  struct glaze {
+    // clang-format off
+    static constexpr auto value{ glz::object("period", &statistics::period,
+                                             "roundtrip", &statistics::roundtrip,
+                                             "processing", &statistics::processing,
+                                             "overruns", &statistics::overruns,
+                                             "working_counter_mismatches", &statistics::working_counter_mismatches) };
+    // clang-format on
+    static constexpr std::string_view name{ "statistics" };
+  };
+};
+
+/// \return the distribution of a histogram snapshot at the given quantiles
+auto summarize(histogram::snapshot const& values, std::span<double const> quantiles) -> distribution;
+
+}  // namespace tfc::ec::telemetry
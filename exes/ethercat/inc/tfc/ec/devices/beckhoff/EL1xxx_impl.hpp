@@ -13,11 +13,18 @@ template <typename manager_client_type,
           uint32_t pc,
           stx::basic_fixed_string name,
           template <typename, typename>
-          typename signal_t>
-el1xxx<manager_client_type, size, entries, pc, name, signal_t>::el1xxx(asio::io_context& ctx,
-                                                                       manager_client_type& client,
-                                                                       const uint16_t slave_index)
-    : base<el1xxx<manager_client_type, size, entries, pc, name, signal_t>>(slave_index) {
+          typename signal_t,
+          template <typename, typename, typename>
+          typename confman_t>
+el1xxx<manager_client_type, size, entries, pc, name, signal_t, confman_t>::el1xxx(asio::io_context& ctx,
+                                                                                  manager_client_type& client,
+                                                                                  const uint16_t slave_index)
+    : base<el1xxx<manager_client_type, size, entries, pc, name, signal_t, confman_t>>(slave_index),
+      packed_transmitter_{ std::make_shared<uint_signal_t>(ctx,
+                                                           client,
+                                                           fmt::format("{}.s{}.in", name.view(), slave_index),
+                                                           "Digital inputs, input n in bit n") },
+      config_{ shared_config<el1xxx, config_t>(client.connection(), name.view()) } {
   for (size_t i = 0; i < size; i++) {
     transmitters_[i] = std::make_unique<bool_signal_t>(
         ctx, client, fmt::format("{}.s{}.in{}", name.view(), slave_index, entries[i]), "Digital input");
@@ -31,23 +38,34 @@ template <typename manager_client_type,
           uint32_t pc,
           stx::basic_fixed_string name,
           template <typename, typename>
-          typename signal_t>
-void el1xxx<manager_client_type, size, entries, pc, name, signal_t>::pdo_cycle(input_pdo const& input,
-                                                                               std::span<std::uint8_t>) noexcept {
-  // Loop bytes
-  for (size_t idx = 0; idx < input.size(); idx++) {
-    for (size_t bits = 0; bits < 8 && size - ((idx * 8) + bits) > 0; bits++) {
-      auto const value = static_cast<bool>(input[idx] & (1 << bits));
-      const size_t bit_index = idx * 8 + bits;
-      if (!last_values_[bit_index].has_value() || value != last_values_[bit_index]) {
-        transmitters_[bit_index]->async_send(value, [this](std::error_code error, size_t) {
-          if (error) {
-            this->logger_.error("Ethercat {}, error transmitting : {}", name.view(), error.message());
-          }
-        });
-      }
-      last_values_[bit_index] = value;
+          typename signal_t,
+          template <typename, typename, typename>
+          typename confman_t>
+void el1xxx<manager_client_type, size, entries, pc, name, signal_t, confman_t>::pdo_cycle(input_pdo const& input,
+                                                                                          std::span<std::uint8_t>) noexcept {
+  auto const word{ pack<size>(input) };
+  // Every input is sent on the first cycle
+  auto const changed{ last_word_.has_value() ? word ^ last_word_.value() : channel_mask<size> };
+  last_word_ = word;
+  auto const channel_signals{ config_->value().channel_signals };
+  // Every input is sent on the channel signals when they are turned back on, they are stale after being off
+  auto const channels_changed{ channel_signals && !channel_signals_on_ ? channel_mask<size> : changed };
+  channel_signals_on_ = channel_signals;
+  if (changed == 0 && channels_changed == 0) {
+    return;
+  }
+  auto const on_error{ [this](std::error_code error, size_t) {
+    if (error) {
+      this->logger_.error("Ethercat {}, error transmitting : {}", name.view(), error.message());
     }
+  } };
+  if (changed != 0) {
+    packed_transmitter_->async_send(word, on_error);
+  }
+  if (channel_signals) {
+    for_each_changed(channels_changed, word, [this, &on_error](size_t channel, bool value) {
+      transmitters_[channel]->async_send(value, on_error);
+    });
   }
 }
 }  // namespace tfc::ec::devices::beckhoff
@@ -15,7 +15,13 @@ template <typename manager_client_type,
 el2xxx<manager_client_type, size, entries, pc, name>::el2xxx(asio::io_context& ctx,
                                                              manager_client_type& client,
                                                              uint16_t slave_index)
-    : base<el2xxx>(slave_index) {
+    : base<el2xxx>(slave_index),
+      packed_receiver_{ std::make_shared<tfc::ipc::slot<ipc::details::type_uint, manager_client_type&>>(
+          ctx,
+          client,
+          fmt::format("{}.s{}.out", name.view(), slave_index),
+          "Digital outputs, output n in bit n",
+          std::bind_front(&el2xxx::set_outputs, this)) } {
   for (size_t i = 0; i < size; i++) {
     bool_receivers_.emplace_back(std::make_shared<tfc::ipc::slot<ipc::details::type_bool, manager_client_type&>>(
         ctx, client, fmt::format("{}.s{}.out{}", name.view(), slave_index, entries[i]),
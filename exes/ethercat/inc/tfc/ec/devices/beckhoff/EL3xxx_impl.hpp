@@ -0,0 +1,109 @@
+#pragma once
+
+#include <fmt/format.h>
+
+#include <tfc/ec/devices/beckhoff/EL3xxx.hpp>
+#include <tfc/ipc.hpp>
+
+namespace tfc::ec::devices::beckhoff {
+
+template <typename manager_client_type,
+          std::size_t size,
+          std::uint32_t pc,
+          stx::basic_fixed_string name,
+          template <typename, typename>
+          typename signal_t,
+          template <typename, typename, typename>
+          typename confman_t>
+el305x<manager_client_type, size, pc, name, signal_t, confman_t>::el305x(asio::io_context& ctx,
+                                                                        manager_client_type& client,
+                                                                        std::uint16_t const slave_index)
+    : base<el305x<manager_client_type, size, pc, name, signal_t, confman_t>>(slave_index),
+      config_{ client.connection(), fmt::format("{}.s{}", name.view(), slave_index) } {
+  for (std::size_t i = 0; i < size; i++) {
+    current_transmitters_[i] = std::make_shared<current_signal_t>(
+        ctx, client, fmt::format("{}.s{}.current{}", name.view(), slave_index, i + 1), "Analog input current");
+    temperature_transmitters_[i] = std::make_shared<temperature_signal_t>(
+        ctx, client, fmt::format("{}.s{}.temperature{}", name.view(), slave_index, i + 1),
+        "Analog input scaled to the temperature range of the sensor");
+  }
+}
+
+template <typename manager_client_type,
+          std::size_t size,
+          std::uint32_t pc,
+          stx::basic_fixed_string name,
+          template <typename, typename>
+          typename signal_t,
+          template <typename, typename, typename>
+          typename confman_t>
+auto el305x<manager_client_type, size, pc, name, signal_t, confman_t>::setup_driver() -> int {
+  for (std::size_t i = 0; i < size; i++) {
+    // Each channel's settings are in 0x8000 + channel * 0x10, enable siemens bits
+    auto const settings_index{ static_cast<std::uint16_t>(0x8000 + (i * 0x10)) };
+    this->template sdo_write<std::uint8_t>({ settings_index, 0x05 }, static_cast<std::uint8_t>(true));
+  }
+  // Assign the compact TxPDO of each channel, 0x1A01 for the first, instead of the standard one with a status word.
+  // The assignment has to be emptied before it can be changed.
+  this->template sdo_write<std::uint8_t>(ecx::tx_pdo_assign<0x00>, 0);
+  for (std::size_t i = 0; i < size; i++) {
+    this->template sdo_write<std::uint16_t>({ 0x1C13, static_cast<std::uint8_t>(i + 1) },
+                                            static_cast<std::uint16_t>(0x1A01 + (i * 2)));
+  }
+  this->template sdo_write<std::uint8_t>(ecx::tx_pdo_assign<0x00>, static_cast<std::uint8_t>(size));
+  return 1;
+}
+
+template <typename manager_client_type,
+          std::size_t size,
+          std::uint32_t pc,
+          stx::basic_fixed_string name,
+          template <typename, typename>
+          typename signal_t,
+          template <typename, typename, typename>
+          typename confman_t>
+void el305x<manager_client_type, size, pc, name, signal_t, confman_t>::pdo_cycle(input_pdo const& input,
+                                                                                 std::span<std::uint8_t>) noexcept {
+  auto const nano_ampere{ scale_currents<size>(input) };
+  for (std::size_t channel = 0; channel < size; channel++) {
+    publish(channel, to_current(input[channel], nano_ampere[channel]));
+  }
+}
+
+template <typename manager_client_type,
+          std::size_t size,
+          std::uint32_t pc,
+          stx::basic_fixed_string name,
+          template <typename, typename>
+          typename signal_t,
+          template <typename, typename, typename>
+          typename confman_t>
+void el305x<manager_client_type, size, pc, name, signal_t, confman_t>::pdo_error() noexcept {
+  for (std::size_t channel = 0; channel < size; channel++) {
+    publish(channel, std::unexpected{ ipc::details::current_error_e::unknown_error });
+  }
+}
+
+template <typename manager_client_type,
+          std::size_t size,
+          std::uint32_t pc,
+          stx::basic_fixed_string name,
+          template <typename, typename>
+          typename signal_t,
+          template <typename, typename, typename>
+          typename confman_t>
+void el305x<manager_client_type, size, pc, name, signal_t, confman_t>::publish(std::size_t channel,
+                                                                               current_t const& current) noexcept {
+  if (!exceeds_deadband(last_sent_[channel], current, config_->deadband)) {
+    return;
+  }
+  last_sent_[channel] = current;
+  auto const on_error{ [this](std::error_code error, std::size_t) {
+    if (error) {
+      this->logger_.error("Ethercat {}, error transmitting : {}", name.view(), error.message());
+    }
+  } };
+  current_transmitters_[channel]->async_send(current, on_error);
+  temperature_transmitters_[channel]->async_send(to_temperature(current, config_.value()), on_error);
+}
+}  // namespace tfc::ec::devices::beckhoff
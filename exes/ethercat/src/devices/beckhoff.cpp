@@ -1,5 +1,6 @@
 #include <tfc/ec/devices/beckhoff/EL1xxx_impl.hpp>
 #include <tfc/ec/devices/beckhoff/EL2xxx_impl.hpp>
+#include <tfc/ec/devices/beckhoff/EL3xxx_impl.hpp>
 #include <tfc/ipc/details/dbus_client_iface.hpp>
 
 namespace tfc::ec::devices::beckhoff {
@@ -15,4 +16,6 @@ template class el2xxx<imc, el2004<imc>::size_v, el2004<imc>::entries_v, el2004<i
 template class el2xxx<imc, el2008<imc>::size_v, el2008<imc>::entries_v, el2008<imc>::product_code, el2008<imc>::name>;
 template class el2xxx<imc, el2809<imc>::size_v, el2809<imc>::entries_v, el2809<imc>::product_code, el2809<imc>::name>;
 
+template class el305x<imc, el3054<imc>::size_v, el3054<imc>::product_code, el3054<imc>::name>;
+
 }  // namespace tfc::ec::devices::beckhoff
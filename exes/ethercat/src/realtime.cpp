@@ -0,0 +1,87 @@
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <cerrno>
+#include <ctime>
+
+#include <tfc/ec/realtime.hpp>
+
+namespace tfc::ec::rt {
+
+namespace {
+auto to_timespec(std::chrono::steady_clock::time_point point) noexcept -> timespec {
+  auto const since_epoch{ point.time_since_epoch() };
+  auto const seconds{ std::chrono::duration_cast<std::chrono::seconds>(since_epoch) };
+  auto const nanoseconds{ std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch - seconds) };
+  return { .tv_sec = static_cast<time_t>(seconds.count()), .tv_nsec = static_cast<long>(nanoseconds.count()) };
+}
+}  // namespace
+
+auto set_thread_scheduling(std::optional<int> priority, std::optional<std::size_t> cpu) -> std::error_code {
+  if (cpu.has_value()) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu.value(), &set);
+    if (auto const err{ pthread_setaffinity_np(pthread_self(), sizeof(set), &set) }; err != 0) {
+      return { err, std::system_category() };
+    }
+  }
+  if (priority.has_value()) {
+    sched_param const param{ .sched_priority = priority.value() };
+    if (auto const err{ pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) }; err != 0) {
+      return { err, std::system_category() };
+    }
+  }
+  return {};
+}
+
+auto lock_memory() -> std::error_code {
+  if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+    return { errno, std::system_category() };
+  }
+  return {};
+}
+
+cycle_thread::cycle_thread(config::realtime const& config, std::chrono::nanoseconds period, std::function<void()> cycle)
+    : config_{ config }, period_{ period }, cycle_{ std::move(cycle) } {
+  if (config_.lock_memory) {
+    if (auto const err{ lock_memory() }) {
+      logger_.warn("Unable to lock memory, the cycle may page fault: {}", err.message());
+    }
+  }
+  thread_ = std::jthread{ [this](std::stop_token const& token) { run(token); } };
+}
+
+cycle_thread::~cycle_thread() {
+  stop();
+}
+
+void cycle_thread::stop() {
+  if (thread_.joinable()) {
+    thread_.request_stop();
+    thread_.join();
+  }
+}
+
+void cycle_thread::run(std::stop_token const& token) {
+  if (auto const err{ set_thread_scheduling(config_.priority, config_.cpu) }) {
+    logger_.warn("Unable to apply real time scheduling, running with default scheduling: {}", err.message());
+  }
+  auto deadline{ std::chrono::steady_clock::now() };
+  while (!token.stop_requested()) {
+    deadline += period_;
+    auto const deadline_spec{ to_timespec(deadline) };
+    // CLOCK_MONOTONIC is the clock behind std::chrono::steady_clock
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline_spec, nullptr) == EINTR) {
+    }
+    std::invoke(cycle_);
+    cycles_.fetch_add(1, std::memory_order_relaxed);
+    if (auto const now{ std::chrono::steady_clock::now() }; now > deadline + period_) {
+      // Catching up by running back to back cycles would only hammer the bus, start over from now instead
+      overruns_.fetch_add(1, std::memory_order_relaxed);
+      deadline = now;
+    }
+  }
+}
+
+}  // namespace tfc::ec::rt
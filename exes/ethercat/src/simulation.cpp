@@ -0,0 +1,85 @@
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include <tfc/ec/simulation.hpp>
+
+namespace tfc::ec::simulation {
+
+auto bus::add(models::model added) -> std::uint16_t {
+  slaves_.emplace_back(slave{ .model = std::move(added) });
+  return static_cast<std::uint16_t>(slaves_.size());
+}
+
+auto bus::identity(std::uint16_t slave_index) const -> std::pair<std::uint32_t, std::uint32_t> {
+  return std::visit(
+      []<typename model_t>(model_t const&) -> std::pair<std::uint32_t, std::uint32_t> {
+        return { model_t::vendor_id, model_t::product_code };
+      },
+      slaves_.at(slave_index - 1).model);
+}
+
+auto bus::map(std::span<std::byte> io) -> std::size_t {
+  std::size_t output_bytes{};
+  std::size_t input_bytes{};
+  for (auto& item : slaves_) {
+    std::visit(
+        [&]<typename model_t>(model_t const&) {
+          item.layout.output_size = model_t::output_size;
+          item.layout.input_size = model_t::input_size;
+        },
+        item.model);
+    item.layout.output_offset = static_cast<std::uint32_t>(output_bytes);
+    output_bytes += item.layout.output_size;
+  }
+  for (auto& item : slaves_) {
+    item.layout.input_offset = static_cast<std::uint32_t>(output_bytes + input_bytes);
+    input_bytes += item.layout.input_size;
+  }
+  if (output_bytes + input_bytes > io.size()) {
+    throw std::length_error{ fmt::format("Process data of {} bytes does not fit an io map of {} bytes",
+                                         output_bytes + input_bytes, io.size()) };
+  }
+  io_ = io.first(output_bytes + input_bytes);
+  return io_.size();
+}
+
+auto bus::expected_wkc() const noexcept -> ecx::working_counter_t {
+  ecx::working_counter_t wkc{};
+  for (auto const& item : slaves_) {
+    // A logical read write frame counts 2 for each slave it writes and 1 for each it reads
+    wkc += item.layout.output_size > 0 ? 2 : 0;
+    wkc += item.layout.input_size > 0 ? 1 : 0;
+  }
+  return wkc;
+}
+
+auto bus::exchange() -> ecx::working_counter_t {
+  ecx::working_counter_t wkc{};
+  for (auto& item : slaves_) {
+    if (item.lost) {
+      continue;
+    }
+    auto const outputs{ io_.subspan(item.layout.output_offset, item.layout.output_size) };
+    auto const inputs{ io_.subspan(item.layout.input_offset, item.layout.input_size) };
+    std::visit([outputs, inputs](auto& model) { model.exchange(outputs, inputs); }, item.model);
+    wkc += item.layout.output_size > 0 ? 2 : 0;
+    wkc += item.layout.input_size > 0 ? 1 : 0;
+  }
+  return wkc;
+}
+
+auto bus::sdo_write(std::uint16_t slave_index,
+                    ecx::index_t,
+                    ecx::complete_access_t,
+                    std::span<std::byte>,
+                    std::chrono::microseconds) -> ecx::working_counter_t {
+  auto& item{ slaves_.at(slave_index - 1) };
+  if (item.lost) {
+    return 0;
+  }
+  item.sdo_writes++;
+  return 1;
+}
+
+}  // namespace tfc::ec::simulation
@@ -0,0 +1,56 @@
+#include <cmath>
+
+#include <tfc/ec/telemetry.hpp>
+
+namespace tfc::ec::telemetry {
+
+auto histogram::snapshot::value_at(double quantile) const noexcept -> std::chrono::nanoseconds {
+  if (count == 0) {
+    return {};
+  }
+  auto const rank{ std::ceil(std::clamp(quantile, 0.0, 1.0) * static_cast<double>(count)) };
+  auto const target{ std::max(std::uint64_t{ 1 }, static_cast<std::uint64_t>(rank)) };
+  std::uint64_t seen{ 0 };
+  for (std::size_t bucket = 0; bucket < counts.size(); bucket++) {
+    seen += counts[bucket];
+    if (seen >= target) {
+      return std::chrono::nanoseconds{ upper_bound_of(bucket) };
+    }
+  }
+  return std::chrono::nanoseconds{ max_value };
+}
+
+auto histogram::snapshot::mean() const noexcept -> std::chrono::nanoseconds {
+  if (count == 0) {
+    return {};
+  }
+  return sum / static_cast<std::chrono::nanoseconds::rep>(count);
+}
+
+auto histogram::snapshot::operator-(snapshot const& earlier) const noexcept -> snapshot {
+  snapshot result{ .count = count - earlier.count, .sum = sum - earlier.sum };
+  for (std::size_t bucket = 0; bucket < counts.size(); bucket++) {
+    result.counts[bucket] = counts[bucket] - earlier.counts[bucket];
+  }
+  return result;
+}
+
+auto histogram::take_snapshot() const noexcept -> snapshot {
+  snapshot result{ .sum = std::chrono::nanoseconds{ sum_.load(std::memory_order_relaxed) } };
+  for (std::size_t bucket = 0; bucket < counts_.size(); bucket++) {
+    result.counts[bucket] = counts_[bucket].load(std::memory_order_relaxed);
+    result.count += result.counts[bucket];
+  }
+  return result;
+}
+
+auto summarize(histogram::snapshot const& values, std::span<double const> quantiles) -> distribution {
+  distribution result{ .count = values.count, .mean = values.mean(), .max = values.value_at(1.0) };
+  result.percentiles.reserve(quantiles.size());
+  for (auto const quantile : quantiles) {
+    result.percentiles.emplace_back(percentile{ .quantile = quantile, .value = values.value_at(quantile) });
+  }
+  return result;
+}
+
+}  // namespace tfc::ec::telemetry
@@ -1,3 +1,5 @@
+#include <thread>
+
 #include <tfc/motor/atv320motor.hpp>
 
 #include "atv320-server-side.hpp"
@@ -283,6 +285,22 @@ auto main(int, char const* const* argv) -> int {
     inst.ctx.run_for(10ms);
     expect(inst.ran[0]);
   };
+  "mailbox command read after its deadline is not run"_test = [] {
+    instance inst;
+    inst.ctx.run_for(5ms);
+    clientinstance cinst(inst);
+    inst.ctx.run_for(20ms);
+    expect(ut::fatal(cinst.client.mailbox_open()));
+    cinst.client.run(50 * percent, [&inst](const std::error_code& err) {
+      expect(tfc::motor::motor_enum(err) == err_enum::timed_out) << err.message();
+      inst.ran[0] = true;
+    });
+    // the drive does not get to read the command before its deadline
+    std::this_thread::sleep_for(tfc::motor::mailbox::read_deadline + 100ms);
+    inst.ctx.run_for(20ms);
+    expect(inst.ran[0]);
+    expect(inst.ctrl.speed_ratio() == 0 * percent);
+  };
   "reset"_test = [] {
     instance inst;
     inst.ctx.run_for(5ms);
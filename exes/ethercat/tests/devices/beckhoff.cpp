@@ -1,4 +1,5 @@
 #include <array>
+#include <bit>
 #include <bitset>
 #include <cstddef>
 #include <cstdint>
@@ -10,11 +11,13 @@
 
 #include <tfc/ec/devices/beckhoff/EL1xxx_impl.hpp>
 #include <tfc/ec/devices/beckhoff/EL2xxx_impl.hpp>
+#include <tfc/ec/devices/beckhoff/EL3xxx_impl.hpp>
 #include <tfc/ec/devices/beckhoff/EQ2339.hpp>
 #include <tfc/ipc.hpp>
 #include <tfc/ipc/details/dbus_client_iface_mock.hpp>
 #include <tfc/mocks/ipc.hpp>
 #include <tfc/progbase.hpp>
+#include <tfc/stubs/confman.hpp>
 
 namespace asio = boost::asio;
 namespace ut = boost::ut;
@@ -45,7 +48,7 @@ auto main(int argc, const char* argv[]) -> int {
 
   [[maybe_unused]] ut::suite<"EL1xxx"> el1xxx_suite = [] {  // NOLINT
     "2 input"_test = [] {
-      test_vars<beckhoff::el1002<ipc_manager_client_mock, tfc::ipc::mock_signal>> vars{
+      test_vars<beckhoff::el1002<ipc_manager_client_mock, tfc::ipc::mock_signal, tfc::confman::stub_config>> vars{
         .device = { vars.ctx, vars.connect_interface, 42 }
       };
       std::array buffer{ std::uint8_t{ 0b11 } };
@@ -65,7 +68,7 @@ auto main(int argc, const char* argv[]) -> int {
       vars.device.process_data(buffer, {});
     };
     "8 input"_test = [] {
-      test_vars<beckhoff::el1008<ipc_manager_client_mock, tfc::ipc::mock_signal>> vars{
+      test_vars<beckhoff::el1008<ipc_manager_client_mock, tfc::ipc::mock_signal, tfc::confman::stub_config>> vars{
         .device = { vars.ctx, vars.connect_interface, 42 }
       };
       std::array buffer{ std::uint8_t{ 0b11111111 } };
@@ -102,6 +105,55 @@ auto main(int argc, const char* argv[]) -> int {
       EXPECT_CALL(*transmitters.at(7), async_send_cb(false, testing::_)).Times(0);
       vars.device.process_data(buffer, {});
     };
+    "packed input"_test = [] {
+      test_vars<beckhoff::el1809<ipc_manager_client_mock, tfc::ipc::mock_signal, tfc::confman::stub_config>> vars{
+        .device = { vars.ctx, vars.connect_interface, 42 }
+      };
+      std::array buffer{ std::uint8_t{ 0b00000001 }, std::uint8_t{ 0b10000000 } };
+      auto const& packed{ vars.device.packed_transmitter() };
+      EXPECT_CALL(*packed, async_send_cb(0x8001, testing::_)).Times(1);
+      vars.device.process_data(buffer, {});
+
+      // Nothing is sent while the inputs are unchanged
+      EXPECT_CALL(*packed, async_send_cb(testing::_, testing::_)).Times(0);
+      vars.device.process_data(buffer, {});
+      testing::Mock::VerifyAndClearExpectations(packed.get());
+
+      buffer = { std::uint8_t{ 0b00000011 }, std::uint8_t{ 0b10000000 } };
+      auto const& transmitters{ vars.device.transmitters() };
+      EXPECT_CALL(*packed, async_send_cb(0x8003, testing::_)).Times(1);
+      EXPECT_CALL(*transmitters.at(1), async_send_cb(true, testing::_)).Times(1);
+      EXPECT_CALL(*transmitters.at(0), async_send_cb(testing::_, testing::_)).Times(0);
+      EXPECT_CALL(*transmitters.at(15), async_send_cb(testing::_, testing::_)).Times(0);
+      vars.device.process_data(buffer, {});
+    };
+    "channel signals turned back on send every input"_test = [] {
+      test_vars<beckhoff::el1002<ipc_manager_client_mock, tfc::ipc::mock_signal, tfc::confman::stub_config>> vars{
+        .device = { vars.ctx, vars.connect_interface, 42 }
+      };
+      auto const& transmitters{ vars.device.transmitters() };
+      auto const& packed{ vars.device.packed_transmitter() };
+      std::array buffer{ std::uint8_t{ 0b00 } };
+      vars.device.process_data(buffer, {});
+      testing::Mock::VerifyAndClearExpectations(packed.get());
+      testing::Mock::VerifyAndClearExpectations(transmitters.at(0).get());
+      testing::Mock::VerifyAndClearExpectations(transmitters.at(1).get());
+
+      vars.device.config()->access().channel_signals = false;
+      buffer = { std::uint8_t{ 0b01 } };
+      EXPECT_CALL(*packed, async_send_cb(0b01, testing::_)).Times(1);
+      EXPECT_CALL(*transmitters.at(0), async_send_cb(testing::_, testing::_)).Times(0);
+      EXPECT_CALL(*transmitters.at(1), async_send_cb(testing::_, testing::_)).Times(0);
+      vars.device.process_data(buffer, {});
+      testing::Mock::VerifyAndClearExpectations(packed.get());
+
+      // Input 0 changed while the channel signals were off, every input is sent, the unchanged packed word is not
+      vars.device.config()->access().channel_signals = true;
+      EXPECT_CALL(*packed, async_send_cb(testing::_, testing::_)).Times(0);
+      EXPECT_CALL(*transmitters.at(0), async_send_cb(true, testing::_)).Times(1);
+      EXPECT_CALL(*transmitters.at(1), async_send_cb(false, testing::_)).Times(1);
+      vars.device.process_data(buffer, {});
+    };
   };
 
   [[maybe_unused]] ut::suite<"EL2xxx"> el2xxx_suite = [] {  // NOLINT
@@ -136,11 +188,19 @@ auto main(int argc, const char* argv[]) -> int {
       auto bitset{ process_data(vars.device, test_value) };
       ut::expect(bitset == test_value);
     } | std::vector<std::bitset<16>>{ 0b1010101010101010, 0b1111000011110000, 0b1111111111111111, 0b0000000000000000 };
+    "packed outputs"_test = [] {
+      test_vars<beckhoff::el2809<ipc_manager_client_mock>> vars{ .device = { vars.ctx, vars.connect_interface, 42 } };
+      vars.device.set_outputs(0x18001);  // bit 16 is beyond the terminal
+      std::array<std::uint8_t, 2> buffer{};
+      vars.device.process_data({}, buffer);
+      ut::expect(buffer[0] == 0x01);
+      ut::expect(buffer[1] == 0x80);
+    };
   };
 
   [[maybe_unused]] ut::suite<"EQ2339"> eq2339_suite = [] {  // NOLINT
     "16 input"_test = [] {
-      test_vars<beckhoff::eq2339<ipc_manager_client_mock, tfc::ipc::mock_signal>> vars{
+      test_vars<beckhoff::eq2339<ipc_manager_client_mock, tfc::ipc::mock_signal, tfc::confman::stub_config>> vars{
         .device = { vars.ctx, vars.connect_interface, 42 }
       };
 
@@ -224,11 +284,130 @@ auto main(int argc, const char* argv[]) -> int {
     } };
 
     "16 outputs"_test = [](std::bitset<16> test_value) {
-      test_vars<beckhoff::eq2339<ipc_manager_client_mock>> vars{ .device = { vars.ctx, vars.connect_interface, 42 } };
+      test_vars<beckhoff::eq2339<ipc_manager_client_mock, tfc::ipc::mock_signal, tfc::confman::stub_config>> vars{
+        .device = { vars.ctx, vars.connect_interface, 42 }
+      };
       auto bitset{ process_data(vars.device, test_value) };
       ut::expect(bitset == test_value);
     } | std::vector<std::bitset<16>>{ 0b1010101010101010, 0b1111000011110000, 0b1111111111111111, 0b0000000000000000 };
 
+    "first cycle sends only set inputs"_test = [] {
+      test_vars<beckhoff::eq2339<ipc_manager_client_mock, tfc::ipc::mock_signal, tfc::confman::stub_config>> vars{
+        .device = { vars.ctx, vars.connect_interface, 42 }
+      };
+      std::array input{ std::uint8_t{ 0b00000101 }, std::uint8_t{ 0b00000000 } };
+      std::array<std::uint8_t, 2> output{};
+      auto const& transmitters{ vars.device.transmitters() };
+      EXPECT_CALL(*vars.device.packed_transmitter(), async_send_cb(0b101, testing::_)).Times(1);
+      EXPECT_CALL(*transmitters.at(0), async_send_cb(true, testing::_)).Times(1);
+      EXPECT_CALL(*transmitters.at(2), async_send_cb(true, testing::_)).Times(1);
+      for (std::size_t idx{ 1 }; idx < transmitters.size(); idx++) {
+        if (idx != 2) {
+          EXPECT_CALL(*transmitters.at(idx), async_send_cb(testing::_, testing::_)).Times(0);
+        }
+      }
+      vars.device.process_data(input, output);
+    };
+
+    "first cycle with every input off sends the packed word"_test = [] {
+      test_vars<beckhoff::eq2339<ipc_manager_client_mock, tfc::ipc::mock_signal, tfc::confman::stub_config>> vars{
+        .device = { vars.ctx, vars.connect_interface, 42 }
+      };
+      std::array<std::uint8_t, 2> input{};
+      std::array<std::uint8_t, 2> output{};
+      EXPECT_CALL(*vars.device.packed_transmitter(), async_send_cb(0, testing::_)).Times(1);
+      for (auto const& transmitter : vars.device.transmitters()) {
+        EXPECT_CALL(*transmitter, async_send_cb(testing::_, testing::_)).Times(0);
+      }
+      vars.device.process_data(input, output);
+    };
+
+    "packed input and outputs"_test = [] {
+      test_vars<beckhoff::eq2339<ipc_manager_client_mock, tfc::ipc::mock_signal, tfc::confman::stub_config>> vars{
+        .device = { vars.ctx, vars.connect_interface, 42 }
+      };
+      std::array input{ std::uint8_t{ 0x34 }, std::uint8_t{ 0x12 } };
+      std::array<std::uint8_t, 2> output{};
+      EXPECT_CALL(*vars.device.packed_transmitter(), async_send_cb(0x1234, testing::_)).Times(1);
+      vars.device.set_outputs(0xabcd);
+      vars.device.process_data(input, output);
+      ut::expect(output[0] == 0xcd);
+      ut::expect(output[1] == 0xab);
+    };
+  };
+
+  [[maybe_unused]] ut::suite<"EL3xxx"> el3xxx_suite = [] {  // NOLINT
+    using tfc::ipc::details::current_error_e;
+    using tfc::ipc::details::current_t;
+    using tfc::ipc::details::sensor_error_e;
+    using tfc::ipc::details::temperature_t;
+    static constexpr auto nano_ampere{ current_t::value_type::reference };
+    static constexpr auto micro_celsius{ temperature_t::value_type::reference };
+    static constexpr auto compact{ [](std::uint16_t counts, bool out_of_range = false) {
+      return static_cast<std::uint16_t>((counts << 3U) | (out_of_range ? 1U : 0U));
+    } };
+
+    "scaled currents and temperatures"_test = [] {
+      test_vars<beckhoff::el3054<ipc_manager_client_mock, tfc::ipc::mock_signal, tfc::confman::stub_config>> vars{
+        .device = { vars.ctx, vars.connect_interface, 42 }
+      };
+      auto input{ std::bit_cast<std::array<std::uint8_t, 8>>(
+          std::array{ compact(2048), compact(4095, true), compact(0, true), compact(0) }) };
+      auto const& currents{ vars.device.current_transmitters() };
+      auto const& temperatures{ vars.device.temperature_transmitters() };
+      EXPECT_CALL(*currents.at(0), async_send_cb(current_t{ 12'000'000 * nano_ampere }, testing::_)).Times(1);
+      EXPECT_CALL(*temperatures.at(0), async_send_cb(temperature_t{ 40'000'000 * micro_celsius }, testing::_)).Times(1);
+      EXPECT_CALL(*currents.at(1), async_send_cb(current_t{ std::unexpected{ current_error_e::over_range } }, testing::_))
+          .Times(1);
+      EXPECT_CALL(*temperatures.at(1),
+                  async_send_cb(temperature_t{ std::unexpected{ sensor_error_e::over_range } }, testing::_))
+          .Times(1);
+      EXPECT_CALL(*currents.at(2), async_send_cb(current_t{ std::unexpected{ current_error_e::under_range } }, testing::_))
+          .Times(1);
+      EXPECT_CALL(*temperatures.at(2),
+                  async_send_cb(temperature_t{ std::unexpected{ sensor_error_e::under_range } }, testing::_))
+          .Times(1);
+      EXPECT_CALL(*currents.at(3), async_send_cb(current_t{ 4'000'000 * nano_ampere }, testing::_)).Times(1);
+      EXPECT_CALL(*temperatures.at(3), async_send_cb(temperature_t{ -20'000'000 * micro_celsius }, testing::_)).Times(1);
+      vars.device.process_data(input, {});
+    };
+
+    "changes within the deadband are not published"_test = [] {
+      test_vars<beckhoff::el3054<ipc_manager_client_mock, tfc::ipc::mock_signal, tfc::confman::stub_config>> vars{
+        .device = { vars.ctx, vars.connect_interface, 42 }
+      };
+      auto const& currents{ vars.device.current_transmitters() };
+      auto const cycle{ [&vars](std::uint16_t counts) {
+        auto input{ std::bit_cast<std::array<std::uint8_t, 8>>(std::array{ compact(counts), compact(0), compact(0),
+                                                                            compact(0) }) };
+        vars.device.process_data(input, {});
+      } };
+      EXPECT_CALL(*currents.at(0), async_send_cb(testing::_, testing::_)).Times(1);
+      cycle(2048);
+      testing::Mock::VerifyAndClearExpectations(currents.at(0).get());
+
+      // One count is about 3.9 uA, within the default deadband of 10 uA
+      EXPECT_CALL(*currents.at(0), async_send_cb(testing::_, testing::_)).Times(0);
+      cycle(2049);
+      cycle(2046);
+      testing::Mock::VerifyAndClearExpectations(currents.at(0).get());
+
+      EXPECT_CALL(*currents.at(0), async_send_cb(current_t{ 12'011'718 * nano_ampere }, testing::_)).Times(1);
+      cycle(2051);
+    };
+
+    "mismatching process data is an error"_test = [] {
+      test_vars<beckhoff::el3054<ipc_manager_client_mock, tfc::ipc::mock_signal, tfc::confman::stub_config>> vars{
+        .device = { vars.ctx, vars.connect_interface, 42 }
+      };
+      auto const& currents{ vars.device.current_transmitters() };
+      // The standard mapping carries a status word in front of every value
+      std::array<std::uint8_t, 16> standard{};
+      EXPECT_CALL(*currents.at(0), async_send_cb(current_t{ std::unexpected{ current_error_e::unknown_error } }, testing::_))
+          .Times(1);
+      vars.device.process_data(standard, {});
+      vars.device.process_data(standard, {});
+    };
   };
 
   return static_cast<int>(ut::cfg<>.run({ .report_errors = true }));
@@ -0,0 +1,121 @@
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+#include <boost/asio.hpp>
+#include <boost/ut.hpp>
+#include <sdbusplus/asio/connection.hpp>
+
+#include <tfc/ec/devices/beckhoff/EL1xxx_impl.hpp>
+#include <tfc/ec/devices/beckhoff/EL2xxx_impl.hpp>
+#include <tfc/ec/devices/beckhoff/EL3xxx_impl.hpp>
+#include <tfc/ec/simulation.hpp>
+#include <tfc/ipc/details/dbus_client_iface_mock.hpp>
+#include <tfc/progbase.hpp>
+
+namespace asio = boost::asio;
+namespace ut = boost::ut;
+namespace beckhoff = tfc::ec::devices::beckhoff;
+namespace atv320 = tfc::ec::devices::schneider::atv320;
+namespace simulation = tfc::ec::simulation;
+namespace models = tfc::ec::simulation::models;
+
+using tfc::ec::cia_402::states_e;
+using tfc::ipc_ruler::ipc_manager_client_mock;
+using ut::operator""_test;
+using ut::expect;
+
+struct test_line {
+  asio::io_context ctx{};
+  std::shared_ptr<sdbusplus::asio::connection> connection{ std::make_shared<sdbusplus::asio::connection>(ctx) };
+  ipc_manager_client_mock client{ connection };
+  simulation::bus bus{};
+
+  void cycles(simulation::context<ipc_manager_client_mock>& simulated, std::size_t count) {
+    for (std::size_t cycle = 0; cycle < count; cycle++) {
+      simulated.processdata();
+      ctx.poll();
+    }
+  }
+};
+
+auto main(int argc, const char* argv[]) -> int {
+  ut::detail::cfg::parse(argc, argv);
+  std::vector<const char*> args;
+  const char* some_name = "some_name";
+  args.emplace_back(some_name);
+  tfc::base::init(1, args.data());
+
+  "devices are made from the identity of each simulated slave"_test = [] {
+    test_line line{};
+    auto const inputs{ line.bus.add(models::el1008{}) };
+    auto const outputs{ line.bus.add(models::el2008{}) };
+    auto const drive{ line.bus.add(models::atv320{}) };
+    simulation::context<ipc_manager_client_mock> simulated{ line.connection, line.client, line.bus };
+    expect(ut::nothrow([&] { std::ignore = simulated.device<beckhoff::el1008<ipc_manager_client_mock>>(inputs); }));
+    expect(ut::nothrow([&] { std::ignore = simulated.device<beckhoff::el2008<ipc_manager_client_mock>>(outputs); }));
+    expect(ut::nothrow([&] { std::ignore = simulated.device<atv320::device<ipc_manager_client_mock>>(drive); }));
+    // the drive maps its process data over SDO during setup
+    expect(line.bus.sdo_writes(drive) > 0);
+  };
+
+  "inputs of a slave reach its device"_test = [] {
+    test_line line{};
+    auto const slave{ line.bus.add(models::el1008{}) };
+    simulation::context<ipc_manager_client_mock> simulated{ line.connection, line.client, line.bus };
+    line.bus.model<models::el1008>(slave).set_inputs(0xa5);
+    line.cycles(simulated, 1);
+    auto const& device{ simulated.device<beckhoff::el1008<ipc_manager_client_mock>>(slave) };
+    expect(device.packed_transmitter()->value() == std::optional<std::uint64_t>{ 0xa5 });
+    expect(device.transmitters()[0]->value() == std::optional{ true });
+    expect(device.transmitters()[1]->value() == std::optional{ false });
+  };
+
+  "outputs of a device reach its slave"_test = [] {
+    test_line line{};
+    line.bus.add(models::el1008{});
+    auto const slave{ line.bus.add(models::el2008{}) };
+    simulation::context<ipc_manager_client_mock> simulated{ line.connection, line.client, line.bus };
+    simulated.device<beckhoff::el2008<ipc_manager_client_mock>>(slave).set_outputs(0x81);
+    // the device writes its outputs after the exchange, the slave reads them on the next one
+    line.cycles(simulated, 2);
+    expect(line.bus.model<models::el2008>(slave).outputs() == 0x81);
+  };
+
+  "drive is switched on and reset from faults it may reset"_test = [] {
+    test_line line{};
+    auto const slave{ line.bus.add(models::atv320{}) };
+    simulation::context<ipc_manager_client_mock> simulated{ line.connection, line.client, line.bus };
+    auto& drive{ line.bus.model<models::atv320>(slave) };
+    line.cycles(simulated, 5);
+    expect(drive.state() == states_e::switched_on);
+
+    drive.set_fault(atv320::lft_e::cnf);
+    line.cycles(simulated, 5);
+    expect(drive.state() == states_e::switched_on);
+
+    drive.set_fault(atv320::lft_e::cff);
+    line.cycles(simulated, 5);
+    expect(drive.state() == states_e::fault);
+  };
+
+  "lost slave drops out of the working counter and its device keeps going"_test = [] {
+    test_line line{};
+    auto const inputs{ line.bus.add(models::el1008{}) };
+    line.bus.add(models::el2008{});
+    simulation::context<ipc_manager_client_mock> simulated{ line.connection, line.client, line.bus };
+    line.bus.model<models::el1008>(inputs).set_inputs(0x0f);
+    expect(simulated.processdata() == simulated.expected_wkc());
+    line.bus.set_lost(inputs, true);
+    line.bus.model<models::el1008>(inputs).set_inputs(0xf0);
+    expect(simulated.processdata() == simulated.expected_wkc() - 1);
+    auto const& device{ simulated.device<beckhoff::el1008<ipc_manager_client_mock>>(inputs) };
+    expect(device.packed_transmitter()->value() == std::optional<std::uint64_t>{ 0x0f });
+  };
+
+  return 0;
+}
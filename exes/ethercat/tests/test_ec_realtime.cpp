@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include <boost/ut.hpp>
+#include <tfc/ec/realtime.hpp>
+#include <tfc/progbase.hpp>
+
+namespace ut = boost::ut;
+namespace rt = tfc::ec::rt;
+
+auto main(int argc, const char* argv[]) -> int {
+  ut::detail::cfg::parse(argc, argv);
+  std::array<const char*, 1> arguments{ "test_ec_realtime" };
+  tfc::base::init(1, arguments.data());
+
+  using ut::operator""_test;
+  using ut::operator>>;
+  using ut::expect;
+  using ut::fatal;
+
+  "triple buffer has nothing to fetch before publish"_test = [] {
+    rt::triple_buffer<int> buffer;
+    expect(!buffer.fetch());
+  };
+
+  "triple buffer hands over the latest published value"_test = [] {
+    rt::triple_buffer<int> buffer;
+    buffer.write_buffer() = 1;
+    buffer.publish();
+    buffer.write_buffer() = 2;
+    buffer.publish();
+    expect(buffer.fetch() >> fatal);
+    expect(buffer.read_buffer() == 2);
+    expect(!buffer.fetch());
+    expect(buffer.read_buffer() == 2);
+    buffer.write_buffer() = 3;
+    buffer.publish();
+    expect(buffer.fetch() >> fatal);
+    expect(buffer.read_buffer() == 3);
+  };
+
+  "triple buffer never hands out a torn value"_test = [] {
+    struct value {
+      std::array<std::uint64_t, 64> words{};
+    };
+    rt::triple_buffer<value> buffer;
+    std::atomic<bool> done{ false };
+    std::jthread producer{ [&] {
+      for (std::uint64_t count = 1; count < 100'000; count++) {
+        buffer.write_buffer().words.fill(count);
+        buffer.publish();
+      }
+      done = true;
+    } };
+    std::uint64_t last{ 0 };
+    bool consistent{ true };
+    while (!done) {
+      if (buffer.fetch()) {
+        auto const& words{ buffer.read_buffer().words };
+        consistent = consistent && std::ranges::all_of(words, [&](auto word) { return word == words.front(); });
+        consistent = consistent && words.front() > last;
+        last = words.front();
+      }
+    }
+    expect(consistent);
+  };
+
+  // Tests run without privileges, so leave the scheduler and memory as is
+  static constexpr tfc::ec::config::realtime config{
+    .enabled = true, .priority = std::nullopt, .cpu = std::nullopt, .lock_memory = false
+  };
+
+  "cycle thread invokes the cycle periodically"_test = [] {
+    std::atomic<std::uint64_t> count{ 0 };
+    rt::cycle_thread thread{ config, std::chrono::milliseconds{ 1 }, [&count] { count++; } };
+    std::this_thread::sleep_for(std::chrono::milliseconds{ 50 });
+    thread.stop();
+    expect(count > 10) << "count: " << count.load();
+    expect(count.load() == thread.cycles());
+  };
+
+  "cycle thread counts overruns"_test = [] {
+    rt::cycle_thread thread{ config, std::chrono::milliseconds{ 1 },
+                             [] { std::this_thread::sleep_for(std::chrono::milliseconds{ 3 }); } };
+    std::this_thread::sleep_for(std::chrono::milliseconds{ 30 });
+    thread.stop();
+    expect(thread.overruns() > 0);
+    expect(thread.overruns() <= thread.cycles());
+  };
+
+  return 0;
+}
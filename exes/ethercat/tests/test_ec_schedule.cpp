@@ -0,0 +1,79 @@
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/ut.hpp>
+#include <tfc/ec/schedule.hpp>
+
+namespace ut = boost::ut;
+using tfc::ec::group_schedule;
+
+auto main(int argc, const char* argv[]) -> int {
+  ut::detail::cfg::parse(argc, argv);
+
+  using ut::operator""_test;
+  using ut::expect;
+  using ut::throws;
+  using std::chrono::microseconds;
+  using std::chrono::milliseconds;
+  using std::chrono::nanoseconds;
+
+  "a single group is due every tick"_test = [] {
+    std::array<nanoseconds, 1> const periods{ milliseconds{ 2 } };
+    group_schedule const schedule{ periods };
+    expect(schedule.tick() == milliseconds{ 2 });
+    expect(schedule.all() == 1U);
+    for (std::uint64_t tick = 0; tick < 10; tick++) {
+      expect(schedule.due(tick) == 1U);
+    }
+  };
+
+  "ticks at the greatest common divisor of the periods"_test = [] {
+    std::array<nanoseconds, 3> const periods{ milliseconds{ 1 }, microseconds{ 250 }, milliseconds{ 10 } };
+    group_schedule const schedule{ periods };
+    expect(schedule.tick() == microseconds{ 250 });
+    expect(schedule.divider(0) == 4U);
+    expect(schedule.divider(1) == 1U);
+    expect(schedule.divider(2) == 40U);
+    expect(schedule.all() == 0b111U);
+  };
+
+  "each group runs at its own period"_test = [] {
+    std::array<nanoseconds, 3> const periods{ milliseconds{ 1 }, microseconds{ 250 }, milliseconds{ 10 } };
+    group_schedule const schedule{ periods };
+    std::array<std::uint64_t, 3> runs{};
+    for (std::uint64_t tick = 0; tick < 400; tick++) {
+      auto const due{ schedule.due(tick) };
+      for (std::size_t idx = 0; idx < runs.size(); idx++) {
+        runs[idx] += due >> idx & 1U;
+      }
+    }
+    expect(runs[0] == 100U);
+    expect(runs[1] == 400U);
+    expect(runs[2] == 10U);
+  };
+
+  "groups of the same period are spread over the ticks"_test = [] {
+    std::array<nanoseconds, 4> const periods{ milliseconds{ 4 }, milliseconds{ 4 }, milliseconds{ 4 }, milliseconds{ 1 } };
+    group_schedule const schedule{ periods };
+    for (std::uint64_t tick = 0; tick < 16; tick++) {
+      // The 1 ms group and at most one of the slow groups
+      expect(std::popcount(schedule.due(tick)) <= 2);
+      expect((schedule.due(tick) & 0b1000U) != 0U);
+    }
+  };
+
+  "invalid periods throw"_test = [] {
+    expect(throws<std::invalid_argument>([] { group_schedule{ std::span<nanoseconds const>{} }; }));
+    std::array<nanoseconds, 2> const zero{ milliseconds{ 1 }, nanoseconds{ 0 } };
+    expect(throws<std::invalid_argument>([&] { group_schedule{ zero }; }));
+    std::vector<nanoseconds> const too_many(tfc::ec::max_groups + 1, milliseconds{ 1 });
+    expect(throws<std::invalid_argument>([&] { group_schedule{ too_many }; }));
+  };
+
+  return 0;
+}
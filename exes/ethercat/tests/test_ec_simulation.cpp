@@ -0,0 +1,153 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include <boost/ut.hpp>
+#include <tfc/ec/simulation.hpp>
+
+namespace ut = boost::ut;
+namespace simulation = tfc::ec::simulation;
+namespace models = tfc::ec::simulation::models;
+namespace cia_402 = tfc::ec::cia_402;
+namespace atv320 = tfc::ec::devices::schneider::atv320;
+
+auto main(int argc, const char* argv[]) -> int {
+  ut::detail::cfg::parse(argc, argv);
+
+  using ut::operator""_test;
+  using ut::operator>>;
+  using ut::expect;
+  using ut::fatal;
+  using ut::throws;
+  using cia_402::states_e;
+
+  "io map holds every output followed by every input"_test = [] {
+    simulation::bus bus;
+    auto const inputs{ bus.add(models::el1809{}) };
+    auto const outputs{ bus.add(models::el2008{}) };
+    auto const drive{ bus.add(models::atv320{}) };
+    std::array<std::byte, 64> io{};
+    expect(bus.map(io) == 2 + 1 + 10 + 12);
+    expect(bus.layout(outputs).output_offset == 0);
+    expect(bus.layout(outputs).output_size == 1);
+    expect(bus.layout(drive).output_offset == 1);
+    expect(bus.layout(inputs).input_offset == 11);
+    expect(bus.layout(inputs).input_size == 2);
+    expect(bus.layout(drive).input_offset == 13);
+    expect(bus.layout(outputs).input_size == 0);
+  };
+
+  "io map too small throws"_test = [] {
+    simulation::bus bus;
+    bus.add(models::atv320{});
+    std::array<std::byte, 8> io{};
+    expect(throws<std::length_error>([&] { bus.map(io); }));
+  };
+
+  "working counter counts like a logical read write frame"_test = [] {
+    simulation::bus bus;
+    bus.add(models::el1008{});
+    auto const outputs{ bus.add(models::el2008{}) };
+    bus.add(models::atv320{});
+    std::array<std::byte, 64> io{};
+    bus.map(io);
+    expect(bus.expected_wkc() == 1 + 2 + 3);
+    expect(bus.exchange() == bus.expected_wkc());
+    bus.set_lost(outputs, true);
+    expect(bus.exchange() == 4);
+  };
+
+  "lost slave leaves its inputs as they were"_test = [] {
+    simulation::bus bus;
+    auto const slave{ bus.add(models::el1008{}) };
+    std::array<std::byte, 8> io{};
+    bus.map(io);
+    bus.model<models::el1008>(slave).set_inputs(0xa5);
+    bus.exchange();
+    expect(io[0] == std::byte{ 0xa5 });
+    bus.set_lost(slave, true);
+    bus.model<models::el1008>(slave).set_inputs(0x5a);
+    bus.exchange();
+    expect(io[0] == std::byte{ 0xa5 });
+    expect(bus.sdo_write(slave, {}, false, {}, {}) == 0);
+  };
+
+  "digital inputs count up"_test = [] {
+    simulation::bus bus;
+    auto const slave{ bus.add(models::el1008{ 2 }) };
+    std::array<std::byte, 8> io{};
+    bus.map(io);
+    for (int cycle = 0; cycle < 6; cycle++) {
+      bus.exchange();
+    }
+    expect(io[0] == std::byte{ 3 });
+    bus.model<models::el1008>(slave).set_inputs(0x1ff);
+    expect(bus.model<models::el1008>(slave).inputs() == 0xff);
+  };
+
+  "digital outputs keep the outputs of the last exchange"_test = [] {
+    simulation::bus bus;
+    auto const slave{ bus.add(models::el2809{}) };
+    std::array<std::byte, 8> io{};
+    bus.map(io);
+    io[0] = std::byte{ 0x01 };
+    io[1] = std::byte{ 0x80 };
+    bus.exchange();
+    expect(bus.model<models::el2809>(slave).outputs() == 0x8001);
+  };
+
+  "atv320 walks the CiA 402 state machine"_test = [] {
+    simulation::bus bus;
+    auto const slave{ bus.add(models::atv320{}) };
+    std::array<std::byte, 64> io{};
+    bus.map(io);
+    auto const& layout{ bus.layout(slave) };
+    auto const command{ [&](cia_402::control_word control, std::int16_t frequency) {
+      atv320::output_t output{ .control = control, .frequency = frequency * atv320::decifrequency_signed::reference };
+      std::memcpy(io.data() + layout.output_offset, &output, sizeof(output));
+      bus.exchange();
+      atv320::input_t input{};
+      std::memcpy(&input, io.data() + layout.input_offset, sizeof(input));
+      return input;
+    } };
+    expect(command(cia_402::commands::shutdown(), 0).status_word.parse_state() == states_e::ready_to_switch_on);
+    expect(command(cia_402::commands::switch_on(), 0).status_word.parse_state() == states_e::switched_on);
+    auto const running{ command(cia_402::commands::enable_operation(), 250) };
+    expect(running.status_word.parse_state() == states_e::operation_enabled);
+    expect(running.frequency == 250 * atv320::decifrequency_signed::reference);
+    expect(running.drive_state == atv320::hmis_e::run);
+
+    bus.model<models::atv320>(slave).set_fault(atv320::lft_e::cff);
+    auto const faulted{ command(cia_402::commands::enable_operation(), 250) };
+    expect(faulted.status_word.parse_state() == states_e::fault);
+    expect(faulted.last_error == atv320::lft_e::cff);
+    expect(faulted.frequency == 0 * atv320::decifrequency_signed::reference);
+    expect(command(cia_402::commands::fault_reset(), 0).status_word.parse_state() ==
+           states_e::switch_on_disabled);
+  };
+
+  "e4x60a reports its signals within the noise"_test = [] {
+    simulation::bus bus;
+    auto const slave{ bus.add(models::e4x60a{ 10 }) };
+    std::array<std::byte, 64> io{};
+    bus.map(io);
+    bus.model<models::e4x60a>(slave).set_signals({ 1000, 2000, 3000, 4000 });
+    bus.model<models::e4x60a>(slave).set_broken(2, true);
+    auto const& layout{ bus.layout(slave) };
+    for (int cycle = 0; cycle < 100; cycle++) {
+      bus.exchange();
+      models::e4x60a::input_t input{};
+      std::memcpy(&input, io.data() + layout.input_offset, sizeof(input));
+      expect((input.nr_of_inputs == 4) >> fatal);
+      expect(input.status.broken(2) && !input.status.broken(0));
+      for (std::size_t idx = 0; idx < 4; idx++) {
+        auto const deviation{ input.weight_signals[idx] - static_cast<std::int32_t>((idx + 1) * 1000) };
+        expect(deviation >= -10 && deviation <= 10);
+      }
+    }
+  };
+
+  return 0;
+}
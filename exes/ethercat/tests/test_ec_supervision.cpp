@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include <boost/ut.hpp>
+#include <tfc/ec/supervision.hpp>
+
+namespace ut = boost::ut;
+namespace supervision = tfc::ec::supervision;
+
+auto main(int argc, const char* argv[]) -> int {
+  ut::detail::cfg::parse(argc, argv);
+
+  using ut::operator""_test;
+  using ut::operator>>;
+  using ut::expect;
+  using ut::fatal;
+
+  "seqlock load returns the stored value"_test = [] {
+    supervision::seqlock<supervision::bus_health<4>> health;
+    expect(health.sequence() == 0);
+    supervision::bus_health<4> value{};
+    value.slaves[2] = { .state = 8, .al_status_code = 0x1b, .lost = true };
+    health.store(value);
+    auto const loaded{ health.load() };
+    expect(loaded.slaves[2].state == 8);
+    expect(loaded.slaves[2].al_status_code == 0x1b);
+    expect(loaded.slaves[2].lost);
+    expect(!loaded.slaves[1].lost);
+  };
+
+  "seqlock load if changed"_test = [] {
+    supervision::seqlock<std::uint32_t> counter;
+    std::uint32_t value{ 0 };
+    std::uint64_t sequence{ 0 };
+    expect(!counter.load_if_changed(value, sequence));
+    counter.store(42);
+    expect(counter.load_if_changed(value, sequence) >> fatal);
+    expect(value == 42);
+    expect(!counter.load_if_changed(value, sequence));
+  };
+
+  "seqlock never hands out a torn value"_test = [] {
+    supervision::seqlock<std::array<std::uint32_t, 33>> words;
+    std::atomic<bool> done{ false };
+    std::jthread writer{ [&] {
+      std::array<std::uint32_t, 33> value{};
+      for (std::uint32_t count = 1; count < 100'000; count++) {
+        value.fill(count);
+        words.store(value);
+      }
+      done = true;
+    } };
+    bool consistent{ true };
+    while (!done) {
+      auto const value{ words.load() };
+      consistent = consistent && std::ranges::all_of(value, [&](auto word) { return word == value.front(); });
+    }
+    expect(consistent);
+  };
+
+  "trigger wakes a waiting thread"_test = [] {
+    supervision::trigger trigger;
+    std::atomic<int> wakeups{ 0 };
+    std::jthread waiter{ [&] {
+      trigger.wait();
+      wakeups++;
+    } };
+    std::this_thread::sleep_for(std::chrono::milliseconds{ 5 });
+    expect(wakeups == 0);
+    trigger.request();
+    waiter.join();
+    expect(wakeups == 1);
+  };
+
+  "trigger merges pending requests"_test = [] {
+    supervision::trigger trigger;
+    trigger.request();
+    trigger.request();
+    trigger.wait();  // consumes both requests, would block if they were queued separately
+    trigger.request();
+    trigger.wait();
+  };
+
+  return 0;
+}
@@ -0,0 +1,74 @@
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include <boost/ut.hpp>
+#include <tfc/ec/telemetry.hpp>
+
+namespace ut = boost::ut;
+namespace telemetry = tfc::ec::telemetry;
+using telemetry::histogram;
+
+auto main(int argc, const char* argv[]) -> int {
+  ut::detail::cfg::parse(argc, argv);
+
+  using ut::operator""_test;
+  using ut::operator>>;
+  using ut::expect;
+  using ut::fatal;
+  using std::chrono::microseconds;
+  using std::chrono::milliseconds;
+  using std::chrono::nanoseconds;
+
+  "histogram buckets are within the relative error"_test = [] {
+    for (std::uint64_t value = 0; value < 1'000'000; value += 7) {
+      auto const bucket{ histogram::bucket_of(value) };
+      auto const upper{ histogram::upper_bound_of(bucket) };
+      expect((upper >= value) >> fatal) << value;
+      expect(((upper - value) * histogram::sub_bucket_count <= value) >> fatal) << value;
+      if (bucket > 0) {
+        expect((histogram::upper_bound_of(bucket - 1) < value) >> fatal) << value;
+      }
+    }
+  };
+
+  "histogram percentiles"_test = [] {
+    histogram values;
+    for (int count = 1; count <= 1000; count++) {
+      values.record(microseconds{ count });
+    }
+    auto const snapshot{ values.take_snapshot() };
+    expect(snapshot.count == 1000);
+    expect(snapshot.mean() == nanoseconds{ 500'500 });
+    auto const median{ snapshot.value_at(0.5) };
+    expect(median >= microseconds{ 500 } && median <= microseconds{ 500 } * 17 / 16);
+    auto const max{ snapshot.value_at(1.0) };
+    expect(max >= microseconds{ 1000 } && max <= microseconds{ 1000 } * 17 / 16);
+    expect(histogram::snapshot{}.value_at(0.5) == nanoseconds{ 0 });
+  };
+
+  "histogram snapshots report an interval"_test = [] {
+    histogram values;
+    values.record(microseconds{ 100 });
+    auto const first{ values.take_snapshot() };
+    values.record(milliseconds{ 5 });
+    values.record(milliseconds{ 5 });
+    auto const interval{ values.take_snapshot() - first };
+    expect(interval.count == 2);
+    expect(interval.mean() == milliseconds{ 5 });
+    expect(interval.value_at(0.0) >= milliseconds{ 5 });
+  };
+
+  "summarize"_test = [] {
+    histogram values;
+    values.record(microseconds{ 10 });
+    std::vector<double> const quantiles{ 0.5, 0.99 };
+    auto const result{ telemetry::summarize(values.take_snapshot(), quantiles) };
+    expect(result.count == 1);
+    expect((result.percentiles.size() == 2) >> fatal);
+    expect(result.percentiles[1].quantile == 0.99);
+    expect(result.percentiles[1].value == result.max);
+  };
+
+  return 0;
+}
@@ -0,0 +1,100 @@
+#include <chrono>
+#include <cstdint>
+
+#include <boost/ut.hpp>
+#include <tfc/ec/devices/eilersen/weighing.hpp>
+
+namespace ut = boost::ut;
+namespace weighing = tfc::ec::devices::eilersen::weighing;
+
+auto main(int argc, const char* argv[]) -> int {
+  ut::detail::cfg::parse(argc, argv);
+
+  using ut::operator""_test;
+  using ut::expect;
+  using weighing::filter_e;
+  using std::chrono::milliseconds;
+  using time_point = std::chrono::steady_clock::time_point;
+
+  "unfiltered by default"_test = [] {
+    weighing::signal_filter filter{};
+    expect(filter.push(1000) == 1000);
+    expect(filter.converged());
+    expect(filter.push(100'000) == 100'000);
+  };
+
+  "median rejects spikes once converged"_test = [] {
+    weighing::signal_filter filter{};
+    filter.configure({ .type = filter_e::median, .window = 8 });
+    for (std::size_t idx = 0; idx < 8; idx++) {
+      expect(!filter.converged());
+      filter.push(1000);
+    }
+    expect(filter.converged());
+    expect(filter.push(100'000) == 1000);
+    expect(filter.push(-50'000) == 1000);
+  };
+
+  "moving average over the window"_test = [] {
+    weighing::signal_filter filter{};
+    filter.configure({ .type = filter_e::fir, .window = 4 });
+    expect(filter.push(4) == 4);
+    expect(filter.push(8) == 6);
+    filter.push(0);
+    expect(filter.push(0) == 3);
+    expect(filter.converged());
+    // the first sample drops out of the window
+    expect(filter.push(4) == 3);
+  };
+
+  "exponential moving average keeps fractions"_test = [] {
+    weighing::signal_filter filter{};
+    filter.configure({ .type = filter_e::ema, .ema_shift = 2 });
+    expect(filter.push(1000) == 1000);
+    expect(filter.push(2000) == 1250);
+    for (std::size_t idx = 0; idx < 200; idx++) {
+      filter.push(2000);
+    }
+    expect(filter.push(2000) == 2000);
+  };
+
+  "reset starts over"_test = [] {
+    weighing::signal_filter filter{};
+    filter.configure({ .type = filter_e::fir, .window = 4 });
+    for (std::size_t idx = 0; idx < 4; idx++) {
+      filter.push(100);
+    }
+    filter.reset();
+    expect(!filter.converged());
+    expect(filter.push(10) == 10);
+  };
+
+  "same configuration keeps the filter state"_test = [] {
+    weighing::signal_filter filter{};
+    weighing::filter_config const config{ .type = filter_e::fir, .window = 2 };
+    filter.configure(config);
+    filter.push(10);
+    filter.push(10);
+    filter.configure(config);
+    expect(filter.converged());
+    filter.configure({ .type = filter_e::fir, .window = 3 });
+    expect(!filter.converged());
+  };
+
+  "stable after staying within the band for the settle time"_test = [] {
+    using weighing::mass_t;
+    weighing::stability_detector<mass_t> detector{};
+    detector.configure(5 * mass_t::reference, milliseconds{ 300 });
+    time_point const start{};
+    expect(!detector.push(100 * mass_t::reference, start));
+    expect(!detector.push(104 * mass_t::reference, start + milliseconds{ 200 }));
+    expect(detector.push(96 * mass_t::reference, start + milliseconds{ 300 }));
+    // motion starts the settle time over
+    expect(!detector.push(110 * mass_t::reference, start + milliseconds{ 310 }));
+    expect(detector.push(110 * mass_t::reference, start + milliseconds{ 610 }));
+    detector.reset();
+    expect(!detector.push(110 * mass_t::reference, start + milliseconds{ 620 }));
+  };
+
+  return 0;
+}
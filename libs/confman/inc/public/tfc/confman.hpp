@@ -3,6 +3,7 @@
 #include <filesystem>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <system_error>
@@ -13,7 +14,9 @@
 
 #include <tfc/confman/detail/change.hpp>
 #include <tfc/confman/detail/config_dbus_client.hpp>
+#include <tfc/confman/detail/patch.hpp>
 #include <tfc/confman/file_storage.hpp>
+#include <tfc/confman/observable.hpp>
 #include <tfc/dbus/sdbusplus_fwd.hpp>
 #include <tfc/dbus/string_maker.hpp>
 #include <tfc/progbase.hpp>
@@ -54,8 +57,12 @@ public:
   template <typename storage_type>
     requires std::same_as<storage_t, std::remove_cvref_t<storage_type>>
   config(std::shared_ptr<sdbusplus::asio::connection> conn, std::string_view key, storage_type&& def)
-      : client_{ conn, key, std::bind_front(&config::string, this), std::bind_front(&config::schema, this),
-                 std::bind_front(&config::from_string, this) },
+      : client_{ conn,
+                 key,
+                 std::bind_front(&config::string, this),
+                 std::bind_front(&config::schema, this),
+                 std::bind_front(&config::from_string, this),
+                 std::bind_front(&config::patch, this) },
         storage_{ client_.get_io_context(), tfc::base::make_config_file_name(key, "json"), std::forward<storage_type>(def) },
         logger_(fmt::format("config.{}", key)) {
     init();
@@ -79,8 +86,16 @@ public:
   auto operator->() const noexcept -> storage_t const* { return std::addressof(value()); }
 
   /// \return storage_t as json string
+  /// \note the string is kept until the value changes
   [[nodiscard]] auto string() const -> std::expected<std::string, glz::error_ctx> {
-    return glz::write_json(storage_.value());
+    if (string_cache_.has_value()) {
+      return string_cache_.value();
+    }
+    auto value{ glz::write_json(storage_.value()) };
+    if (value.has_value()) {
+      string_cache_ = value.value();
+    }
+    return value;
   }
 
   /// TODO can we do this differently, jsonforms requires object as root element
@@ -97,15 +112,20 @@ public:
 
   /// \return storage_t json schema
   [[nodiscard]] auto schema() const -> std::string {
+    if (schema_cache_.has_value()) {
+      return schema_cache_.value();
+    }
     auto const value{ tfc::json::write_json_schema<object_wrapper<config_storage_t>>() };
     if (!value.has_value()) {
       logger_.error("Error writing json schema: {}", glz::format_error(value.error()));
       return {};
     }
+    schema_cache_ = value.value();
     return value.value();
   }
 
   auto set_changed() const noexcept -> std::error_code {
+    string_cache_.reset();
     auto value{ this->string() };
     if (!value.has_value()) {
       logger_.error("Error writing string: {}", glz::format_error(value.error()));
@@ -122,14 +142,52 @@ public:
 
   auto make_change() noexcept -> change { return change{ *this }; }
 
+  /// \brief replace the value by the given JSON, observers of the changed values are notified and the value is stored
+  /// \return error if the JSON cannot be read, the value is then left unchanged
   auto from_string(std::string_view value) -> std::error_code {
-    // this will call N nr of callbacks
-    // for each confman::observer type
+    // the JSON is read into a scratch value first so a failed read does not leave the value partially changed,
+    // default constructed rather than copied as copies of observables carry their observers along
+    storage_t scratch{};
+    if (auto const error{ glz::read_json<storage_t>(scratch, value) }; error) {
+      logger_.error("Error reading json: {}", glz::format_error(error, value));
+      return std::make_error_code(std::errc::io_error);  // todo make glz to std::error_code
+    }
+    string_cache_.reset();
+    // observers of every changed confman::observable are notified once the whole value has been read
+    notification_batch const batch{};
     auto const error{ glz::read_json<storage_t>(storage_.make_change().value(), value) };
     if (error) {
       logger_.error("Error reading json: {}", glz::format_error(error, value));
-      return std::make_error_code(std::errc::io_error);  // todo make glz to std::error_code
+      return std::make_error_code(std::errc::io_error);
+    }
+    return {};
+  }
+
+  /// \brief change part of the value by a JSON patch (RFC 6902) or a JSON merge patch (RFC 7386)
+  /// Observers of the changed values are notified and the paths of the changes are signalled on dbus.
+  /// \return error if the patch is malformed or cannot be applied, the value is then left unchanged
+  auto patch(std::string_view value) -> std::error_code {
+    auto const current{ string() };
+    if (!current.has_value()) {
+      logger_.error("Error writing string: {}", glz::format_error(current.error()));
+      return std::make_error_code(std::errc::io_error);
+    }
+    auto patched{ detail::apply_patch(current.value(), value) };
+    if (!patched.has_value()) {
+      logger_.warn("Error applying patch: {}, what: {}", value, patched.error().message());
+      return patched.error();
+    }
+    if (auto const error{ from_string(patched->document) }; error) {
+      return error;
+    }
+    // from_string has stored the value, only the dbus property is left to update
+    auto updated{ string() };
+    if (!updated.has_value()) {
+      logger_.error("Error writing string: {}", glz::format_error(updated.error()));
+      return std::make_error_code(std::errc::io_error);
     }
+    client_.set(std::move(updated.value()));
+    client_.notify_changed(patched->paths);
     return {};
   }
 
@@ -146,6 +204,8 @@ protected:
   config_dbus_client_t client_;
   file_storage_t storage_{};
   tfc::logger::logger logger_;
+  mutable std::optional<std::string> string_cache_{};
+  mutable std::optional<std::string> schema_cache_{};
 };
 
 }  // namespace tfc::confman
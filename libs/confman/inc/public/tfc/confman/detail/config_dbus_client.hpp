@@ -4,8 +4,10 @@
 #include <filesystem>
 #include <functional>
 #include <memory>
+#include <string>
 #include <string_view>
 #include <system_error>
+#include <vector>
 
 #include <glaze/core/context.hpp>
 
@@ -23,6 +25,8 @@ namespace asio = boost::asio;
 namespace dbus {
 static constexpr std::string_view property_value_name{ "Value" };
 static constexpr std::string_view property_schema_name{ "Schema" };
+static constexpr std::string_view method_patch_name{ "Patch" };
+static constexpr std::string_view signal_changed_name{ "Changed" };
 static constexpr std::string_view intent_name{ "Config" };
 static constexpr std::string_view interface {
   tfc::dbus::const_dbus_name<intent_name>
@@ -41,12 +45,22 @@ public:
   using value_call_t = std::function<std::expected<std::string, glz::error_ctx>()>;
   using schema_call_t = std::function<std::string()>;
   using change_call_t = std::function<std::error_code(std::string_view)>;
+  using patch_call_t = std::function<std::error_code(std::string_view)>;
   /// \brief make dbus client using given dbus connection
   /// Create a property named `config` using the given `key` to make interface name
-  config_dbus_client(dbus_connection_t conn, std::string_view key, value_call_t&&, schema_call_t&&, change_call_t&&);
+  /// and a method `Patch` taking a JSON patch or JSON merge patch of the value
+  config_dbus_client(dbus_connection_t conn,
+                     std::string_view key,
+                     value_call_t&&,
+                     schema_call_t&&,
+                     change_call_t&&,
+                     patch_call_t&&);
 
   void set(std::string&&) const;
 
+  /// \brief emit signal `Changed` with JSON pointers to the values which have changed
+  void notify_changed(std::vector<std::string> const& paths) const;
+
   void initialize();
 
   [[nodiscard]] auto get_io_context() const noexcept -> asio::io_context&;
@@ -56,9 +70,12 @@ private:
   std::string const interface_name_{ dbus::interface };
   std::string const value_property_name_{ dbus::property_value_name };
   std::string const schema_property_name_{ dbus::property_schema_name };
+  std::string const patch_method_name_{ dbus::method_patch_name };
+  std::string const changed_signal_name_{ dbus::signal_changed_name };
   value_call_t value_call_{};
   schema_call_t schema_call_{};
   change_call_t change_call_{};
+  patch_call_t patch_call_{};
   dbus_connection_t dbus_connection_{};
   std::shared_ptr<sdbusplus::asio::dbus_interface> dbus_interface_{};
 };
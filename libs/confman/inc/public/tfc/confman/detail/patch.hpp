@@ -0,0 +1,23 @@
+#pragma once
+
+#include <expected>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace tfc::confman::detail {
+
+struct patched {
+  std::string document{};
+  /// JSON pointers (RFC 6901) to the values changed by the patch, in the order they were changed
+  std::vector<std::string> paths{};
+};
+
+/// \brief apply patch to a json document
+/// A json array is a JSON patch (RFC 6902), anything else a JSON merge patch (RFC 7386).
+/// Numbers are written exactly as they were read, integers beyond the precision of a double included.
+/// \return the patched document, or the error of the patch in which case nothing has been changed
+auto apply_patch(std::string_view document, std::string_view patch) -> std::expected<patched, std::error_code>;
+
+}  // namespace tfc::confman::detail
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <filesystem>
+#include <map>
+#include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <system_error>
@@ -8,6 +13,7 @@
 #include <fmt/format.h>
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/posix/stream_descriptor.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <glaze/glaze.hpp>
 
 #include <tfc/confman/detail/change.hpp>
@@ -16,17 +22,65 @@
 namespace tfc::confman {
 
 auto write_to_file(const std::filesystem::path& file_path, std::string_view file_contents) -> std::error_code;
-auto write_and_apply_retention_policy(std::string_view file_content, std::filesystem::path const& file_path)
-    -> std::error_code;
+
+/// \brief fetch value of "TFC_CONFMAN_WRITE_DEBOUNCE_MS", changes within this time are written to disc together,
+/// default 100 ms
+auto write_debounce() -> std::chrono::milliseconds;
 
 namespace asio = boost::asio;
 
+/// \brief opt in to a binary snapshot of storage_t kept next to its json file, see file_storage
+/// storage_t and all of its members need to be readable and writable as glaze BEVE. Types which only have custom json
+/// specializations are not, std::chrono::duration is made writable in tfc/stx/glaze_meta.hpp.
+/// \example template <> inline constexpr bool tfc::confman::binary_snapshot<my_config>{ true };
+template <typename storage_t>
+inline constexpr bool binary_snapshot{ false };
+
+namespace detail {
+/// \brief Backups of a configuration file and their retention.
+/// The directory is scanned for backups of previous runs on the first write, afterwards the history is kept in memory.
+/// \note only used from the writer thread
+class backup_history {
+public:
+  explicit backup_history(std::filesystem::path config_file);
+
+  /// \brief write a backup and delete the oldest ones exceeding the retention policy
+  auto write(std::string_view file_content) -> std::error_code;
+
+  [[nodiscard]] auto file() const noexcept -> std::filesystem::path const& { return config_file_; }
+
+private:
+  void apply_retention_policy();
+
+  std::filesystem::path config_file_;
+  std::optional<std::map<std::filesystem::file_time_type, std::filesystem::path>> backups_{};
+};
+
+/// Configuration files are written by a single background thread, in the order they are queued.
+void queue_write_file(std::filesystem::path file_path, std::string file_content);
+void queue_backup(std::shared_ptr<backup_history> history, std::string file_content);
+/// \brief block until everything queued so far has been written
+void wait_for_writes();
+
+/// \return hash identifying the json source a snapshot was made from
+auto source_hash(std::string_view source) noexcept -> std::uint64_t;
+/// \return path of the binary snapshot of config_file
+auto snapshot_file(std::filesystem::path const& config_file) -> std::filesystem::path;
+/// \return snapshot file content of payload, made from the json source with hash
+auto make_snapshot(std::uint64_t hash, std::string_view payload) -> std::string;
+/// \return payload of snapshot file content if it was made from the json source with hash, std::nullopt otherwise
+auto snapshot_payload(std::string_view snapshot, std::uint64_t hash) noexcept -> std::optional<std::string_view>;
+}  // namespace detail
+
 /// \tparam storage_t needs to be transposable via glaze https://github.com/stephenberry/glaze
 /// \class file_storage
 /// The file storage class stores any type that can be converted to and from json.
 /// The type is stored on the disc given the file_path as pretty json string.
 /// If the file is changed while program is running the application detects the change and
 /// changes the member value accordingly.
+/// Changes are written to disc in the background, changes within the write_debounce() window are written once.
+/// When binary_snapshot<storage_t> is set a BEVE snapshot is written next to the json file, it is loaded instead of
+/// parsing the json as long as the hash of the json file matches the one the snapshot was made from.
 template <typename storage_t>
 class file_storage {
 public:
@@ -34,25 +88,28 @@ public:
 
   /// \brief Empty constructor
   /// \note Should only be used for testing !!!
-  explicit file_storage(asio::io_context&) : logger_{ "file_storage" } {}
+  explicit file_storage(asio::io_context& ctx) : logger_{ "file_storage" }, debounce_timer_{ ctx } {}
 
   /// \brief Construct file storage with default constructed storage_t
   file_storage(asio::io_context& ctx, std::filesystem::path const& file_path)
       : file_storage{ ctx, file_path, storage_t{} } {}
 
   /// \brief Construct file storage with user defined default values for storage_t
-  file_storage(asio::io_context&, std::filesystem::path const& file_path, auto&& default_value)
+  file_storage(asio::io_context& ctx, std::filesystem::path const& file_path, auto&& default_value)
       : config_file_{ file_path }, storage_{ std::forward<decltype(default_value)>(default_value) },
-        logger_{ fmt::format("file_storage.{}", file_path.string()) } {
+        logger_{ fmt::format("file_storage.{}", file_path.string()) }, debounce_timer_{ ctx },
+        backups_{ std::make_shared<detail::backup_history>(file_path) } {
     std::filesystem::create_directories(config_file_.parent_path());
     error_ = read_file();
     if (error_) {
       // The file does not exist
       if (!std::filesystem::exists(config_file_) || std::filesystem::file_size(config_file_) == 0) {
-        error_ = set_changed();
+        auto json{ to_json() };
+        error_ = write_to_file(config_file_, json);
         if (error_) {
           throw std::runtime_error(fmt::format("Unable to write configuration file to disc {}", config_file_.string()));
         }
+        queue_snapshot(json);
       } else {
         // When unable to parse configuration throw a runtime error. This is a fatal error.
         std::string message =
@@ -63,6 +120,18 @@ public:
     }
   }
 
+  file_storage(file_storage const&) = delete;
+  file_storage(file_storage&&) = delete;
+  auto operator=(file_storage const&) -> file_storage& = delete;
+  auto operator=(file_storage&&) -> file_storage& = delete;
+
+  /// \brief changes not yet on disc are written before returning
+  ~file_storage() {
+    if (backups_) {
+      flush();
+    }
+  }
+
   /// \brief Internal error code
   /// \returns error if something went wrong with filesystem commands
   [[nodiscard]] auto error() const noexcept -> std::error_code const& { return error_; }
@@ -83,22 +152,39 @@ public:
   /// When the helper struct is deconstructed the changes are written to the disc.
   /// \return change helper struct providing reference to this` value.
   auto make_change() noexcept -> change {
-    if (auto write_error{ write_and_apply_retention_policy(to_json(), config_file_) }; write_error) {
-      logger_.warn(R"(Error: "{}" writing to file: "{}")", write_error.message(), config_file_.string());
+    // the file on disc is backed up once for a series of changes written together
+    if (!write_pending_ && backups_) {
+      detail::queue_backup(backups_, to_json());
     }
     return change{ *this };
   }
 
-  /// \brief set_changed writes the current value to disc
-  /// \return error_code if it was unable to write to disc.
+  /// \brief set_changed schedules the current value to be written to disc once the debounce window has passed
+  /// \return error_code of the scheduling, errors writing to disc are logged
   auto set_changed() const noexcept -> std::error_code {
-    if (auto write_error{ write_to_file(config_file_, to_json()) }; write_error) {
-      logger_.warn(R"(Error: "{}" writing to file: "{}")", write_error.message(), config_file_.string());
-      return write_error;
+    if (write_pending_ || !backups_) {
+      return {};
     }
+    write_pending_ = true;
+    debounce_timer_.expires_after(write_debounce());
+    debounce_timer_.async_wait([this, alive = std::weak_ptr{ backups_ }](std::error_code const& err) {
+      if (err || alive.expired() || !write_pending_) {
+        return;
+      }
+      write_pending();
+    });
     return {};
   }
 
+  /// \brief write pending changes now and wait until everything queued for writing is on disc
+  void flush() const noexcept {
+    if (write_pending_) {
+      debounce_timer_.cancel();
+      write_pending();
+    }
+    detail::wait_for_writes();
+  }
+
   /// \brief generate json form of storage
   auto to_json() const noexcept -> std::string {
     std::string buffer{};  // this can throw, meaning memory error
@@ -117,20 +203,76 @@ protected:
   // the change mechanism relies on this (the friend above)
   auto access() noexcept -> storage_t& { return storage_; }
 
+  void write_pending() const {
+    write_pending_ = false;
+    auto json{ to_json() };
+    queue_snapshot(json);
+    detail::queue_write_file(config_file_, std::move(json));
+  }
+
   auto read_file() -> std::error_code {
     std::string buffer{};
-    if (auto glz_err{ glz::read_file_json(storage_, config_file_.string(), buffer) }; glz_err) {
+    if (glz::file_to_buffer(buffer, config_file_.string()) != glz::error_code::none) {
+      logger_.warn(R"(Error: "unable to read file" reading from file: "{}")", config_file_.string());
+      return std::make_error_code(std::errc::io_error);
+    }
+    if (read_snapshot(buffer)) {
+      return {};
+    }
+    if (auto glz_err{ glz::read_json(storage_, buffer) }; glz_err) {
       logger_.warn(R"(Error: "{}" reading from file: "{}")", glz::format_error(glz_err, buffer), config_file_.string());
       return std::make_error_code(std::errc::io_error);
       // todo implicitly convert glaze error_code to std::error_code
     }
+    // the snapshot is missing or was made from a different json, next start will use this one
+    queue_snapshot(buffer);
     return {};
   }
 
+  /// \return true if storage_ was read from a snapshot made from json
+  auto read_snapshot([[maybe_unused]] std::string_view json) -> bool {
+    if constexpr (binary_snapshot<storage_t>) {
+      std::string snapshot{};
+      if (glz::file_to_buffer(snapshot, detail::snapshot_file(config_file_).string()) != glz::error_code::none) {
+        return false;
+      }
+      auto const payload{ detail::snapshot_payload(snapshot, detail::source_hash(json)) };
+      if (!payload) {
+        return false;
+      }
+      // read into a copy, a snapshot which turns out to be corrupt leaves storage_ untouched
+      storage_t value{ storage_ };
+      if (auto glz_err{ glz::read_beve(value, std::string{ payload.value() }) }; glz_err) {
+        logger_.info(R"(Error: "{}" reading snapshot, reading json instead)", glz::format_error(glz_err));
+        return false;
+      }
+      storage_ = std::move(value);
+      return true;
+    } else {
+      return false;
+    }
+  }
+
+  void queue_snapshot([[maybe_unused]] std::string_view json) const {
+    if constexpr (binary_snapshot<storage_t>) {
+      auto payload{ glz::write_beve(storage_) };
+      if (!payload) {
+        logger_.warn(R"(Error: "{}" writing snapshot)", glz::format_error(payload.error()));
+        return;
+      }
+      detail::queue_write_file(detail::snapshot_file(config_file_),
+                               detail::make_snapshot(detail::source_hash(json), payload.value()));
+    }
+  }
+
   std::filesystem::path config_file_{};
   storage_t storage_{};
   tfc::logger::logger logger_;
   std::error_code error_{};
+  mutable asio::steady_timer debounce_timer_;
+  mutable bool write_pending_{};
+  // shared with the writer thread, also tells the debounce timer whether this storage still exists
+  std::shared_ptr<detail::backup_history> backups_{};
 };
 
 }  // namespace tfc::confman
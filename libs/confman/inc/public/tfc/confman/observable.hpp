@@ -1,14 +1,20 @@
 #pragma once
 
+#include <algorithm>
+#include <cmath>
 #include <compare>
 #include <concepts>
+#include <cstddef>
 #include <functional>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <glaze/core/meta.hpp>
 
 #include <tfc/stx/concepts.hpp>
 #include <tfc/stx/string_view_join.hpp>
+#include <tfc/utils/pragmas.hpp>
 
 // Fwd declare this class to give it access to private members
 namespace glz::detail {
@@ -24,9 +30,214 @@ concept observable_type = requires {
   requires std::is_default_constructible_v<conf_param_t>;
   requires std::equality_comparable<conf_param_t>;
   //  requires std::three_way_comparable<conf_param_t>;
-  requires !std::is_floating_point_v<conf_param_t>;  // todo why not
 };
 
+/// \brief defer notifications of observables changed while a batch exists on the current thread
+/// Each observable changed within the outermost batch notifies once when it ends, with the value before its first
+/// change as the former value. Observables changed back to their former value do not notify.
+/// \note observables changed within a batch need to outlive it
+/// \example
+/// {
+///   tfc::confman::notification_batch const batch{};
+///   auto change{ config.make_change() };
+///   change->speed = 10;
+///   change->acceleration = 2;
+/// }  // observers of speed and acceleration are notified here
+class notification_batch {
+public:
+  notification_batch() noexcept { state().depth++; }
+  notification_batch(notification_batch const&) = delete;
+  notification_batch(notification_batch&&) = delete;
+  auto operator=(notification_batch const&) -> notification_batch& = delete;
+  auto operator=(notification_batch&&) -> notification_batch& = delete;
+  ~notification_batch() {
+    if (--state().depth == 0) {
+      // notifications may change other observables, those are notified right away
+      auto pending{ std::move(state().pending) };
+      state().pending.clear();
+      for (auto& [key, notify] : pending) {
+        notify();
+      }
+    }
+  }
+
+  /// \return true if a batch exists on the current thread
+  [[nodiscard]] static auto active() noexcept -> bool { return state().depth > 0; }
+
+  /// \return true if the notification of key is already deferred
+  [[nodiscard]] static auto deferred(void const* key) noexcept -> bool {
+    return std::ranges::find(state().pending, key, &std::pair<void const*, std::function<void()>>::first) !=
+           state().pending.end();
+  }
+
+  /// \brief defer notify until the outermost batch ends
+  static void defer(void const* key, std::function<void()>&& notify) {
+    state().pending.emplace_back(key, std::move(notify));
+  }
+
+private:
+  struct batch_state {
+    std::size_t depth{};
+    std::vector<std::pair<void const*, std::function<void()>>> pending{};
+  };
+  static auto state() noexcept -> batch_state& {
+    thread_local batch_state instance{};
+    return instance;
+  }
+};
+
+namespace detail {
+class subscriber_list;
+
+/// \brief link of an intrusive list of subscribers, unlinks itself when destroyed
+class subscriber_hook {
+public:
+  subscriber_hook() = default;
+  subscriber_hook(subscriber_hook const&) = delete;
+  auto operator=(subscriber_hook const&) -> subscriber_hook& = delete;
+  /// \brief take the place of other in its list
+  subscriber_hook(subscriber_hook&& other) noexcept { take_place_of(other); }
+  auto operator=(subscriber_hook&& other) noexcept -> subscriber_hook& {
+    if (this != &other) {
+      unlink();
+      take_place_of(other);
+    }
+    return *this;
+  }
+  ~subscriber_hook() { unlink(); }
+
+  [[nodiscard]] auto linked() const noexcept -> bool { return list_ != nullptr; }
+
+  inline void unlink() noexcept;
+
+private:
+  friend class subscriber_list;
+  inline void take_place_of(subscriber_hook& other) noexcept;
+
+  subscriber_list* list_{};
+  subscriber_hook* prev_{};
+  subscriber_hook* next_{};
+};
+
+/// \brief intrusive list of subscribers, the subscribers own their links so nothing is allocated
+class subscriber_list {
+public:
+  subscriber_list() = default;
+  // subscriptions belong to the list they were made on, copies and moves start without subscribers
+  subscriber_list(subscriber_list const&) noexcept {}
+  subscriber_list(subscriber_list&&) noexcept {}
+  auto operator=(subscriber_list const&) noexcept -> subscriber_list& { return *this; }
+  auto operator=(subscriber_list&&) noexcept -> subscriber_list& { return *this; }
+  ~subscriber_list() {
+    while (head_ != nullptr) {
+      head_->unlink();
+    }
+  }
+
+  void push_back(subscriber_hook& hook) noexcept {
+    hook.unlink();
+    hook.list_ = this;
+    hook.prev_ = tail_;
+    if (tail_ != nullptr) {
+      tail_->next_ = &hook;
+    } else {
+      head_ = &hook;
+    }
+    tail_ = &hook;
+  }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return head_ == nullptr; }
+
+  /// \brief invoke func for each subscriber in the order they subscribed
+  /// \note func may unlink the subscriber it is invoked with
+  void for_each(std::invocable<subscriber_hook&> auto&& func) {
+    for (auto* hook{ head_ }; hook != nullptr;) {
+      auto* next{ hook->next_ };
+      func(*hook);
+      hook = next;
+    }
+  }
+
+private:
+  friend class subscriber_hook;
+  subscriber_hook* head_{};
+  subscriber_hook* tail_{};
+};
+
+void subscriber_hook::unlink() noexcept {
+  if (list_ == nullptr) {
+    return;
+  }
+  (prev_ != nullptr ? prev_->next_ : list_->head_) = next_;
+  (next_ != nullptr ? next_->prev_ : list_->tail_) = prev_;
+  list_ = nullptr;
+  prev_ = nullptr;
+  next_ = nullptr;
+}
+
+void subscriber_hook::take_place_of(subscriber_hook& other) noexcept {
+  if (other.list_ == nullptr) {
+    return;
+  }
+  list_ = std::exchange(other.list_, nullptr);
+  prev_ = std::exchange(other.prev_, nullptr);
+  next_ = std::exchange(other.next_, nullptr);
+  (prev_ != nullptr ? prev_->next_ : list_->head_) = this;
+  (next_ != nullptr ? next_->prev_ : list_->tail_) = this;
+}
+}  // namespace detail
+
+template <observable_type conf_param_t>
+class observable;
+
+/// \brief subscription to changes of an observable, changes are delivered until it is destroyed
+/// A default constructed subscription, or one whose observable has been destroyed, delivers nothing.
+template <observable_type conf_param_t>
+class [[nodiscard]] subscription : public detail::subscriber_hook {
+public:
+  using callback_t = std::function<void(conf_param_t const& new_value, conf_param_t const& former_value)>;
+
+  subscription() = default;
+
+  /// \return true while changes are delivered
+  [[nodiscard]] auto subscribed() const noexcept -> bool { return linked(); }
+
+private:
+  friend class observable<conf_param_t>;
+
+  struct deadband_state {
+    conf_param_t deadband{};
+    conf_param_t last{};  // value last delivered
+  };
+  struct no_deadband {};
+
+  explicit subscription(callback_t&& callback) : callback_{ std::move(callback) } {}
+  subscription(callback_t&& callback, conf_param_t deadband, conf_param_t last)
+    requires std::floating_point<conf_param_t>
+      : callback_{ std::move(callback) }, deadband_{ .deadband = deadband, .last = last } {}
+
+  void notify(conf_param_t const& new_value, conf_param_t const& former_value) {
+    if constexpr (std::floating_point<conf_param_t>) {
+      // a change below the deadband is delivered once the value has drifted far enough from the one last delivered
+      bool const nan_changed{ std::isnan(new_value) != std::isnan(deadband_.last) };
+      if (!nan_changed && !(std::abs(new_value - deadband_.last) > deadband_.deadband)) {
+        return;
+      }
+      auto const last{ std::exchange(deadband_.last, new_value) };
+      std::invoke(callback_, new_value, last);
+    } else {
+      std::invoke(callback_, new_value, former_value);
+    }
+  }
+
+  callback_t callback_{};
+  [[no_unique_address]] std::conditional_t<std::floating_point<conf_param_t>, deadband_state, no_deadband> deadband_{};
+};
+
+// observables compare their values exactly, floating point values included
+// clang-format off
+PRAGMA_CLANG_WARNING_PUSH_OFF(-Wfloat-equal)
+// clang-format on
 /// \brief observable variable, the user can get notified if it is changed with `set` function
 /// \tparam conf_param_t equality comparable and default constructible type
 template <observable_type conf_param_t>
@@ -96,6 +307,32 @@ public:
     callback_ = std::forward<decltype(callback)>(callback);
   }
 
+  /// \brief subscribe to changes, in addition to the observer and any other subscriptions
+  /// Subscribers are notified in the order they subscribed, after the observer.
+  /// \param callback calling function for all changes, this function cannot throw.
+  /// \return the subscription, subscriptions are not carried over to copies or moves of this observable
+  auto subscribe(stx::nothrow_invocable<conf_param_t const&, conf_param_t const&> auto&& callback) const
+      -> subscription<conf_param_t> {
+    subscription<conf_param_t> result{ typename subscription<conf_param_t>::callback_t{
+        std::forward<decltype(callback)>(callback) } };
+    subscribers_.push_back(result);
+    return result;
+  }
+
+  /// \brief subscribe to changes larger than deadband
+  /// \param callback calling function for changes, its former value is the value last delivered to it
+  /// \param deadband a change is delivered once the value is more than deadband away from the value last delivered
+  auto subscribe(stx::nothrow_invocable<conf_param_t const&, conf_param_t const&> auto&& callback,
+                 conf_param_t deadband) const -> subscription<conf_param_t>
+    requires std::floating_point<conf_param_t>
+  {
+    subscription<conf_param_t> result{
+      typename subscription<conf_param_t>::callback_t{ std::forward<decltype(callback)>(callback) }, deadband, value_
+    };
+    subscribers_.push_back(result);
+    return result;
+  }
+
   /// \brief get the current value
   auto value() const noexcept -> conf_param_t const& { return value_; }
 
@@ -107,13 +344,34 @@ private:
   auto reference() noexcept -> conf_param_t& { return value_; }
 
   void notify(conf_param_t const& old_value) {
+    if (callback_ == nullptr && subscribers_.empty()) {
+      return;
+    }
+    if (notification_batch::active()) {
+      if (!notification_batch::deferred(this)) {
+        notification_batch::defer(this, [this, old_value] {
+          if (value_ != old_value) {
+            notify_now(old_value);
+          }
+        });
+      }
+      return;
+    }
+    notify_now(old_value);
+  }
+
+  void notify_now(conf_param_t const& old_value) {
     if (callback_) {
       std::invoke(callback_, value_, old_value);
     }
+    subscribers_.for_each([this, &old_value](detail::subscriber_hook& hook) {
+      static_cast<subscription<conf_param_t>&>(hook).notify(value_, old_value);
+    });
   }
 
   conf_param_t value_{};
   mutable std::function<void(conf_param_t const&, conf_param_t const&)> callback_{};
+  mutable detail::subscriber_list subscribers_{};
 
 public:
   struct glaze {
@@ -123,6 +381,7 @@ public:
     static std::string_view constexpr name{ stx::string_view_join_v<prefix, glz::name_v<conf_param_t>, postfix> };
   };
 };
+PRAGMA_CLANG_WARNING_POP
 
 template <observable_type conf_param_t>
 observable(conf_param_t&&) -> observable<conf_param_t>;
@@ -134,6 +393,9 @@ observable(conf_param_t&) -> observable<conf_param_t>;
 
 namespace glz::detail {
 
+// clang-format off
+PRAGMA_CLANG_WARNING_PUSH_OFF(-Wfloat-equal)
+// clang-format on
 template <typename value_t>
 struct from_json<tfc::confman::observable<value_t>> {
   template <auto opts>
@@ -146,6 +408,7 @@ struct from_json<tfc::confman::observable<value_t>> {
     }
   }
 };
+PRAGMA_CLANG_WARNING_POP
 }  // namespace glz::detail
 
 namespace tfc::json::detail {
@@ -27,9 +27,11 @@ config_dbus_client::config_dbus_client(dbus_connection_t conn,
                                        std::string_view key,
                                        value_call_t&& value_call,
                                        schema_call_t&& schema_call,
-                                       change_call_t&& change_call)
+                                       change_call_t&& change_call,
+                                       patch_call_t&& patch_call)
     : interface_path_{ tfc::dbus::make_dbus_path(key) }, value_call_{ std::move(value_call) },
-      schema_call_{ std::move(schema_call) }, change_call_{ std::move(change_call) }, dbus_connection_{ std::move(conn) },
+      schema_call_{ std::move(schema_call) }, change_call_{ std::move(change_call) }, patch_call_{ std::move(patch_call) },
+      dbus_connection_{ std::move(conn) },
       dbus_interface_{
         std::make_unique<sdbusplus::asio::dbus_interface>(dbus_connection_, interface_path_.string(), interface_name_)
       } {}
@@ -40,6 +42,14 @@ void config_dbus_client::set(std::string&& prop) const {
   }
 }
 
+void config_dbus_client::notify_changed(std::vector<std::string> const& paths) const {
+  if (dbus_interface_) {
+    auto message{ dbus_interface_->new_signal(changed_signal_name_.c_str()) };
+    message.append(paths);
+    message.signal_send();
+  }
+}
+
 void config_dbus_client::initialize() {
   if (dbus_interface_) {
     dbus_interface_->register_property_rw<std::string>(
@@ -67,6 +77,12 @@ void config_dbus_client::initialize() {
         [this]([[maybe_unused]] std::string const& value) -> std::string {  // getter
           return this->schema_call_();
         });
+    dbus_interface_->register_method(patch_method_name_, [this](std::string const& patch) -> void {
+      if (auto err{ this->patch_call_(patch) }; err) {
+        throw tfc::dbus::exception::runtime{ fmt::format("Unable to apply patch: '{}', what: '{}'", patch, err.message()) };
+      }
+    });
+    dbus_interface_->register_signal<std::vector<std::string>>(changed_signal_name_);
 
     // If the provided interface is created by this class we initialize it here,
     // otherwise we assume it is taken care of elsewhere
@@ -0,0 +1,701 @@
+#include <algorithm>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <map>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <tfc/confman/detail/patch.hpp>
+
+namespace tfc::confman::detail {
+
+namespace {
+
+/// JSON document tree, like glz::json_t except that numbers keep their text. A patch therefore leaves every number it
+/// does not touch exactly as it was, integers beyond the 53 bits a double holds included.
+struct json_t;
+using object_t = std::map<std::string, json_t, std::less<>>;
+using array_t = std::vector<json_t>;
+struct number_t {
+  std::string text{};
+};
+struct json_t {
+  std::variant<std::nullptr_t, bool, number_t, std::string, array_t, object_t> data{};
+};
+
+/// Recursive descent parser of RFC 8259 JSON
+class parser {
+public:
+  explicit parser(std::string_view text) noexcept : text_{ text } {}
+
+  /// \return the document, std::nullopt if it is not valid JSON
+  auto document() -> std::optional<json_t> {
+    auto result{ value(0) };
+    skip_whitespace();
+    if (!result || pos_ != text_.size()) {
+      return std::nullopt;
+    }
+    return result;
+  }
+
+private:
+  static constexpr std::size_t max_depth{ 256 };
+
+  void skip_whitespace() noexcept {
+    while (pos_ < text_.size() &&
+           (text_[pos_] == ' ' || text_[pos_] == '\t' || text_[pos_] == '\n' || text_[pos_] == '\r')) {
+      pos_++;
+    }
+  }
+
+  auto consume(std::string_view token) noexcept -> bool {
+    if (text_.substr(pos_).starts_with(token)) {
+      pos_ += token.size();
+      return true;
+    }
+    return false;
+  }
+
+  auto digits() noexcept -> std::size_t {
+    auto const begin{ pos_ };
+    while (pos_ < text_.size() && text_[pos_] >= '0' && text_[pos_] <= '9') {
+      pos_++;
+    }
+    return pos_ - begin;
+  }
+
+  auto value(std::size_t depth) -> std::optional<json_t> {
+    if (depth > max_depth) {
+      return std::nullopt;
+    }
+    skip_whitespace();
+    if (pos_ >= text_.size()) {
+      return std::nullopt;
+    }
+    switch (text_[pos_]) {
+      case '{':
+        return object(depth);
+      case '[':
+        return array(depth);
+      case '"':
+        if (auto str{ string() }) {
+          return json_t{ std::move(str.value()) };
+        }
+        return std::nullopt;
+      case 't':
+        return consume("true") ? std::optional{ json_t{ true } } : std::nullopt;
+      case 'f':
+        return consume("false") ? std::optional{ json_t{ false } } : std::nullopt;
+      case 'n':
+        return consume("null") ? std::optional{ json_t{ nullptr } } : std::nullopt;
+      default:
+        return number();
+    }
+  }
+
+  auto number() -> std::optional<json_t> {
+    auto const begin{ pos_ };
+    consume("-");
+    if (!consume("0") && digits() == 0) {
+      return std::nullopt;
+    }
+    if (consume(".") && digits() == 0) {
+      return std::nullopt;
+    }
+    if (consume("e") || consume("E")) {
+      if (!consume("+")) {
+        consume("-");
+      }
+      if (digits() == 0) {
+        return std::nullopt;
+      }
+    }
+    return json_t{ number_t{ std::string{ text_.substr(begin, pos_ - begin) } } };
+  }
+
+  auto hex4() noexcept -> std::optional<std::uint32_t> {
+    if (text_.size() - pos_ < 4) {
+      return std::nullopt;
+    }
+    std::uint32_t code{};
+    auto const [end, err]{ std::from_chars(text_.data() + pos_, text_.data() + pos_ + 4, code, 16) };
+    if (err != std::errc{} || end != text_.data() + pos_ + 4) {
+      return std::nullopt;
+    }
+    pos_ += 4;
+    return code;
+  }
+
+  static void append_utf8(std::string& out, std::uint32_t code) {
+    if (code < 0x80) {
+      out += static_cast<char>(code);
+    } else if (code < 0x800) {
+      out += static_cast<char>(0xc0 | (code >> 6));
+      out += static_cast<char>(0x80 | (code & 0x3f));
+    } else if (code < 0x10000) {
+      out += static_cast<char>(0xe0 | (code >> 12));
+      out += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+      out += static_cast<char>(0x80 | (code & 0x3f));
+    } else {
+      out += static_cast<char>(0xf0 | (code >> 18));
+      out += static_cast<char>(0x80 | ((code >> 12) & 0x3f));
+      out += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+      out += static_cast<char>(0x80 | (code & 0x3f));
+    }
+  }
+
+  auto string() -> std::optional<std::string> {
+    if (!consume("\"")) {
+      return std::nullopt;
+    }
+    std::string result{};
+    while (pos_ < text_.size()) {
+      char const character{ text_[pos_++] };
+      if (character == '"') {
+        return result;
+      }
+      if (static_cast<unsigned char>(character) < 0x20) {
+        return std::nullopt;
+      }
+      if (character != '\\') {
+        result += character;
+        continue;
+      }
+      if (pos_ >= text_.size()) {
+        return std::nullopt;
+      }
+      switch (text_[pos_++]) {
+        case '"':
+          result += '"';
+          break;
+        case '\\':
+          result += '\\';
+          break;
+        case '/':
+          result += '/';
+          break;
+        case 'b':
+          result += '\b';
+          break;
+        case 'f':
+          result += '\f';
+          break;
+        case 'n':
+          result += '\n';
+          break;
+        case 'r':
+          result += '\r';
+          break;
+        case 't':
+          result += '\t';
+          break;
+        case 'u': {
+          auto code{ hex4() };
+          if (!code) {
+            return std::nullopt;
+          }
+          // a high surrogate is followed by the low one, together they encode a code point above the basic plane
+          if (code.value() >= 0xd800 && code.value() < 0xdc00) {
+            if (!consume("\\u")) {
+              return std::nullopt;
+            }
+            auto const low{ hex4() };
+            if (!low || low.value() < 0xdc00 || low.value() >= 0xe000) {
+              return std::nullopt;
+            }
+            code = 0x10000 + ((code.value() - 0xd800) << 10) + (low.value() - 0xdc00);
+          } else if (code.value() >= 0xdc00 && code.value() < 0xe000) {
+            return std::nullopt;
+          }
+          append_utf8(result, code.value());
+          break;
+        }
+        default:
+          return std::nullopt;
+      }
+    }
+    return std::nullopt;
+  }
+
+  auto array(std::size_t depth) -> std::optional<json_t> {
+    consume("[");
+    array_t result{};
+    skip_whitespace();
+    if (consume("]")) {
+      return json_t{ std::move(result) };
+    }
+    while (true) {
+      auto element{ value(depth + 1) };
+      if (!element) {
+        return std::nullopt;
+      }
+      result.emplace_back(std::move(element.value()));
+      skip_whitespace();
+      if (consume("]")) {
+        return json_t{ std::move(result) };
+      }
+      if (!consume(",")) {
+        return std::nullopt;
+      }
+    }
+  }
+
+  auto object(std::size_t depth) -> std::optional<json_t> {
+    consume("{");
+    object_t result{};
+    skip_whitespace();
+    if (consume("}")) {
+      return json_t{ std::move(result) };
+    }
+    while (true) {
+      skip_whitespace();
+      auto key{ string() };
+      skip_whitespace();
+      if (!key || !consume(":")) {
+        return std::nullopt;
+      }
+      auto member{ value(depth + 1) };
+      if (!member) {
+        return std::nullopt;
+      }
+      result.insert_or_assign(std::move(key.value()), std::move(member.value()));
+      skip_whitespace();
+      if (consume("}")) {
+        return json_t{ std::move(result) };
+      }
+      if (!consume(",")) {
+        return std::nullopt;
+      }
+    }
+  }
+
+  std::string_view text_;
+  std::size_t pos_{};
+};
+
+void write_string(std::string_view value, std::string& out) {
+  out += '"';
+  for (char const character : value) {
+    switch (character) {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '\b':
+        out += "\\b";
+        break;
+      case '\f':
+        out += "\\f";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      case '\r':
+        out += "\\r";
+        break;
+      case '\t':
+        out += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(character) < 0x20) {
+          out += fmt::format("\\u{:04x}", static_cast<unsigned>(character));
+        } else {
+          out += character;
+        }
+    }
+  }
+  out += '"';
+}
+
+/// \brief write value as compact JSON, numbers as they were read
+void write(json_t const& value, std::string& out) {
+  std::visit(
+      [&out]<typename value_t>(value_t const& content) {
+        if constexpr (std::same_as<value_t, std::nullptr_t>) {
+          out += "null";
+        } else if constexpr (std::same_as<value_t, bool>) {
+          out += content ? "true" : "false";
+        } else if constexpr (std::same_as<value_t, number_t>) {
+          out += content.text;
+        } else if constexpr (std::same_as<value_t, std::string>) {
+          write_string(content, out);
+        } else if constexpr (std::same_as<value_t, array_t>) {
+          out += '[';
+          for (auto const& element : content) {
+            if (&element != &content.front()) {
+              out += ',';
+            }
+            write(element, out);
+          }
+          out += ']';
+        } else {
+          out += '{';
+          for (auto const& [key, member] : content) {
+            if (out.back() != '{') {
+              out += ',';
+            }
+            write_string(key, out);
+            out += ':';
+            write(member, out);
+          }
+          out += '}';
+        }
+      },
+      value.data);
+}
+
+/// \return true if the numbers are equal, integers are compared exactly and anything else as double
+auto equal_number(number_t const& lhs, number_t const& rhs) -> bool {
+  if (lhs.text == rhs.text) {
+    return true;
+  }
+  auto const parse{ []<typename value_t>(std::string const& text, value_t& value) {
+    auto const [end, err]{ std::from_chars(text.data(), text.data() + text.size(), value) };
+    return err == std::errc{} && end == text.data() + text.size();
+  } };
+  std::int64_t lhs_integer{};
+  std::int64_t rhs_integer{};
+  if (parse(lhs.text, lhs_integer) && parse(rhs.text, rhs_integer)) {
+    return lhs_integer == rhs_integer;
+  }
+  double lhs_double{};
+  double rhs_double{};
+  return parse(lhs.text, lhs_double) && parse(rhs.text, rhs_double) && lhs_double == rhs_double;
+}
+
+auto invalid() -> std::error_code {
+  return std::make_error_code(std::errc::invalid_argument);
+}
+
+/// \return reference token of a JSON pointer, `~` and `/` escaped
+auto escape(std::string_view key) -> std::string {
+  std::string escaped{};
+  escaped.reserve(key.size());
+  for (char const character : key) {
+    if (character == '~') {
+      escaped += "~0";
+    } else if (character == '/') {
+      escaped += "~1";
+    } else {
+      escaped += character;
+    }
+  }
+  return escaped;
+}
+
+/// \return the unescaped reference tokens of a JSON pointer
+auto split(std::string_view pointer) -> std::expected<std::vector<std::string>, std::error_code> {
+  std::vector<std::string> tokens{};
+  if (pointer.empty()) {
+    return tokens;
+  }
+  if (pointer.front() != '/') {
+    return std::unexpected{ invalid() };
+  }
+  pointer.remove_prefix(1);
+  while (true) {
+    auto const end{ std::min(pointer.find('/'), pointer.size()) };
+    std::string token{};
+    for (std::size_t idx{}; idx < end; idx++) {
+      if (pointer[idx] != '~') {
+        token += pointer[idx];
+        continue;
+      }
+      if (idx + 1 >= end || (pointer[idx + 1] != '0' && pointer[idx + 1] != '1')) {
+        return std::unexpected{ invalid() };
+      }
+      token += pointer[++idx] == '0' ? '~' : '/';
+    }
+    tokens.emplace_back(std::move(token));
+    if (end == pointer.size()) {
+      return tokens;
+    }
+    pointer.remove_prefix(end + 1);
+  }
+}
+
+/// \param past_end whether the index one past the last element, or `-`, refers to a new element
+auto index_of(std::string_view token, std::size_t size, bool past_end) -> std::optional<std::size_t> {
+  if (token == "-") {
+    return past_end ? std::optional{ size } : std::nullopt;
+  }
+  if (token.empty() || token.size() > 18 || (token.size() > 1 && token.front() == '0') ||
+      !std::ranges::all_of(token, [](char character) { return character >= '0' && character <= '9'; })) {
+    return std::nullopt;
+  }
+  std::size_t index{};
+  for (char const character : token) {
+    index = index * 10 + static_cast<std::size_t>(character - '0');
+  }
+  if (index > size || (index == size && !past_end)) {
+    return std::nullopt;
+  }
+  return index;
+}
+
+/// \return the value at the path, nullptr if it does not exist
+auto locate(json_t& root, std::span<std::string const> tokens) -> json_t* {
+  json_t* node{ &root };
+  for (auto const& token : tokens) {
+    if (auto* object{ std::get_if<object_t>(&node->data) }) {
+      auto itr{ object->find(token) };
+      if (itr == object->end()) {
+        return nullptr;
+      }
+      node = &itr->second;
+    } else if (auto* array{ std::get_if<array_t>(&node->data) }) {
+      auto const index{ index_of(token, array->size(), false) };
+      if (!index) {
+        return nullptr;
+      }
+      node = &(*array)[index.value()];
+    } else {
+      return nullptr;
+    }
+  }
+  return node;
+}
+
+auto add_at(json_t& root, std::span<std::string const> tokens, json_t&& value) -> std::error_code {
+  if (tokens.empty()) {
+    root = std::move(value);
+    return {};
+  }
+  auto* parent{ locate(root, tokens.first(tokens.size() - 1)) };
+  if (parent == nullptr) {
+    return invalid();
+  }
+  if (auto* object{ std::get_if<object_t>(&parent->data) }) {
+    object->insert_or_assign(tokens.back(), std::move(value));
+    return {};
+  }
+  if (auto* array{ std::get_if<array_t>(&parent->data) }) {
+    auto const index{ index_of(tokens.back(), array->size(), true) };
+    if (!index) {
+      return invalid();
+    }
+    array->insert(std::next(array->begin(), static_cast<std::ptrdiff_t>(index.value())), std::move(value));
+    return {};
+  }
+  return invalid();
+}
+
+/// \return the removed value
+auto remove_at(json_t& root, std::span<std::string const> tokens) -> std::expected<json_t, std::error_code> {
+  if (tokens.empty()) {
+    return std::unexpected{ invalid() };
+  }
+  auto* parent{ locate(root, tokens.first(tokens.size() - 1)) };
+  if (parent == nullptr) {
+    return std::unexpected{ invalid() };
+  }
+  if (auto* object{ std::get_if<object_t>(&parent->data) }) {
+    auto itr{ object->find(tokens.back()) };
+    if (itr == object->end()) {
+      return std::unexpected{ invalid() };
+    }
+    json_t removed{ std::move(itr->second) };
+    object->erase(itr);
+    return removed;
+  }
+  if (auto* array{ std::get_if<array_t>(&parent->data) }) {
+    auto const index{ index_of(tokens.back(), array->size(), false) };
+    if (!index) {
+      return std::unexpected{ invalid() };
+    }
+    auto const itr{ std::next(array->begin(), static_cast<std::ptrdiff_t>(index.value())) };
+    json_t removed{ std::move(*itr) };
+    array->erase(itr);
+    return removed;
+  }
+  return std::unexpected{ invalid() };
+}
+
+auto equal_json(json_t const& lhs, json_t const& rhs) -> bool {
+  if (lhs.data.index() != rhs.data.index()) {
+    return false;
+  }
+  return std::visit(
+      [&rhs]<typename value_t>(value_t const& lhs_value) -> bool {
+        auto const& rhs_value{ std::get<value_t>(rhs.data) };
+        if constexpr (std::same_as<value_t, array_t>) {
+          return std::ranges::equal(lhs_value, rhs_value, equal_json);
+        } else if constexpr (std::same_as<value_t, object_t>) {
+          return lhs_value.size() == rhs_value.size() && std::ranges::all_of(lhs_value, [&rhs_value](auto const& member) {
+                   auto const itr{ rhs_value.find(member.first) };
+                   return itr != rhs_value.end() && equal_json(member.second, itr->second);
+                 });
+        } else if constexpr (std::same_as<value_t, number_t>) {
+          return equal_number(lhs_value, rhs_value);
+        } else {
+          return lhs_value == rhs_value;
+        }
+      },
+      lhs.data);
+}
+
+auto member(object_t const& object, std::string_view name) -> json_t const* {
+  auto const itr{ object.find(name) };
+  return itr == object.end() ? nullptr : &itr->second;
+}
+
+auto string_member(object_t const& object, std::string_view name) -> std::string const* {
+  auto const* value{ member(object, name) };
+  return value == nullptr ? nullptr : std::get_if<std::string>(&value->data);
+}
+
+void merge(json_t& target, json_t const& patch, std::string const& path, std::vector<std::string>& paths) {
+  auto const* patch_object{ std::get_if<object_t>(&patch.data) };
+  if (patch_object == nullptr) {
+    target = patch;
+    paths.emplace_back(path);
+    return;
+  }
+  if (!std::holds_alternative<object_t>(target.data)) {
+    target.data = object_t{};
+  }
+  auto& target_object{ std::get<object_t>(target.data) };
+  for (auto const& [key, value] : *patch_object) {
+    auto member_path{ path + "/" + escape(key) };
+    if (std::holds_alternative<std::nullptr_t>(value.data)) {
+      if (target_object.erase(key) > 0) {
+        paths.emplace_back(std::move(member_path));
+      }
+      continue;
+    }
+    merge(target_object[key], value, member_path, paths);
+  }
+}
+
+/// \brief apply a JSON merge patch (RFC 7386) to target
+/// \param paths JSON pointers to the values set or removed are appended
+void merge_patch(json_t& target, json_t const& patch, std::vector<std::string>& paths) {
+  merge(target, patch, {}, paths);
+}
+
+/// \brief apply the operations of a JSON patch (RFC 6902) to target
+/// \param paths JSON pointers to the values changed are appended
+/// \return std::errc::invalid_argument if the patch is malformed or a path does not exist, std::errc::operation_canceled
+/// if a test operation fails. target is left partially patched on error.
+auto json_patch(json_t& target, json_t const& operations, std::vector<std::string>& paths) -> std::error_code {
+  auto const* operation_list{ std::get_if<array_t>(&operations.data) };
+  if (operation_list == nullptr) {
+    return invalid();
+  }
+  for (auto const& operation_json : *operation_list) {
+    auto const* operation{ std::get_if<object_t>(&operation_json.data) };
+    if (operation == nullptr) {
+      return invalid();
+    }
+    auto const* op{ string_member(*operation, "op") };
+    auto const* path{ string_member(*operation, "path") };
+    if (op == nullptr || path == nullptr) {
+      return invalid();
+    }
+    auto const tokens{ split(*path) };
+    if (!tokens) {
+      return tokens.error();
+    }
+    auto const* value{ member(*operation, "value") };
+    if (value == nullptr && (*op == "add" || *op == "replace" || *op == "test")) {
+      return invalid();
+    }
+
+    if (*op == "add") {
+      if (auto const err{ add_at(target, tokens.value(), json_t{ *value }) }) {
+        return err;
+      }
+    } else if (*op == "remove") {
+      if (auto const removed{ remove_at(target, tokens.value()) }; !removed) {
+        return removed.error();
+      }
+    } else if (*op == "replace") {
+      auto* node{ locate(target, tokens.value()) };
+      if (node == nullptr) {
+        return invalid();
+      }
+      *node = *value;
+    } else if (*op == "move" || *op == "copy") {
+      auto const* from{ string_member(*operation, "from") };
+      if (from == nullptr) {
+        return invalid();
+      }
+      auto const from_tokens{ split(*from) };
+      if (!from_tokens) {
+        return from_tokens.error();
+      }
+      auto* node{ locate(target, from_tokens.value()) };
+      if (node == nullptr) {
+        return invalid();
+      }
+      if (*op == "move") {
+        if (*from == *path) {
+          continue;
+        }
+        // a value cannot be moved into one of its children
+        if (path->starts_with(*from + "/")) {
+          return invalid();
+        }
+        auto removed{ remove_at(target, from_tokens.value()) };
+        if (!removed) {
+          return removed.error();
+        }
+        if (auto const err{ add_at(target, tokens.value(), std::move(removed.value())) }) {
+          return err;
+        }
+        paths.emplace_back(*from);
+      } else if (auto const err{ add_at(target, tokens.value(), json_t{ *node }) }) {
+        return err;
+      }
+    } else if (*op == "test") {
+      auto* node{ locate(target, tokens.value()) };
+      if (node == nullptr || !equal_json(*node, *value)) {
+        return std::make_error_code(std::errc::operation_canceled);
+      }
+      continue;
+    } else {
+      return invalid();
+    }
+    paths.emplace_back(*path);
+  }
+  return {};
+}
+
+}  // namespace
+
+auto apply_patch(std::string_view document, std::string_view patch) -> std::expected<patched, std::error_code> {
+  auto target{ parser{ document }.document() };
+  if (!target) {
+    return std::unexpected{ invalid() };
+  }
+  auto const patch_json{ parser{ patch }.document() };
+  if (!patch_json) {
+    return std::unexpected{ invalid() };
+  }
+  patched result{};
+  if (std::holds_alternative<array_t>(patch_json->data)) {
+    if (auto const err{ json_patch(target.value(), patch_json.value(), result.paths) }) {
+      return std::unexpected{ err };
+    }
+  } else {
+    merge_patch(target.value(), patch_json.value(), result.paths);
+  }
+  write(target.value(), result.document);
+  return result;
+}
+
+}  // namespace tfc::confman::detail
@@ -1,10 +1,19 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
 #include <chrono>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <future>
 #include <iterator>
 #include <map>
 #include <optional>
 
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+
 #include <stduuid/uuid.h>
 
 #include <tfc/utils/pragmas.hpp>
@@ -24,6 +33,7 @@ namespace {
 
 constexpr std::chrono::days default_retention_days{ 30 };
 constexpr size_t default_retention_count{ 4 };
+constexpr std::chrono::milliseconds default_write_debounce{ 100 };
 
 /// \brief fetch value of "TFC_CONFMAN_MIN_RETENTION_DAYS", if value is not set a default of std::chrono::days(30) is
 /// returned
@@ -67,55 +77,192 @@ auto generate_uuid_filename(std::filesystem::path config_file) -> std::filesyste
   return std::filesystem::path{ config_file.replace_extension().string() + "_" + get_uuid() + ".json" };
 }
 
-/// \brief Delete old files from a specified configuration setting based on retention count and days. If the number
-/// of files exceed the retention count AND if the file's last modification date surpasses the retention time,
-/// \param file_path configuration to apply retention to
-auto apply_retention_policy(std::filesystem::path const& file_path) -> void {
-  // +1 for the file itself
-  size_t const retention_count = get_minimum_retention_count() + 1;
-  std::chrono::days const retention_time = get_minimum_retention_days();
+/// \brief The thread writing configuration files, shared by every file_storage of the process
+/// Queued work is finished before the process exits.
+struct writer_thread {
+  writer_thread() = default;
+  writer_thread(writer_thread const&) = delete;
+  writer_thread(writer_thread&&) = delete;
+  auto operator=(writer_thread const&) -> writer_thread& = delete;
+  auto operator=(writer_thread&&) -> writer_thread& = delete;
+  ~writer_thread() { pool.join(); }
 
-  std::map<std::filesystem::file_time_type, std::filesystem::path> const file_times =
-      tfc::confman::get_json_files_by_last_write_time(file_path);
+  boost::asio::thread_pool pool{ 1 };
+};
 
-  /// no need to apply retention if files are under the retention count
-  if (file_times.size() <= retention_count) {
-    return;
-  }
+auto writer() -> writer_thread& {
+  static writer_thread instance{};
+  return instance;
+}
+
+void log_write_error(std::error_code err, std::filesystem::path const& file_path) {
+  tfc::logger::logger{ "file_storage" }.warn(R"(Error: "{}" writing to file: "{}")", err.message(), file_path.string());
+}
 
-  tfc::confman::remove_json_files_exceeding_retention(file_times, retention_count, retention_time);
+auto errno_code() -> std::error_code {
+  return { errno, std::system_category() };
 }
 
+/// Snapshot file layout, integers in host byte order as the snapshot never leaves the machine which wrote it
+///   magic, 8 bytes including the format version
+///   hash of the json source, 8 bytes
+///   size of the payload, 8 bytes
+///   payload, glaze BEVE
+constexpr std::string_view snapshot_magic{ "tfcsnp\x00\x01", 8 };
+constexpr std::size_t snapshot_header_size{ snapshot_magic.size() + 2 * sizeof(std::uint64_t) };
+
 }  // namespace
 
 namespace tfc::confman {
 
-/// \brief Write content to a backup file and delete older files if they surpass retention criteria.
-/// \param file_content content to be written to the new file.
-/// \param file_path path to file
-/// \return `std::error_code` with result of write operation
-auto write_and_apply_retention_policy(std::string_view file_content, std::filesystem::path const& file_path)
-    -> std::error_code {
-  auto write_error{ write_to_file(generate_uuid_filename(file_path), file_content) };
-
-  if (write_error) {
-    return write_error;
+auto write_debounce() -> std::chrono::milliseconds {
+  std::optional<std::uint64_t> const env = getenv<std::uint64_t>("TFC_CONFMAN_WRITE_DEBOUNCE_MS");
+  if (!env.has_value()) {
+    return default_write_debounce;
   }
-
-  apply_retention_policy(file_path);
-  return {};
+  return std::chrono::milliseconds(env.value());
 }
 
-/// \brief writes file contents to a file
+/// \brief writes file contents to a temporary file which replaces the file once it is on disc
+/// A reader of file_path, or a power loss, sees either the old or the new contents, never a partial file.
 /// \param file_path path of the file
 /// \param file_contents contents of the file
-/// \returns A std::error_code indicating success or failure. If write fails, IO error is returned.
+/// \returns A std::error_code indicating success or failure.
 auto write_to_file(std::filesystem::path const& file_path, std::string_view file_contents) -> std::error_code {
-  auto glz_err{ glz::buffer_to_file(file_contents, file_path.string()) };
-  if (glz_err != glz::error_code::none) {
-    return std::make_error_code(std::errc::io_error);
+  auto const temporary{ std::filesystem::path{ file_path.string() + ".tmp" } };
+  int const file{ ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644) };
+  if (file < 0) {
+    return errno_code();
+  }
+  auto const fail{ [file, &temporary](std::error_code err) {
+    ::close(file);
+    std::error_code ignore{};
+    std::filesystem::remove(temporary, ignore);
+    return err;
+  } };
+  while (!file_contents.empty()) {
+    auto const written{ ::write(file, file_contents.data(), file_contents.size()) };
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return fail(errno_code());
+    }
+    file_contents.remove_prefix(static_cast<std::size_t>(written));
+  }
+  if (::fsync(file) != 0) {
+    return fail(errno_code());
+  }
+  if (::close(file) != 0) {
+    return errno_code();
+  }
+  if (::rename(temporary.c_str(), file_path.c_str()) != 0) {
+    return errno_code();
+  }
+  // the rename is only durable once the directory is on disc
+  auto const parent{ file_path.has_parent_path() ? file_path.parent_path() : std::filesystem::path{ "." } };
+  if (int const directory{ ::open(parent.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC) }; directory >= 0) {
+    ::fsync(directory);
+    ::close(directory);
+  }
+  return {};
+}
+
+namespace detail {
+
+backup_history::backup_history(std::filesystem::path config_file) : config_file_{ std::move(config_file) } {}
+
+auto backup_history::write(std::string_view file_content) -> std::error_code {
+  if (!backups_.has_value()) {
+    // backups of previous runs, from here on the history is kept up to date in memory
+    backups_ = get_json_files_by_last_write_time(config_file_);
+    std::erase_if(backups_.value(), [this](auto const& backup) { return backup.second == config_file_; });
   }
+  auto const backup{ generate_uuid_filename(config_file_) };
+  if (auto write_error{ write_to_file(backup, file_content) }; write_error) {
+    return write_error;
+  }
+  backups_->insert_or_assign(std::filesystem::file_time_type::clock::now(), backup);
+  apply_retention_policy();
   return {};
 }
 
+/// \brief Delete the oldest backups when there are more than the retention count and they are older than the retention
+/// time
+void backup_history::apply_retention_policy() {
+  auto const retention_count{ get_minimum_retention_count() };
+  auto const retention_time{ get_minimum_retention_days() };
+  auto const current_time{ std::filesystem::file_time_type::clock::now() };
+  auto& backups{ backups_.value() };
+  while (backups.size() > retention_count && current_time - backups.begin()->first > retention_time) {
+    std::error_code ignore{};
+    std::filesystem::remove(backups.begin()->second, ignore);
+    backups.erase(backups.begin());
+  }
+}
+
+void queue_write_file(std::filesystem::path file_path, std::string file_content) {
+  boost::asio::post(writer().pool, [file_path = std::move(file_path), file_content = std::move(file_content)] {
+    if (auto write_error{ write_to_file(file_path, file_content) }; write_error) {
+      log_write_error(write_error, file_path);
+    }
+  });
+}
+
+void queue_backup(std::shared_ptr<backup_history> history, std::string file_content) {
+  boost::asio::post(writer().pool, [history = std::move(history), file_content = std::move(file_content)] {
+    if (auto write_error{ history->write(file_content) }; write_error) {
+      log_write_error(write_error, history->file());
+    }
+  });
+}
+
+auto source_hash(std::string_view source) noexcept -> std::uint64_t {
+  // FNV-1a
+  std::uint64_t hash{ 0xcbf29ce484222325 };
+  for (char const character : source) {
+    hash ^= static_cast<std::uint8_t>(character);
+    hash *= 0x100000001b3;
+  }
+  return hash;
+}
+
+auto snapshot_file(std::filesystem::path const& config_file) -> std::filesystem::path {
+  return std::filesystem::path{ config_file.string() + ".beve" };
+}
+
+auto make_snapshot(std::uint64_t hash, std::string_view payload) -> std::string {
+  std::uint64_t const size{ payload.size() };
+  std::string snapshot{ snapshot_magic };
+  snapshot.resize(snapshot_header_size);
+  std::memcpy(snapshot.data() + snapshot_magic.size(), &hash, sizeof(hash));
+  std::memcpy(snapshot.data() + snapshot_magic.size() + sizeof(hash), &size, sizeof(size));
+  snapshot += payload;
+  return snapshot;
+}
+
+auto snapshot_payload(std::string_view snapshot, std::uint64_t hash) noexcept -> std::optional<std::string_view> {
+  if (snapshot.size() < snapshot_header_size || !snapshot.starts_with(snapshot_magic)) {
+    return std::nullopt;
+  }
+  std::uint64_t snapshot_hash{};
+  std::uint64_t size{};
+  std::memcpy(&snapshot_hash, snapshot.data() + snapshot_magic.size(), sizeof(snapshot_hash));
+  std::memcpy(&size, snapshot.data() + snapshot_magic.size() + sizeof(snapshot_hash), sizeof(size));
+  snapshot.remove_prefix(snapshot_header_size);
+  if (snapshot_hash != hash || size != snapshot.size()) {
+    return std::nullopt;
+  }
+  return snapshot;
+}
+
+void wait_for_writes() {
+  std::promise<void> done{};
+  auto finished{ done.get_future() };
+  boost::asio::post(writer().pool, [&done] { done.set_value(); });
+  finished.wait();
+}
+
+}  // namespace detail
+
 }  // namespace tfc::confman
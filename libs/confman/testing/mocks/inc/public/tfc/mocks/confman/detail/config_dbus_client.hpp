@@ -14,7 +14,8 @@ public:
                           std::string_view,
                           value_call_t&&,
                           schema_call_t&&,
-                          change_call_t&&)
+                          change_call_t&&,
+                          patch_call_t&&)
       : config_dbus_client{ conn } {}
   MOCK_METHOD((void), set, (std::string && prop), (const));  // NOLINT
 };
@@ -49,6 +49,11 @@ public:
   auto make_change() noexcept -> change { return change{ *this }; }
 
   auto from_string(std::string_view value) -> std::error_code {
+    // like config::from_string, the value is left unchanged when the JSON cannot be read
+    storage_t scratch{};
+    if (glz::read_json<storage_t>(scratch, value)) {
+      return std::make_error_code(std::errc::io_error);
+    }
     auto const error{ glz::read_json<storage_t>(make_change().value(), value) };
     if (error) {
       return std::make_error_code(std::errc::io_error);  // todo make glz to std::error_code
@@ -56,6 +61,18 @@ public:
     return {};
   }
 
+  auto patch(std::string_view value) -> std::error_code {
+    auto const current{ string() };
+    if (!current) {
+      return std::make_error_code(std::errc::io_error);
+    }
+    auto patched{ detail::apply_patch(current.value(), value) };
+    if (!patched) {
+      return patched.error();
+    }
+    return from_string(patched->document);
+  }
+
   storage_t storage_{};
 };
 
@@ -13,7 +13,8 @@ public:
                           std::string_view,
                           value_call_t&&,
                           schema_call_t&&,
-                          change_call_t&&)
+                          change_call_t&&,
+                          patch_call_t&&)
       : config_dbus_client{ conn } {}
 };
 
@@ -38,6 +38,7 @@ template <typename storage_t>
 struct config_testable : public tfc::confman::config<storage_t> {
   using tfc::confman::config<storage_t>::config;
   ~config_testable() {
+    this->storage_.flush();
     std::error_code ignore{};
     std::filesystem::remove(this->file(), ignore);
   }
@@ -128,6 +129,23 @@ auto main(int argc, char** argv) -> int {
     ut::expect(1 == c_called);
   };
 
+  "from json which cannot be read leaves the value unchanged"_test = [] {
+    instance test{ .storage_ = {
+                       .a = observable<int>{ 1 }, .b = observable<int>{ 2 }, .c = observable<std::string>{ "bar" } } };
+    uint32_t a_called{};
+    test.config->a.observe([&a_called](int, int) { a_called++; });
+    // a is read before c fails to be
+    ut::expect(!!test.config.from_string(R"({"a":11,"b":22,"c":33})"));
+    ut::expect(1 == test.config->a);
+    ut::expect(2 == test.config->b);
+    ut::expect("bar" == test.config->c);
+    ut::expect(0 == a_called);
+    // a patch which cannot be read is rejected the same way
+    ut::expect(!!test.config.patch(R"({"a":11,"c":33})"));
+    ut::expect(1 == test.config->a);
+    ut::expect(0 == a_called);
+  };
+
   "integration get_config"_test = [] {
     instance test{ .storage_ = {
                        .a = observable<int>{ 1 }, .b = observable<int>{ 2 }, .c = observable<std::string>{ "bar" } } };
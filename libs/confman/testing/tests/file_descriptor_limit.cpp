@@ -20,6 +20,7 @@ public:
   using tfc::confman::config<storage_t>::config;
 
   ~config_testable() {
+    this->storage_.flush();
     std::error_code ignore{};
     std::filesystem::remove(this->file(), ignore);
   }
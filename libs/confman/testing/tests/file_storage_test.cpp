@@ -1,6 +1,7 @@
 #include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <algorithm>
 #include <map>
 #include <optional>
 #include <string>
@@ -14,6 +15,7 @@
 
 #include <tfc/confman/observable.hpp>
 #include <tfc/progbase.hpp>
+#include <tfc/stx/glaze_meta.hpp>
 #include "tfc/confman/detail/retention.hpp"
 
 namespace asio = boost::asio;
@@ -36,12 +38,26 @@ struct test_me {
 
 using map = std::map<std::string, test_me>;
 
+struct snapshot_me {
+  int a{};
+  std::vector<std::string> b{};
+  std::chrono::milliseconds c{};
+  struct glaze {
+    static constexpr auto value{ glz::object("a", &snapshot_me::a, "b", &snapshot_me::b, "c", &snapshot_me::c) };
+    static constexpr auto name{ "snapshot_me" };
+  };
+};
+
+template <>
+inline constexpr bool tfc::confman::binary_snapshot<snapshot_me>{ true };
+
 template <typename storage_t>
 class file_testable : public tfc::confman::file_storage<storage_t> {
 public:
   using tfc::confman::file_storage<storage_t>::file_storage;
 
   ~file_testable() {
+    this->flush();
     std::error_code ignore{};
     std::filesystem::remove(this->file(), ignore);
   }
@@ -129,6 +145,7 @@ auto main(int argc, char** argv) -> int {
 
     conf.make_change()->a = 2;
     conf.make_change()->b = "test";
+    conf.flush();
 
     buffer = {};
     std::ignore = glz::read_file_json(json, file_name.string(), buffer);
@@ -141,7 +158,7 @@ auto main(int argc, char** argv) -> int {
 
     file_testable<test_me> conf{ ctx, json_file_name, test_me{ .a = observable<int>{ 3 }, .b = "bar" } };
     conf.make_change()->a = 2;
-    ctx.run_for(std::chrono::milliseconds(1));
+    conf.flush();
     auto files = std::filesystem::directory_iterator(json_file_name.parent_path());
 
     bool backup_found = false;
@@ -168,6 +185,86 @@ auto main(int argc, char** argv) -> int {
     }
   };
 
+  "changes within the debounce window are written once"_test = [&] {
+    std::filesystem::path const parent_path{ file_name.parent_path() / "debounce" };
+    std::filesystem::path const json_file_name{ parent_path / "debounce.json" };
+    auto const count_backups{ [&] {
+      return std::ranges::count_if(std::filesystem::directory_iterator(parent_path), [](auto const& entry) {
+        return entry.path().filename().string().starts_with("debounce_");
+      });
+    } };
+    {
+      file_testable<test_me> conf{ ctx, json_file_name, test_me{ .a = observable<int>{ 1 }, .b = "bar" } };
+      for (int idx{ 2 }; idx < 20; idx++) {
+        conf.make_change()->a = idx;
+      }
+      glz::json_t json{};
+      std::string buffer{};
+      std::ignore = glz::read_file_json(json, json_file_name.string(), buffer);
+      ut::expect(static_cast<int>(json["a"].get<double>()) == 1) << "written before the debounce window passed";
+
+      ctx.run_for(tfc::confman::write_debounce() + std::chrono::milliseconds(50));
+      tfc::confman::detail::wait_for_writes();
+      buffer = {};
+      std::ignore = glz::read_file_json(json, json_file_name.string(), buffer);
+      ut::expect(static_cast<int>(json["a"].get<double>()) == 19);
+      ut::expect(count_backups() == 1) << count_backups();
+      ut::expect(!std::filesystem::exists(json_file_name.string() + ".tmp"));
+
+      conf.make_change()->a = 20;
+      conf.flush();
+      buffer = {};
+      std::ignore = glz::read_file_json(json, json_file_name.string(), buffer);
+      ut::expect(static_cast<int>(json["a"].get<double>()) == 20);
+      ut::expect(count_backups() == 2) << count_backups();
+    }
+    std::filesystem::remove_all(parent_path);
+  };
+
+  "binary snapshot follows the json file"_test = [&] {
+    std::filesystem::path const json_file_name{ file_name.parent_path() / "snapshot.json" };
+    auto const snapshot_file{ tfc::confman::detail::snapshot_file(json_file_name) };
+    auto const snapshot_matches_json{ [&] {
+      std::string json{};
+      std::string snapshot{};
+      std::ignore = glz::file_to_buffer(json, json_file_name.string());
+      std::ignore = glz::file_to_buffer(snapshot, snapshot_file.string());
+      return tfc::confman::detail::snapshot_payload(snapshot, tfc::confman::detail::source_hash(json)).has_value();
+    } };
+    {
+      tfc::confman::file_storage<snapshot_me> conf{ ctx, json_file_name,
+                                                    snapshot_me{ .a = 1, .b = { "foo" }, .c = std::chrono::milliseconds{ 5 } } };
+      conf.make_change()->b.emplace_back("bar");
+      conf.flush();
+      ut::expect(snapshot_matches_json());
+    }
+    {
+      tfc::confman::file_storage<snapshot_me> const reloaded{ ctx, json_file_name };
+      ut::expect(reloaded->a == 1);
+      ut::expect(reloaded->b == std::vector<std::string>{ "foo", "bar" });
+      ut::expect(reloaded->c == std::chrono::milliseconds{ 5 });
+    }
+    {
+      // edited by hand, the snapshot is stale
+      tfc::confman::write_to_file(json_file_name, R"({"a":3,"b":["baz"]})");
+      file_testable<snapshot_me> conf{ ctx, json_file_name };
+      ut::expect(conf->a == 3);
+      ut::expect(conf->b == std::vector<std::string>{ "baz" });
+      conf.flush();
+      ut::expect(snapshot_matches_json());
+    }
+    std::filesystem::remove(snapshot_file);
+  };
+
+  "snapshot payload is only returned for its json source"_test = [] {
+    auto const snapshot{ tfc::confman::detail::make_snapshot(42, "payload") };
+    ut::expect(tfc::confman::detail::snapshot_payload(snapshot, 42) == "payload");
+    ut::expect(!tfc::confman::detail::snapshot_payload(snapshot, 43).has_value());
+    ut::expect(!tfc::confman::detail::snapshot_payload(snapshot.substr(0, snapshot.size() - 1), 42).has_value());
+    ut::expect(!tfc::confman::detail::snapshot_payload("payload", 42).has_value());
+    ut::expect(tfc::confman::detail::source_hash(R"({"a":1})") != tfc::confman::detail::source_hash(R"({"a":2})"));
+  };
+
   "testing retention policy without removal"_test = [&] {
     std::filesystem::path const parent_path{ file_name.parent_path() / "retention" };
 
@@ -1,3 +1,8 @@
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
 #include <boost/ut.hpp>
 #include <glaze/glaze.hpp>
 #include <tfc/confman/observable.hpp>
@@ -52,4 +57,72 @@ auto main(int, char**) -> int {
     expect(var == 32);
     expect(var == int_observable{ 32 });
   };
+
+  "subscriptions are notified in order until destroyed"_test = [] {
+    int_observable observed{ 1 };
+    std::vector<std::string> calls{};
+    observed.observe([&](int new_value, int) { calls.emplace_back(fmt::format("observer {}", new_value)); });
+    auto first{ observed.subscribe([&](int new_value, int) { calls.emplace_back(fmt::format("first {}", new_value)); }) };
+    {
+      auto const second{ observed.subscribe(
+          [&](int new_value, int old_value) { calls.emplace_back(fmt::format("second {} {}", new_value, old_value)); }) };
+      observed = 2;
+    }
+    auto moved{ std::move(first) };
+    expect(moved.subscribed());
+    expect(!first.subscribed());
+    observed = 3;
+    expect(calls == std::vector<std::string>{ "observer 2", "first 2", "second 2 1", "observer 3", "first 3" });
+  };
+
+  "subscription outliving its observable"_test = [] {
+    tfc::confman::subscription<int> subscription{};
+    expect(!subscription.subscribed());
+    {
+      int_observable const observed{ 1 };
+      subscription = observed.subscribe([](int, int) {});
+      expect(subscription.subscribed());
+    }
+    expect(!subscription.subscribed());
+  };
+
+  "floating point deadband"_test = [] {
+    tfc::confman::observable<double> observed{ 1.0 };
+    std::vector<std::pair<double, double>> exact{};
+    std::vector<std::pair<double, double>> banded{};
+    auto const exact_subscription{ observed.subscribe([&](double new_value, double old_value) {
+      exact.emplace_back(new_value, old_value);
+    }) };
+    auto const banded_subscription{ observed.subscribe(
+        [&](double new_value, double old_value) { banded.emplace_back(new_value, old_value); }, 0.5) };
+    for (double const value : { 1.25, 1.5, 1.75, 1.5 }) {
+      observed = value;
+    }
+    expect(exact.size() == 4);
+    expect(banded == std::vector<std::pair<double, double>>{ { 1.75, 1.0 } });
+  };
+
+  "batched notifications"_test = [] {
+    int_observable first{ 1 };
+    int_observable second{ 1 };
+    int_observable unchanged{ 1 };
+    std::vector<std::pair<int, int>> calls{};
+    auto const record{ [&](int new_value, int old_value) { calls.emplace_back(new_value, old_value); } };
+    first.observe(record);
+    auto const subscription{ second.subscribe(record) };
+    unchanged.observe(record);
+    {
+      tfc::confman::notification_batch const batch{};
+      first = 2;
+      first = 3;
+      {
+        tfc::confman::notification_batch const nested{};
+        second = 4;
+      }
+      unchanged = 5;
+      unchanged = 1;
+      expect(calls.empty());
+    }
+    expect(calls == std::vector<std::pair<int, int>>{ { 3, 1 }, { 4, 1 } });
+  };
 }
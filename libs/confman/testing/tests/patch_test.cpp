@@ -0,0 +1,104 @@
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <boost/ut.hpp>
+#include <glaze/glaze.hpp>
+
+#include <tfc/confman/detail/patch.hpp>
+
+namespace ut = boost::ut;
+using ut::expect;
+using ut::fatal;
+using ut::operator""_test;
+using tfc::confman::detail::apply_patch;
+
+auto main(int, char**) -> int {
+  constexpr std::string_view document{ R"({"motors":[{"name":"a","speed":10},{"name":"b","speed":20}],"unit":"mm"})" };
+
+  "merge patch changes a member"_test = [&] {
+    auto const patched{ apply_patch(document, R"({"unit":"m"})") };
+    expect(fatal(patched.has_value()));
+    expect(patched->document == R"({"motors":[{"name":"a","speed":10},{"name":"b","speed":20}],"unit":"m"})")
+        << patched->document;
+    expect(patched->paths == std::vector<std::string>{ "/unit" });
+  };
+
+  "merge patch removes members set to null and adds nested members"_test = [&] {
+    auto const patched{ apply_patch(R"({"a":{"b":1,"c":2}})", R"({"a":{"b":null,"d":{"e":3}}})") };
+    expect(fatal(patched.has_value()));
+    expect(patched->document == R"({"a":{"c":2,"d":{"e":3}}})") << patched->document;
+    expect(patched->paths == std::vector<std::string>{ "/a/b", "/a/d/e" });
+  };
+
+  "json patch replaces an array element member"_test = [&] {
+    auto const patched{ apply_patch(document, R"([{"op":"replace","path":"/motors/1/speed","value":25}])") };
+    expect(fatal(patched.has_value()));
+    expect(patched->document == R"({"motors":[{"name":"a","speed":10},{"name":"b","speed":25}],"unit":"mm"})")
+        << patched->document;
+    expect(patched->paths == std::vector<std::string>{ "/motors/1/speed" });
+  };
+
+  "json patch add, remove, move and copy"_test = [&] {
+    auto const patched{ apply_patch(document, R"([{"op":"add","path":"/motors/-","value":{"name":"c","speed":30}},
+                                                   {"op":"remove","path":"/motors/0"},
+                                                   {"op":"copy","from":"/unit","path":"/default_unit"},
+                                                   {"op":"move","from":"/unit","path":"/motors/0/unit"}])") };
+    expect(fatal(patched.has_value()));
+    expect(patched->document ==
+           R"({"default_unit":"mm","motors":[{"name":"b","speed":20,"unit":"mm"},{"name":"c","speed":30}]})")
+        << patched->document;
+    expect(patched->paths ==
+           std::vector<std::string>{ "/motors/-", "/motors/0", "/default_unit", "/unit", "/motors/0/unit" });
+  };
+
+  "json patch pointer escapes"_test = [] {
+    auto const patched{ apply_patch(R"({"a/b":{"c~d":1}})", R"([{"op":"replace","path":"/a~1b/c~0d","value":2}])") };
+    expect(fatal(patched.has_value()));
+    expect(patched->document == R"({"a/b":{"c~d":2}})") << patched->document;
+  };
+
+  "json patch is applied entirely or not at all"_test = [&] {
+    auto const failed_test{ apply_patch(
+        document, R"([{"op":"replace","path":"/unit","value":"m"},{"op":"test","path":"/motors/0/speed","value":11}])") };
+    expect(fatal(!failed_test.has_value()));
+    expect(failed_test.error() == std::errc::operation_canceled);
+
+    auto const missing_path{ apply_patch(document, R"([{"op":"replace","path":"/motors/2/speed","value":1}])") };
+    expect(fatal(!missing_path.has_value()));
+    expect(missing_path.error() == std::errc::invalid_argument);
+
+    auto const passed_test{ apply_patch(document, R"([{"op":"test","path":"/motors/0","value":{"speed":10,"name":"a"}}])") };
+    expect(fatal(passed_test.has_value()));
+    expect(passed_test->paths.empty());
+  };
+
+  "numbers keep their precision"_test = [] {
+    auto const patched{ apply_patch(R"({"id":9223372036854775806,"position":-9007199254740993,"unit":"mm"})",
+                                    R"({"unit":"m"})") };
+    expect(fatal(patched.has_value()));
+    expect(patched->document == R"({"id":9223372036854775806,"position":-9007199254740993,"unit":"m"})")
+        << patched->document;
+
+    auto const replaced{ apply_patch(R"({"id":1,"big":18446744073709551615})",
+                                     R"([{"op":"test","path":"/big","value":18446744073709551615},
+                                         {"op":"replace","path":"/id","value":9223372036854775807}])") };
+    expect(fatal(replaced.has_value()));
+    expect(replaced->document == R"({"big":18446744073709551615,"id":9223372036854775807})") << replaced->document;
+
+    // values are compared as numbers, not as text
+    expect(apply_patch(R"({"a":1.5,"b":10})", R"([{"op":"test","path":"/a","value":15e-1},
+                                                  {"op":"test","path":"/b","value":10.0}])")
+               .has_value());
+    expect(!apply_patch(R"({"b":9223372036854775807})", R"([{"op":"test","path":"/b","value":9223372036854775806}])")
+                .has_value());
+  };
+
+  "malformed patches are rejected"_test = [&] {
+    expect(!apply_patch(document, R"([{"op":"replace","value":1}])").has_value());
+    expect(!apply_patch(document, R"([{"op":"frobnicate","path":"/unit"}])").has_value());
+    expect(!apply_patch(document, R"([{"op":"add","path":"/motors/01","value":1}])").has_value());
+    expect(!apply_patch(document, R"([{"op":"move","from":"/motors","path":"/motors/0/x"}])").has_value());
+    expect(!apply_patch(document, R"({"unit":)").has_value());
+  };
+}
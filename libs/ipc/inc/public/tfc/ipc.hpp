@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <system_error>
 
 #include <fmt/format.h>
@@ -88,6 +89,9 @@ public:
 
   [[nodiscard]] auto unfiltered_value() const noexcept -> std::optional<value_t> const& { return slot_.value(); }
 
+  /// \return time the latest unfiltered value was sampled by its signal, see details::shm::sample_time
+  [[nodiscard]] auto sampled_at() const noexcept -> std::chrono::steady_clock::time_point { return slot_->sampled_at(); }
+
   [[nodiscard]] auto name() const noexcept -> std::string_view { return slot_->name(); }
 
   [[nodiscard]] auto full_name() const noexcept -> std::string { return slot_->full_name(); }
@@ -137,10 +141,15 @@ public:
    * Signal c'tor
    * @param ctx Execution context
    * @param name Signals name
+   * @param transport How values are published, slots adapt to the transport of the signal they are connected to
    */
-  signal(asio::io_context& ctx, manager_client_type client, std::string_view name, std::string_view description = "")
+  signal(asio::io_context& ctx,
+         manager_client_type client,
+         std::string_view name,
+         std::string_view description = "",
+         details::transport_e transport = details::transport_e::zmq)
     requires std::is_lvalue_reference_v<manager_client_type>
-      : client_{ client }, signal_{ make_impl_signal(ctx, name) },
+      : client_{ client }, signal_{ make_impl_signal(ctx, name, transport) },
         dbus_signal_{ client_.connection(), signal_->type_name() } {
     client_.register_signal_retry(signal_->full_name(), description, type_desc::value_e);
     dbus_signal_.initialize();
@@ -149,9 +158,10 @@ public:
   signal(asio::io_context& ctx,
          std::shared_ptr<sdbusplus::asio::connection> connection,
          std::string_view name,
-         std::string_view description = "")
+         std::string_view description = "",
+         details::transport_e transport = details::transport_e::zmq)
     requires(!std::is_lvalue_reference_v<manager_client_type>)
-      : client_{ connection }, signal_{ make_impl_signal(ctx, name) },
+      : client_{ connection }, signal_{ make_impl_signal(ctx, name, transport) },
         dbus_signal_{ client_.connection(), signal_->type_name() } {
     client_.register_signal_retry(signal_->full_name(), description, type_desc::value_e);
     dbus_signal_.initialize();
@@ -184,8 +194,8 @@ public:
   [[nodiscard]] auto value() const noexcept -> std::optional<value_t> const& { return signal_->value(); }
 
 private:
-  static auto make_impl_signal(auto&& ctx, auto&& name) {
-    auto exp{ details::signal<type_desc>::create(ctx, name) };
+  static auto make_impl_signal(auto&& ctx, auto&& name, details::transport_e transport) {
+    auto exp{ details::signal<type_desc>::create(ctx, name, transport) };
     if (!exp.has_value()) {
       throw std::runtime_error{ fmt::format("Unable to bind to socket, reason: {}", exp.error().message()) };
     }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <memory>
@@ -89,6 +90,23 @@ public:
    */
   auto connections(std::function<void(std::map<std::string, std::vector<std::string>> const&)>&& handler) -> void;
 
+  /**
+   * Async function to get the changes to the ipc manager registry after a given sequence number
+   * @param sequence the last sequence number the caller has seen, 0 to get every retained change
+   * @param handler called with the changes in order, or an error if they are no longer retained by the ipc manager.
+   * In the latter case the caller should fetch signals and slots again.
+   */
+  auto changes_since(std::uint64_t sequence,
+                     std::function<void(std::error_code const&, std::vector<change> const&)>&& handler) -> void;
+
+  /**
+   * Register a callback function that gets called with each change to the ipc manager registry
+   * @param change_callback a function like object called with each change, in order of sequence numbers
+   * @return a unique pointer to the match object, this is needed to keep the match object alive
+   */
+  auto register_changes_callback(std::function<void(change const&)> const& change_callback)
+      -> std::unique_ptr<sdbusplus::bus::match::match>;
+
   /**
    * Send a request over dbus to connect a slot to a signal.
    * On error handler will be called back with a non empty std::error_code&
@@ -112,6 +130,7 @@ public:
    * Register a callback function that gets "pinged" each time there is a connection change
    * @param connection_change_callback a function like object on each connection change it gets called with the slot and
    * signal that changed.
+   * @note Connection changes are only sent to the process which registered the slot.
    * @note There can only be a single callback registered per slot_name, if you register a new one. The old callback will be
    * overwritten.
    */
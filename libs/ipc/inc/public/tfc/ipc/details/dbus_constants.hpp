@@ -16,6 +16,9 @@ static constexpr std::string_view disconnect_method{ "Disconnect" };
 static constexpr std::string_view connect_method{ "Connect" };
 static constexpr std::string_view connections_property{ "Connections" };
 static constexpr std::string_view connection_change{ "ConnectionChange" };
+static constexpr std::string_view changes_signal{ "Changes" };
+static constexpr std::string_view changes_since_method{ "ChangesSince" };
+static constexpr std::string_view sequence_property{ "Sequence" };
 
 // service name
 static constexpr auto ipc_ruler_service_name = dbus::const_dbus_name<dbus_name>;
@@ -1,20 +1,37 @@
 #pragma once
 
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include <fmt/format.h>
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <glaze/core/common.hpp>
 #include <sdbusplus/asio/connection.hpp>
 #include <sdbusplus/asio/object_server.hpp>
 
+#include <tfc/confman.hpp>
+#include <tfc/confman/observable.hpp>
 #include <tfc/dbus/sdbusplus_meta.hpp>
 #include <tfc/dbus/string_maker.hpp>
 #include <tfc/ipc/details/dbus_ipc.hpp>
 #include <tfc/stx/concepts.hpp>
+#include <tfc/stx/glaze_meta.hpp>
 #include <tfc/utils/json_schema.hpp>
+#include <tfc/utils/pragmas.hpp>
 
 namespace tfc::ipc::details {
 
+namespace asio = boost::asio;
+
 namespace dbus::tags {
 static constexpr std::string_view value{ "Value" };
 static constexpr std::string_view slot{ "Slot" };
@@ -27,6 +44,229 @@ static constexpr std::string_view signal_interface{ tfc::dbus::const_dbus_name<s
 
 enum struct ipc_type_e : std::uint8_t { slot, signal };
 
+/// \brief how values are mirrored as dbus signals, the Value property always reads the latest value
+enum struct mirror_e : std::uint8_t {
+  off = 0,    // no Value signals are emitted
+  every,      // emit every value
+  on_change,  // emit changed values, at most one per interval, the latest value within an interval is emitted last
+  periodic,   // emit the latest value once per interval
+};
+
+struct mirror_config {
+  mirror_e mode{ mirror_e::every };
+  std::chrono::milliseconds interval{ 100 };
+  constexpr auto operator==(mirror_config const&) const noexcept -> bool = default;
+
+  struct glaze {
+    using type = mirror_config;
+    static constexpr std::string_view name{ "tfc::ipc::mirror" };
+    // clang-format off
+    static constexpr auto value{ glz::object(
+      "mode", &type::mode, "How values are mirrored as dbus signals",
+      "interval", &type::interval, "Minimum time between emitted values, or the period when periodic"
+    ) };
+    // clang-format on
+  };
+};
+
+/// \brief decides when the latest value is emitted, coalescing values which arrive within the configured interval
+template <typename value_t, typename timer_t = asio::steady_timer>
+class mirror : public std::enable_shared_from_this<mirror<value_t, timer_t>> {
+public:
+  using emit_t = std::function<void(value_t const&)>;
+
+  mirror(asio::any_io_executor executor, emit_t emit) : timer_{ std::move(executor) }, emit_{ std::move(emit) } {}
+
+  /// \brief apply a new policy, a pending value is emitted according to the new policy
+  void configure(mirror_config const& config) {
+    config_ = config;
+    disarm();
+    switch (config_.mode) {
+      case mirror_e::off:
+      case mirror_e::every:
+        return;
+      case mirror_e::on_change:
+        leading_edge();
+        return;
+      case mirror_e::periodic:
+        if (value_.has_value() && config_.interval > std::chrono::milliseconds{ 0 }) {
+          arm();
+        }
+        return;
+    }
+  }
+
+  void update(value_t const& value) {
+    value_ = value;
+    switch (config_.mode) {
+      case mirror_e::off:
+        return;
+      case mirror_e::every:
+        emit();
+        return;
+      case mirror_e::on_change:
+        if (armed_) {
+          // coalesced into the end of the current interval
+          pending_ = true;
+          return;
+        }
+        leading_edge();
+        return;
+      case mirror_e::periodic:
+        if (config_.interval == std::chrono::milliseconds{ 0 }) {
+          emit();
+        } else if (!armed_) {
+          arm();
+        }
+        return;
+    }
+  }
+
+  [[nodiscard]] auto value() const noexcept -> std::optional<value_t> const& { return value_; }
+
+private:
+  void leading_edge() {
+    if (emit_if_changed() && config_.interval > std::chrono::milliseconds{ 0 }) {
+      arm();
+    }
+  }
+
+  void on_expiry() {
+    switch (config_.mode) {
+      case mirror_e::off:
+      case mirror_e::every:
+        return;
+      case mirror_e::on_change:
+        if (std::exchange(pending_, false)) {
+          leading_edge();
+        }
+        return;
+      case mirror_e::periodic:
+        emit();
+        arm();
+        return;
+    }
+  }
+
+  void arm() {
+    armed_ = true;
+    timer_.expires_after(config_.interval);
+    timer_.async_wait([weak_self = this->weak_from_this()](std::error_code const& err) {
+      auto self{ weak_self.lock() };
+      if (err || !self) {
+        return;
+      }
+      self->armed_ = false;
+      self->on_expiry();
+    });
+  }
+
+  void disarm() {
+    armed_ = false;
+    pending_ = false;
+    timer_.cancel();
+  }
+
+  auto emit_if_changed() -> bool {
+    if (!value_.has_value()) {
+      return false;
+    }
+    // clang-format off
+    PRAGMA_CLANG_WARNING_PUSH_OFF(-Wfloat-equal)
+    if (last_emitted_ == value_) {
+    PRAGMA_CLANG_WARNING_POP
+      // clang-format on
+      return false;
+    }
+    emit();
+    return true;
+  }
+
+  void emit() {
+    if (!value_.has_value()) {
+      return;
+    }
+    last_emitted_ = value_;
+    std::invoke(emit_, value_.value());
+  }
+
+  timer_t timer_;
+  emit_t emit_;
+  mirror_config config_{};
+  std::optional<value_t> value_{};
+  std::optional<value_t> last_emitted_{};
+  bool armed_{ false };
+  bool pending_{ false };
+};
+
+/// \brief mirror policies of the signals and slots of a process, one confman config keyed by their names
+/// Signals and slots which are not listed emit every value.
+/// Every process with a signal or slot mirrored on D-Bus therefore owns a confman config object named "Mirror".
+class mirror_settings {
+public:
+  using policies_t = std::map<std::string, mirror_config>;
+  using config_t = tfc::confman::config<tfc::confman::observable<policies_t>>;
+  using callback_t = std::function<void(mirror_config const&)>;
+
+  /// \return the settings shared by every signal and slot on the given connection
+  static auto instance(std::shared_ptr<sdbusplus::asio::connection> const& conn) -> std::shared_ptr<mirror_settings> {
+    static std::mutex mutex{};
+    // clang-format off
+    PRAGMA_CLANG_WARNING_PUSH_OFF(-Wexit-time-destructors)
+    // clang-format on
+    static std::map<sdbusplus::asio::connection const*, std::weak_ptr<mirror_settings>> instances{};
+    PRAGMA_CLANG_WARNING_POP
+    std::scoped_lock const lock{ mutex };
+    std::erase_if(instances, [](auto const& entry) { return entry.second.expired(); });
+    auto& current{ instances[conn.get()] };
+    if (auto existing{ current.lock() }) {
+      return existing;
+    }
+    auto created{ std::make_shared<mirror_settings>(conn) };
+    current = created;
+    return created;
+  }
+
+  explicit mirror_settings(std::shared_ptr<sdbusplus::asio::connection> conn) : config_{ std::move(conn), "Mirror" } {
+    config_.value().observe([this](policies_t const& policies, policies_t const& former) {
+      erase_expired();
+      for (auto const& [name, weak_callback] : subscribers_) {
+        auto const policy{ lookup(policies, name) };
+        if (policy == lookup(former, name)) {
+          continue;
+        }
+        if (auto const callback{ weak_callback.lock() }) {
+          std::invoke(*callback, policy);
+        }
+      }
+    });
+  }
+
+  [[nodiscard]] auto policy(std::string const& name) const -> mirror_config { return lookup(config_.value().value(), name); }
+
+  /// \brief get notified when the policy of name changes, until the returned subscription is dropped
+  [[nodiscard]] auto subscribe(std::string name, callback_t callback) -> std::shared_ptr<callback_t> {
+    auto subscription{ std::make_shared<callback_t>(std::move(callback)) };
+    // dropped subscriptions would otherwise pile up until the config changes
+    erase_expired();
+    subscribers_.emplace_back(std::move(name), subscription);
+    return subscription;
+  }
+
+private:
+  void erase_expired() {
+    std::erase_if(subscribers_, [](auto const& entry) { return entry.second.expired(); });
+  }
+
+  static auto lookup(policies_t const& policies, std::string const& name) -> mirror_config {
+    auto const found{ policies.find(name) };
+    return found == policies.end() ? mirror_config{} : found->second;
+  }
+
+  config_t config_;
+  std::vector<std::pair<std::string, std::weak_ptr<callback_t>>> subscribers_{};
+};
+
 template <typename slot_value_t, ipc_type_e type>
 class dbus_ipc {
 public:
@@ -34,9 +274,24 @@ public:
   std::string const interface_name{ type == ipc_type_e::signal ? dbus::tags::signal_interface : dbus::tags::slot_interface };
 
   explicit dbus_ipc(std::shared_ptr<sdbusplus::asio::connection> conn, std::string_view key)
-      : interface_{
-          std::make_shared<sdbusplus::asio::dbus_interface>(conn, tfc::dbus::make_dbus_path(key), interface_name)
-        } {}
+      : interface_{ std::make_shared<sdbusplus::asio::dbus_interface>(conn,
+                                                                       tfc::dbus::make_dbus_path(key),
+                                                                       interface_name) },
+        mirror_{ std::make_shared<mirror<value_t>>(conn->get_io_context().get_executor(),
+                                                   [interface = interface_](value_t const& value) {
+                                                     auto message = interface->new_signal(dbus::tags::value.data());
+                                                     message.append(value);
+                                                     message.signal_send();
+                                                   }) },
+        settings_{ mirror_settings::instance(conn) } {
+    mirror_->configure(settings_->policy(std::string{ key }));
+    subscription_ =
+        settings_->subscribe(std::string{ key }, [weak_mirror = std::weak_ptr{ mirror_ }](mirror_config const& policy) {
+          if (auto const locked{ weak_mirror.lock() }) {
+            locked->configure(policy);
+          }
+        });
+  }
 
   dbus_ipc(dbus_ipc const&) = delete;
   dbus_ipc(dbus_ipc&&) noexcept = default;
@@ -46,18 +301,17 @@ public:
   void initialize() {
     interface_->register_signal<value_t>(std::string{ dbus::tags::value });
     interface_->register_property_r<value_t>(std::string{ dbus::tags::value }, sdbusplus::vtable::property_::none,
-                                             [this](const auto&) { return value_; });
+                                             [weak_mirror = std::weak_ptr{ mirror_ }](const auto&) {
+                                               auto const locked{ weak_mirror.lock() };
+                                               return locked ? locked->value().value_or(value_t{}) : value_t{};
+                                             });
     interface_->register_property(std::string{ dbus::tags::type }, schema);
 
     interface_->initialize();
   }
 
-  void emit_value(value_t const& value) {
-    value_ = value;
-    auto message = interface_->new_signal(dbus::tags::value.data());
-    message.append(value);
-    message.signal_send();
-  }
+  /// \brief update the Value property and emit the Value signal according to the configured mirror policy
+  void emit_value(value_t const& value) { mirror_->update(value); }
 
   void on_set(tfc::stx::invocable<value_t&&> auto&& callback) {
     interface_->register_method(
@@ -67,8 +321,27 @@ public:
 
 private:
   std::shared_ptr<sdbusplus::asio::dbus_interface> interface_{};
-  value_t value_{};
+  std::shared_ptr<mirror<value_t>> mirror_{};
+  std::shared_ptr<mirror_settings> settings_{};
+  std::shared_ptr<mirror_settings::callback_t> subscription_{};
   std::string const schema{ tfc::json::write_json_schema<value_t>().value() };
 };
 
 }  // namespace tfc::ipc::details
+
+// one entry for every signal and slot of the process
+template <>
+inline constexpr bool
+    tfc::confman::binary_snapshot<tfc::confman::observable<tfc::ipc::details::mirror_settings::policies_t>>{ true };
+
+template <>
+struct glz::meta<tfc::ipc::details::mirror_e> {
+  using enum tfc::ipc::details::mirror_e;
+  static std::string_view constexpr name{ "ipc::mirror_e" };
+  // clang-format off
+  static auto constexpr value{ glz::enumerate("off", off, "Do not emit Value signals",
+                                              "every", every, "Emit every value",
+                                              "on_change", on_change, "Emit changed values, at most one per interval",
+                                              "periodic", periodic, "Emit the latest value once per interval") };
+  // clang-format on
+};
@@ -2,9 +2,15 @@
 
 // ipc-ruler.cpp - Dbus API service maintaining a list of signals/slots and which signal
 // is connected to which slot
+#include <deque>
 #include <filesystem>
 #include <functional>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include <fmt/chrono.h>
 #include <fmt/format.h>
@@ -39,65 +45,131 @@ inline std::string config_file_name_populate_dir() {
   return file.string();
 }
 
+/// \brief entries kept in registration order and indexed by name
+template <typename entry_t>
+class registry {
+public:
+  [[nodiscard]] auto find(std::string_view name) -> entry_t* {
+    auto const found{ index_.find(name) };
+    return found == index_.end() ? nullptr : &entries_[found->second];
+  }
+
+  [[nodiscard]] auto find(std::string_view name) const -> entry_t const* {
+    auto const found{ index_.find(name) };
+    return found == index_.end() ? nullptr : &entries_[found->second];
+  }
+
+  [[nodiscard]] auto contains(std::string_view name) const -> bool { return index_.contains(name); }
+
+  /// \brief append entry, or replace the entry of the same name in its place
+  auto insert_or_assign(entry_t&& entry) -> entry_t& {
+    auto const [found, inserted]{ index_.try_emplace(entry.name, entries_.size()) };
+    if (inserted) {
+      return entries_.emplace_back(std::move(entry));
+    }
+    return entries_[found->second] = std::move(entry);
+  }
+
+  /// \return entries in the order they were first registered
+  [[nodiscard]] auto entries() const noexcept -> std::vector<entry_t> const& { return entries_; }
+
+private:
+  std::vector<entry_t> entries_{};
+  std::map<std::string, std::size_t, std::less<>> index_{};
+};
+
 /**
  * A class exposing methods for managing signals and slots
+ * The registry is kept in memory and every change is written through to the sqlite database,
+ * which is only read when the manager is constructed.
  */
 class ipc_manager {
 public:
   using slot_name = std::string_view;
   using signal_name = std::string_view;
 
-  explicit ipc_manager(bool in_memory = false) : db_(in_memory ? ":memory:" : config_file_name_populate_dir()) {
-    db_ << R"(
-          CREATE TABLE IF NOT EXISTS signals(
-              name TEXT,
-              type INT,
-              created_by TEXT,
-              created_at LONG INTEGER,
-              time_point_t LONG INTEGER,
-              last_registered LONG INTEGER,
-              description TEXT);
-             )";
-    db_ << R"(
-          CREATE TABLE IF NOT EXISTS slots(
-              name TEXT,
-              type INT,
-              created_by TEXT,
-              created_at LONG INTEGER,
-              last_registered LONG INTEGER,
-              last_modified INTEGER,
-              modified_by TEXT,
-              connected_to TEXT,
-              time_point_t LONG INTEGER,
-              description TEXT);
-             )";
+  explicit ipc_manager(bool in_memory = false)
+      : db_{ open_database(in_memory) },
+        insert_signal_{ prepare(db_,
+                                "INSERT INTO signals (name, type, created_by, created_at, last_registered, description) "
+                                "VALUES (?,?,?,?,?,?);") },
+        update_signal_{ prepare(
+            db_,
+            "UPDATE signals SET last_registered = ?, description = ?, type = ?, created_by = ? WHERE name = ?;") },
+        insert_slot_{ prepare(db_,
+                              "INSERT INTO slots (name, type, created_by, created_at, last_registered, last_modified, "
+                              "description) VALUES (?,?,?,?,?,?,?);") },
+        update_slot_{ prepare(
+            db_,
+            "UPDATE slots SET last_registered = ?, description = ?, type = ?, created_by = ? WHERE name = ?;") },
+        connect_slot_{ prepare(db_, "UPDATE slots SET connected_to = ? WHERE name = ?;") } {
+    load();
   }
 
+  /// \brief number of changes kept for `changes_since`, older readers need to fetch everything again
+  static constexpr std::size_t change_log_capacity{ 4096 };
+
   auto set_callback(std::function<void(slot_name, signal_name)> on_connect_cb) -> void {
     on_connect_cb_ = std::move(on_connect_cb);
   }
 
+  /// \brief set callback invoked with each entry appended to the change feed
+  auto set_change_callback(std::function<void(change const&)> on_change_cb) -> void {
+    on_change_cb_ = std::move(on_change_cb);
+  }
+
+  /// \return sequence number of the latest change, 0 if nothing has changed since construction
+  [[nodiscard]] auto sequence() const noexcept -> std::uint64_t { return sequence_; }
+
+  /// \return changes after `sequence` in order, or nullopt if they are no longer retained
+  [[nodiscard]] auto changes_since(std::uint64_t sequence) const -> std::optional<std::vector<change>> {
+    if (sequence > sequence_) {
+      // the reader has seen a sequence of a former ipc-ruler instance
+      return std::nullopt;
+    }
+    if (sequence == sequence_) {
+      return std::vector<change>{};
+    }
+    if (change_log_.empty() || change_log_.front().sequence > sequence + 1) {
+      return std::nullopt;
+    }
+    auto const skip{ static_cast<std::ptrdiff_t>(sequence + 1 - change_log_.front().sequence) };
+    return std::vector<change>{ std::next(change_log_.begin(), skip), change_log_.end() };
+  }
+
+  [[nodiscard]] auto find_slot(std::string_view name) const -> std::optional<slot> {
+    if (auto const* found{ slots_.find(name) }; found != nullptr) {
+      return *found;
+    }
+    return std::nullopt;
+  }
+
   auto register_signal(std::string_view sender, const std::string_view name, const std::string_view description, type_e type)
       -> void {
     logger_.trace("register_signal called name: {}, type: {}", name, enum_name(type));
     auto timestamp_now = std::chrono::time_point_cast<std::chrono::milliseconds>(std::chrono::system_clock::now());
 
     try {
-      // Check if signal exists
-      int count = 0;
-      db_ << "SELECT count(*) FROM signals WHERE name = ?;" << std::string(name) >> count;
-      if (count != 0) {
+      if (auto* const found{ signals_.find(name) }; found != nullptr) {
         // update the signal
-        db_ << fmt::format(
-            "UPDATE signals SET last_registered = {}, description = '{}', type = {}, created_by = '{}'  WHERE name = '{}';",
-            timestamp_now.time_since_epoch().count(), description, static_cast<std::uint8_t>(type), sender, name);
+        update_signal_ << count_of(timestamp_now) << std::string{ description } << static_cast<int>(type)
+                       << std::string{ sender } << std::string{ name };
+        update_signal_.execute();
+        auto& existing{ *found };
+        existing.last_registered = timestamp_now;
+        existing.description = description;
+        existing.type = type;
+        existing.created_by = sender;
+        record(change_e::changed, existing);
       } else {
         // Insert the signal
-        db_ << fmt::format(
-            "INSERT INTO signals (name, type, created_by, created_at, last_registered, description) VALUES "
-            "('{}',{},'{}',{},{},'{}');",
-            name, static_cast<std::uint8_t>(type), sender, timestamp_now.time_since_epoch().count(),
-            timestamp_now.time_since_epoch().count(), description);
+        insert_signal_ << std::string{ name } << static_cast<int>(type) << std::string{ sender } << count_of(timestamp_now)
+                       << count_of(timestamp_now) << std::string{ description };
+        insert_signal_.execute();
+        auto const& inserted{ signals_.insert_or_assign(signal{ std::string{ name }, type, std::string{ sender },
+                                                                timestamp_now, timestamp_now,
+                                                                std::string{ description } }) };
+        record(change_e::added, inserted);
       }
     } catch (const std::exception& e) {
       logger_.error(e.what());
@@ -112,27 +184,28 @@ public:
 
     // Call the connected callback to get the slot connected to its signal if it has one.
     try {
-      // Check if signal exists
-
-      std::string connected_to = "";
-      bool found = false;
-      db_ << "SELECT connected_to FROM slots WHERE name = ?;" << std::string(name) >>
-          [&connected_to, &found](const std::string& result) {
-            connected_to = result;
-            found = true;
-          };
-      if (found) {
-        // update the signal
-        db_ << fmt::format(
-            "UPDATE slots SET last_registered = {}, description = '{}', type = {}, created_by = '{}'  WHERE name = '{}';",
-            timestamp_now.time_since_epoch().count(), description, static_cast<std::uint8_t>(type), sender, name);
+      std::string connected_to{};
+      if (auto* const found{ slots_.find(name) }; found != nullptr) {
+        // update the slot
+        update_slot_ << count_of(timestamp_now) << std::string{ description } << static_cast<int>(type)
+                     << std::string{ sender } << std::string{ name };
+        update_slot_.execute();
+        auto& existing{ *found };
+        existing.last_registered = timestamp_now;
+        existing.description = description;
+        existing.type = type;
+        existing.created_by = sender;
+        connected_to = existing.connected_to;
+        record(change_e::changed, existing);
       } else {
-        // Insert the signal
-        db_ << fmt::format(
-            "INSERT INTO slots (name, type, created_by, created_at, last_registered, last_modified, description) VALUES "
-            "('{}',{},'{}',{},{},{},'{}');",
-            name, static_cast<std::uint8_t>(type), sender, timestamp_now.time_since_epoch().count(),
-            timestamp_now.time_since_epoch().count(), timestamp_never.time_since_epoch().count(), description);
+        // Insert the slot
+        insert_slot_ << std::string{ name } << static_cast<int>(type) << std::string{ sender } << count_of(timestamp_now)
+                     << count_of(timestamp_now) << count_of(timestamp_never) << std::string{ description };
+        insert_slot_.execute();
+        auto const& inserted{ slots_.insert_or_assign(slot{ std::string{ name }, type, std::string{ sender }, timestamp_now,
+                                                            timestamp_now, timestamp_never, "", "",
+                                                            std::string{ description } }) };
+        record(change_e::added, inserted);
       }
 
       on_connect_cb_(name, connected_to);
@@ -141,78 +214,54 @@ public:
     }
   }
 
+  /// \return signals in registration order
   auto get_all_signals() -> std::vector<signal> {
     logger_.trace("get_all_signals called");
-    std::vector<signal> ret;
-    db_ << "SELECT name, type, last_registered, description, created_at, created_by FROM signals" >>
-        [&ret](const std::string& name, const int type, const std::uint64_t last_registered, const std::string& description,
-               const std::uint64_t created_at, const std::string& created_by) {
-          using std::chrono::milliseconds;
-          const auto last_reg = time_point_t(milliseconds(last_registered));
-          const auto cre_at = time_point_t(milliseconds(created_at));
-          ret.emplace_back(signal{ name, static_cast<type_e>(type), created_by, cre_at, last_reg, description });
-        };
-    return ret;
+    return signals_.entries();
   }
 
+  /// \return slots in registration order
   auto get_all_slots() -> std::vector<slot> {
     logger_.trace("get_all_slots called");
-    std::vector<slot> ret;
-    db_ << "SELECT name, type, last_registered, description, created_at, created_by, last_modified, modified_by, "
-           "connected_to FROM slots" >>
-        [&ret](const std::string& name, const int type, const std::uint64_t last_registered, const std::string& description,
-               const std::uint64_t created_at, const std::string& created_by, const std::uint64_t last_modified,
-               const std::string& modified_by, const std::string& connected_to) {
-          using std::chrono::milliseconds;
-          const auto last_reg = time_point_t(milliseconds(last_registered));
-          const auto cre_at = time_point_t(milliseconds(created_at));
-          const auto last_mod = time_point_t(milliseconds(last_modified));
-          ret.emplace_back(slot{ name, static_cast<type_e>(type), created_by, cre_at, last_reg, last_mod, modified_by,
-                                 connected_to, description });
-        };
-    return ret;
+    return slots_.entries();
   }
 
   auto get_all_connections() -> std::map<std::string, std::vector<std::string>> {
     std::map<std::string, std::vector<std::string>> connections;
-    db_ << "SELECT signals.name, slots.name FROM signals JOIN slots ON signals.name = slots.connected_to;" >>
-        [&connections](const std::string& signal_name, const std::string& slot_name) {
-          connections[signal_name].emplace_back(slot_name);
-        };
+    for (auto const& [signal_name, slot_names] : connections_) {
+      if (slot_names.empty() || !signals_.contains(signal_name)) {
+        continue;
+      }
+      connections.emplace(signal_name, std::vector<std::string>{ slot_names.begin(), slot_names.end() });
+    }
     return connections;
   }
 
   auto connect(const std::string_view slot_name, const std::string_view signal_name) -> void {
     try {
       logger_.trace("connect called, slot: {}, signal: {}", slot_name, signal_name);
-      int slot_count = 0;
-      db_ << "SELECT count(*) FROM slots WHERE name = ?;" << std::string(slot_name) >> slot_count;
-      if (slot_count == 0) {
+      auto* const slot_entry{ slots_.find(slot_name) };
+      if (slot_entry == nullptr) {
         std::string const err_msg = fmt::format("Slot ({}) does not exist", slot_name);
         logger_.warn(err_msg);
         throw dbus_error(err_msg);
       }
-      int signal_count = 0;
-      db_ << "SELECT count(*) FROM signals WHERE name = ?;" << std::string(signal_name) >> signal_count;
-      if (signal_count == 0) {
+      auto const* const signal_entry{ signals_.find(signal_name) };
+      if (signal_entry == nullptr) {
         std::string const err_msg = fmt::format("Signal ({}) does not exist", signal_name);
         logger_.warn(err_msg);
         throw dbus_error(err_msg);
       }
 
-      int signal_type = 0;
-      db_ << fmt::format("SELECT type FROM signals WHERE name = '{}' LIMIT 1;", signal_name) >>
-          [&signal_type](const int result) { signal_type = result; };
-      int slot_type = 0;
-      db_ << fmt::format("SELECT type FROM slots WHERE name = '{}' LIMIT 1;", slot_name) >>
-          [&slot_type](const int result) { slot_type = result; };
+      auto const signal_type{ static_cast<int>(signal_entry->type) };
+      auto const slot_type{ static_cast<int>(slot_entry->type) };
       if (signal_type != slot_type) {
         std::string const err_msg = fmt::format("Signal: {} and slot: {}, types dont match", signal_type, slot_type);
         logger_.warn(err_msg);
         throw dbus_error(err_msg);
       }
 
-      db_ << fmt::format("UPDATE slots SET connected_to = '{}' WHERE name = '{}';", signal_name, slot_name);
+      set_connection(*slot_entry, signal_name);
       on_connect_cb_(slot_name, signal_name);
     } catch (const std::exception& e) {
       logger_.warn(e.what());
@@ -222,12 +271,11 @@ public:
   auto disconnect(const std::string_view slot_name) -> void {
     logger_.trace("disconnect called, slot: {}", slot_name);
     try {
-      int slot_count = 0;
-      db_ << "SELECT count(*) FROM slots WHERE name = ?;" << std::string(slot_name) >> slot_count;
-      if (slot_count == 0) {
+      auto* const slot_entry{ slots_.find(slot_name) };
+      if (slot_entry == nullptr) {
         throw std::runtime_error("Slot does not exist");
       }
-      db_ << fmt::format("UPDATE slots SET connected_to = '' WHERE name = '{}';", slot_name);
+      set_connection(*slot_entry, "");
       on_connect_cb_(slot_name, "");
     } catch (const std::exception& e) {
       logger_.warn(e.what());
@@ -235,9 +283,121 @@ public:
   }
 
 private:
+  static auto open_database(bool in_memory) -> sqlite::database {
+    sqlite::database db{ in_memory ? ":memory:" : config_file_name_populate_dir() };
+    // Registrations arrive in bursts when a cell boots, each of them is its own transaction.
+    // Write ahead logging with normal synchronous mode makes these commits cheap while staying crash safe.
+    db << "PRAGMA journal_mode=WAL;" >> [](std::string const&) {};
+    db << "PRAGMA synchronous=NORMAL;";
+    db << R"(
+          CREATE TABLE IF NOT EXISTS signals(
+              name TEXT,
+              type INT,
+              created_by TEXT,
+              created_at LONG INTEGER,
+              time_point_t LONG INTEGER,
+              last_registered LONG INTEGER,
+              description TEXT);
+             )";
+    db << R"(
+          CREATE TABLE IF NOT EXISTS slots(
+              name TEXT,
+              type INT,
+              created_by TEXT,
+              created_at LONG INTEGER,
+              last_registered LONG INTEGER,
+              last_modified INTEGER,
+              modified_by TEXT,
+              connected_to TEXT,
+              time_point_t LONG INTEGER,
+              description TEXT);
+             )";
+    db << "CREATE INDEX IF NOT EXISTS signals_name ON signals(name);";
+    db << "CREATE INDEX IF NOT EXISTS slots_name ON slots(name);";
+    db << "CREATE INDEX IF NOT EXISTS slots_connected_to ON slots(connected_to);";
+    return db;
+  }
+
+  static auto prepare(sqlite::database& db, std::string const& statement) -> sqlite::database_binder {
+    auto prepared{ db << statement };
+    // a prepared statement which has not been used is executed on destruction
+    prepared.used(true);
+    return prepared;
+  }
+
+  static auto count_of(time_point_t time_point) noexcept -> sqlite_int64 { return time_point.time_since_epoch().count(); }
+
+  void load() {
+    using std::chrono::milliseconds;
+    db_ << "SELECT name, type, last_registered, description, created_at, created_by FROM signals" >>
+        [this](const std::string& name, const int type, const std::uint64_t last_registered, const std::string& description,
+               const std::uint64_t created_at, const std::string& created_by) {
+          const auto last_reg = time_point_t(milliseconds(last_registered));
+          const auto cre_at = time_point_t(milliseconds(created_at));
+          signals_.insert_or_assign(signal{ name, static_cast<type_e>(type), created_by, cre_at, last_reg, description });
+        };
+    db_ << "SELECT name, type, last_registered, description, created_at, created_by, last_modified, modified_by, "
+           "connected_to FROM slots" >>
+        [this](const std::string& name, const int type, const std::uint64_t last_registered, const std::string& description,
+               const std::uint64_t created_at, const std::string& created_by, const std::uint64_t last_modified,
+               const std::string& modified_by, const std::string& connected_to) {
+          const auto last_reg = time_point_t(milliseconds(last_registered));
+          const auto cre_at = time_point_t(milliseconds(created_at));
+          const auto last_mod = time_point_t(milliseconds(last_modified));
+          slots_.insert_or_assign(slot{ name, static_cast<type_e>(type), created_by, cre_at, last_reg, last_mod, modified_by,
+                                        connected_to, description });
+          if (!connected_to.empty()) {
+            connections_[connected_to].emplace(name);
+          }
+        };
+  }
+
+  void set_connection(slot& entry, std::string_view signal_name) {
+    connect_slot_ << std::string{ signal_name } << entry.name;
+    connect_slot_.execute();
+    if (auto const previous{ connections_.find(entry.connected_to) }; previous != connections_.end()) {
+      previous->second.erase(entry.name);
+      if (previous->second.empty()) {
+        connections_.erase(previous);
+      }
+    }
+    entry.connected_to = signal_name;
+    if (!signal_name.empty()) {
+      connections_[entry.connected_to].emplace(entry.name);
+    }
+    record(change_e::changed, entry);
+  }
+
+  void record(change_e kind, signal const& entry) { record(change{ .kind = kind, .signal_entry = entry }); }
+
+  void record(change_e kind, slot const& entry) { record(change{ .kind = kind, .slot_entry = entry }); }
+
+  void record(change&& entry) {
+    entry.sequence = ++sequence_;
+    if (change_log_.size() == change_log_capacity) {
+      change_log_.pop_front();
+    }
+    change_log_.emplace_back(std::move(entry));
+    if (on_change_cb_) {
+      on_change_cb_(change_log_.back());
+    }
+  }
+
   logger::logger logger_{ "ipc-manager" };
   sqlite::database db_;
+  sqlite::database_binder insert_signal_;
+  sqlite::database_binder update_signal_;
+  sqlite::database_binder insert_slot_;
+  sqlite::database_binder update_slot_;
+  sqlite::database_binder connect_slot_;
+  registry<signal> signals_{};
+  registry<slot> slots_{};
+  // signal name -> names of the slots connected to it
+  std::map<std::string, std::set<std::string, std::less<>>, std::less<>> connections_{};
   std::function<void(std::string_view, std::string_view)> on_connect_cb_;
+  std::function<void(change const&)> on_change_cb_;
+  std::uint64_t sequence_{};
+  std::deque<change> change_log_{};
 };
 
 class ipc_manager_server {
@@ -251,10 +411,25 @@ public:
         object_server_->add_unique_interface(consts::ipc_ruler_object_path.data(), consts::ipc_ruler_interface_name.data());
 
     ipc_manager_->set_callback([&](std::string_view slot_name, std::string_view signal_name) {
+      // Only the process owning the slot is interested in its connection
+      auto const owner{ ipc_manager_->find_slot(slot_name).transform([](slot const& entry) { return entry.created_by; }) };
       auto message = dbus_interface_->new_signal(consts::connection_change.data());
+      if (owner.has_value() && !owner->empty()) {
+        sd_bus_message_set_destination(message.get(), owner->c_str());
+      }
       message.append(std::tuple<std::string, std::string>(slot_name, signal_name));
       message.signal_send();
     });
+    ipc_manager_->set_change_callback([&](change const& entry) {
+      auto const write{ glz::write_json(entry) };
+      if (!write) {
+        fmt::println(stderr, "Failed to write change to json: {}", format_error(write.error()));
+        return;
+      }
+      auto message = dbus_interface_->new_signal(consts::changes_signal.data());
+      message.append(std::tuple<std::uint64_t, std::string>(entry.sequence, write.value()));
+      message.signal_send();
+    });
     dbus_interface_->register_method(std::string(consts::connect_method),
                                      [&](const std::string& slot_name, const std::string& signal_name) {
                                        ipc_manager_->connect(slot_name, signal_name);
@@ -281,8 +456,21 @@ public:
           dbus_interface_->signal_property(std::string(consts::slots_property));
         });
 
+    dbus_interface_->register_method(std::string(consts::changes_since_method), [&](std::uint64_t sequence) {
+      auto const changes{ ipc_manager_->changes_since(sequence) };
+      if (!changes.has_value()) {
+        throw dbus_error(fmt::format("Changes since {} are no longer available, fetch the properties", sequence));
+      }
+      auto const write{ glz::write_json(changes.value()) };
+      if (!write) {
+        throw dbus_error("Failed to write changes to json");
+      }
+      return write.value();
+    });
+
+    // The properties are large, changes only invalidate them, readers fetch them on demand or follow the Changes signal
     dbus_interface_->register_property_r<std::string>(
-        std::string(consts::signals_property), sdbusplus::vtable::property_::emits_change, [&](const auto&) {
+        std::string(consts::signals_property), sdbusplus::vtable::property_::emits_invalidation, [&](const auto&) {
           auto const write{ glz::write_json(ipc_manager_->get_all_signals()) };
           if (!write) {
             fmt::println(stderr, "Failed to write signals to json: {}", format_error(write.error()));
@@ -292,7 +480,7 @@ public:
         });
 
     dbus_interface_->register_property_r<std::string>(
-        std::string(consts::slots_property), sdbusplus::vtable::property_::emits_change, [&](const auto&) {
+        std::string(consts::slots_property), sdbusplus::vtable::property_::emits_invalidation, [&](const auto&) {
           auto const write{ glz::write_json(ipc_manager_->get_all_slots()) };
           if (!write) {
             fmt::println(stderr, "Failed to write slots to json: {}", format_error(write.error()));
@@ -302,7 +490,7 @@ public:
         });
 
     dbus_interface_->register_property_r<std::string>(
-        std::string(consts::connections_property), sdbusplus::vtable::property_::emits_change, [&](const auto&) {
+        std::string(consts::connections_property), sdbusplus::vtable::property_::emits_invalidation, [&](const auto&) {
           auto const write{ glz::write_json(ipc_manager_->get_all_connections()) };
           if (!write) {
             fmt::println(stderr, "Failed to write connections to json: {}", format_error(write.error()));
@@ -311,7 +499,12 @@ public:
           return write.value();
         });
 
+    dbus_interface_->register_property_r<std::uint64_t>(std::string(consts::sequence_property),
+                                                        sdbusplus::vtable::property_::none,
+                                                        [&](const auto&) { return ipc_manager_->sequence(); });
+
     dbus_interface_->register_signal<std::tuple<std::string, std::string>>("");
+    dbus_interface_->register_signal<std::tuple<std::uint64_t, std::string>>(std::string(consts::changes_signal));
     dbus_interface_->initialize();
   }
 
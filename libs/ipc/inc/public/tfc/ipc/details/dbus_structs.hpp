@@ -1,6 +1,8 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
+#include <optional>
 #include <string>
 
 #include <tfc/ipc/enums.hpp>
@@ -30,4 +32,18 @@ struct slot {
   std::string description;
 };
 
+/// \note the ipc-ruler never forgets a signal or slot, so there is no removal
+enum struct change_e : std::uint8_t {
+  added = 0,
+  changed,  // includes connecting and disconnecting a slot
+};
+
+/// \brief entry of the ipc-ruler change feed, exactly one of signal_entry and slot_entry is set
+struct change {
+  std::uint64_t sequence{};
+  change_e kind{};
+  std::optional<signal> signal_entry{};
+  std::optional<slot> slot_entry{};
+};
+
 }  // namespace tfc::ipc_ruler
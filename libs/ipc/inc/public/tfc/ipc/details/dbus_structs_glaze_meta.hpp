@@ -37,3 +37,23 @@ struct glz::meta<tfc::ipc_ruler::slot> {
   // clang-format on
   static constexpr std::string_view name{ "slot" };
 };
+
+template <>
+struct glz::meta<tfc::ipc_ruler::change_e> {
+  using enum tfc::ipc_ruler::change_e;
+  static constexpr auto value{ glz::enumerate("added", added, "changed", changed) };
+  static constexpr std::string_view name{ "change_e" };
+};
+
+template <>
+struct glz::meta<tfc::ipc_ruler::change> {
+  using change = tfc::ipc_ruler::change;
+  // clang-format off
+  static constexpr auto value{ glz::object(
+      "sequence", &change::sequence,
+      "kind", &change::kind,
+      "signal", &change::signal_entry,
+      "slot", &change::slot_entry) };
+  // clang-format on
+  static constexpr std::string_view name{ "change" };
+};
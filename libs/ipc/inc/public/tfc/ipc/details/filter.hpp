@@ -1,6 +1,14 @@
 #pragma once
+#include <algorithm>
+#include <cmath>
 #include <concepts>
+#include <cstddef>
 #include <expected>
+#include <memory>
+#include <optional>
+#include <set>
+#include <span>
+#include <variant>
 #include <vector>
 
 #include <boost/asio/async_result.hpp>
@@ -31,7 +39,6 @@ enum struct filter_e : std::uint8_t {
   multiply,
   filter_out,
   // https://esphome.io/components/sensor/index.html#sensor-filters
-  // todo: make the below filters
   calibrate_linear,  // https://github.com/esphome/esphome/blob/v1.20.4/esphome/components/sensor/__init__.py#L594
   median,
   quantile,
@@ -40,6 +47,7 @@ enum struct filter_e : std::uint8_t {
   throttle,
   throttle_average,
   delta,
+  // todo: make the below filters
   lambda,
   tfc_item,  // according to item json schema see ipc/item.hpp, TODO: implement
 };
@@ -47,17 +55,196 @@ enum struct filter_e : std::uint8_t {
 template <filter_e type, typename value_t, typename...>
 struct filter;
 
+namespace detail {
+
+/// \brief numerical view of the value types which the stateful filters operate on
+template <typename value_t>
+struct sample;
+
+template <typename value_t>
+  requires requires { requires(std::integral<value_t> || std::floating_point<value_t>) && !std::same_as<value_t, bool>; }
+struct sample<value_t> {
+  using rep = value_t;
+  using difference_t = value_t;
+  static constexpr auto valid(value_t const&) noexcept -> bool { return true; }
+  static constexpr auto get(value_t const& value) noexcept -> rep { return value; }
+  static constexpr auto make(rep value) noexcept -> value_t { return value; }
+  static constexpr auto magnitude(difference_t value) noexcept -> rep { return value; }
+};
+
+/// \brief quantities carrying an error are not samples, they pass the stateful filters untouched
+template <details::concepts::is_expected_quantity value_t>
+struct sample<value_t> {
+  using difference_t = typename value_t::value_type;
+  using rep = typename difference_t::rep;
+  static constexpr auto valid(value_t const& value) noexcept -> bool { return value.has_value(); }
+  static constexpr auto get(value_t const& value) noexcept -> rep {
+    return value.value().numerical_value_in(difference_t::unit);
+  }
+  static constexpr auto make(rep value) noexcept -> value_t { return difference_t{ value * difference_t::reference }; }
+  static constexpr auto magnitude(difference_t value) noexcept -> rep {
+    return value.numerical_value_in(difference_t::unit);
+  }
+};
+
+template <typename value_t>
+concept sampled = requires { typename sample<value_t>::rep; };
+
+/// \brief filters which have their result at hand when called, the pipeline runs these inline
+template <typename filter_t, typename value_t>
+concept synchronous_filter = requires(filter_t const& filt, value_t&& value) {
+  { filt.process(std::move(value)) } -> std::same_as<std::expected<value_t, std::error_code>>;
+};
+
+/// \brief convert an average or a weighted value back to the representation of the sample
+template <typename rep_t>
+constexpr auto round_to(std::double_t value) noexcept -> rep_t {
+  if constexpr (std::floating_point<rep_t>) {
+    return static_cast<rep_t>(value);
+  } else {
+    return static_cast<rep_t>(std::llround(value));
+  }
+}
+
+/// \brief complete the token with the outcome of a filter which does not need to wait for anything
+template <typename value_t>
+auto async_complete(std::expected<value_t, std::error_code>&& result, auto&& completion_token) {
+  auto executor{ asio::get_associated_executor(completion_token) };
+  return asio::async_compose<decltype(completion_token), void(std::expected<value_t, std::error_code>)>(
+      [moved_result = std::move(result)](auto& self) mutable { self.complete(std::move(moved_result)); },
+      completion_token, executor);
+}
+
+/// \return error used by filters to drop a value
+inline auto dropped() -> std::unexpected<std::error_code> {
+  return std::unexpected(std::make_error_code(std::errc::bad_message));
+}
+
+/// \brief ring of the most recent samples, memory is allocated once per capacity change
+template <typename rep_t>
+class ring_window {
+public:
+  /// \brief change capacity, the window is emptied if the capacity changes
+  /// \return true if the window was emptied
+  auto resize(std::size_t capacity) -> bool {
+    capacity = std::max<std::size_t>(capacity, 1);
+    if (capacity == samples_.size()) {
+      return false;
+    }
+    samples_.assign(capacity, rep_t{});
+    head_ = 0;
+    size_ = 0;
+    return true;
+  }
+
+  /// \return the oldest sample when it was evicted to make room for the new one
+  auto push(rep_t value) noexcept -> std::optional<rep_t> {
+    std::optional<rep_t> evicted{};
+    if (size_ == samples_.size()) {
+      evicted = samples_[head_];
+    } else {
+      size_++;
+    }
+    samples_[head_] = value;
+    head_ = (head_ + 1) % samples_.size();
+    return evicted;
+  }
+
+  /// \return samples currently in the window, in no particular order
+  [[nodiscard]] auto samples() const noexcept -> std::span<rep_t const> { return { samples_.data(), size_ }; }
+
+  /// \return true when the next push overwrites the first slot of the ring
+  [[nodiscard]] auto wrapped() const noexcept -> bool { return head_ == 0 && size_ == samples_.size(); }
+
+private:
+  std::vector<rep_t> samples_{};
+  std::size_t head_{};
+  std::size_t size_{};
+};
+
+/// \brief ring of the most recent samples kept partitioned around the requested quantile, for order statistics
+/// The samples are split into two ordered sets, the lower one holding the samples up to and including the quantile.
+/// A push moves the node of the evicted sample to the new sample, so memory is only allocated while the window fills.
+/// Push and lookup are logarithmic in the window size, as long as the quantile asked for does not change.
+template <typename rep_t>
+class sorted_window {
+public:
+  void resize(std::size_t capacity) {
+    if (ring_.resize(capacity)) {
+      lower_.clear();
+      upper_.clear();
+    }
+  }
+
+  void push(rep_t value) {
+    auto const evicted{ ring_.push(value) };
+    if (!evicted) {
+      side(value).insert(value);
+      return;
+    }
+    auto& from{ side(evicted.value()) };
+    auto node{ from.extract(from.find(evicted.value())) };
+    node.value() = value;
+    side(value).insert(std::move(node));
+  }
+
+  /// \param quantile in the range [0, 1], 0.5 being the median
+  /// \return the sample at the quantile, nullopt while the window holds no samples
+  [[nodiscard]] auto at(std::double_t quantile) -> std::optional<rep_t> {
+    auto const size{ lower_.size() + upper_.size() };
+    if (size == 0) {
+      return std::nullopt;
+    }
+    auto const count{ static_cast<std::double_t>(size) };
+    auto const index{ static_cast<std::size_t>(std::max(std::ceil(std::clamp(quantile, 0.0, 1.0) * count) - 1.0, 0.0)) };
+    auto const rank{ std::min(index, size - 1) + 1 };
+    while (lower_.size() > rank) {
+      upper_.insert(lower_.extract(std::prev(lower_.end())));
+    }
+    while (lower_.size() < rank) {
+      lower_.insert(upper_.extract(upper_.begin()));
+    }
+    return *lower_.rbegin();
+  }
+
+private:
+  /// \return the set which holds, or is to hold, the given sample
+  auto side(rep_t value) noexcept -> std::multiset<rep_t>& {
+    return !lower_.empty() && !(*lower_.rbegin() < value) ? lower_ : upper_;
+  }
+
+  ring_window<rep_t> ring_{};
+  std::multiset<rep_t> lower_{};
+  std::multiset<rep_t> upper_{};
+};
+
+/// \brief let every n-th value through
+class decimator {
+public:
+  [[nodiscard]] auto pass(std::size_t every) noexcept -> bool {
+    if (++count_ < std::max<std::size_t>(every, 1)) {
+      return false;
+    }
+    count_ = 0;
+    return true;
+  }
+
+private:
+  std::size_t count_{};
+};
+
+}  // namespace detail
+
 /// \brief behaviour flip the state of boolean
 template <>
 struct filter<filter_e::invert, bool> {
   static constexpr filter_e const_value{ filter_e::invert };
   constexpr auto operator==(filter const&) const noexcept -> bool = default;
 
+  auto process(bool&& value) const -> std::expected<bool, std::error_code> { return !value; }
+
   auto async_process(bool&& value, auto&& completion_token) const {
-    // todo can we get a compile error if executor is non-existent?
-    auto exe = asio::get_associated_executor(completion_token);
-    return asio::async_compose<decltype(completion_token), void(std::expected<bool, std::error_code>)>(
-        [copy = value](auto& self) { self.complete(!copy); }, completion_token, exe);
+    return detail::async_complete(process(std::move(value)), std::forward<decltype(completion_token)>(completion_token));
   }
 
   struct glaze {
@@ -160,14 +347,10 @@ struct filter<filter_e::offset, value_t> {
   constexpr auto operator==(filter const&) const noexcept -> bool = default;
   PRAGMA_CLANG_WARNING_POP
 
+  auto process(value_t&& value) const -> std::expected<value_t, std::error_code> { return value + offset; }
+
   auto async_process(value_t&& value, auto&& completion_token) const {
-    // todo can we get a compile error if executor is non-existent?
-    auto exe = asio::get_associated_executor(completion_token);
-    return asio::async_compose<decltype(completion_token), void(std::expected<value_t, std::error_code>)>(
-        [this, copy = value](auto& self) {
-          self.complete(copy + offset);  //
-        },
-        completion_token, exe);
+    return detail::async_complete(process(std::move(value)), std::forward<decltype(completion_token)>(completion_token));
   }
 
   struct glaze {
@@ -188,14 +371,10 @@ struct filter<filter_e::multiply, value_t> {
   constexpr auto operator==(filter const&) const noexcept -> bool = default;
   PRAGMA_CLANG_WARNING_POP
 
+  auto process(value_t&& value) const -> std::expected<value_t, std::error_code> { return value * multiply; }
+
   auto async_process(value_t&& value, auto&& completion_token) const {
-    // todo can we get a compile error if executor is non-existent?
-    auto exe = asio::get_associated_executor(completion_token);
-    return asio::async_compose<decltype(completion_token), void(std::expected<value_t, std::error_code>)>(
-        [this, copy = value](auto& self) {
-          self.complete(copy * multiply);  //
-        },
-        completion_token, exe);
+    return detail::async_complete(process(std::move(value)), std::forward<decltype(completion_token)>(completion_token));
   }
 
   struct glaze {
@@ -215,22 +394,20 @@ struct filter<filter_e::filter_out, value_t> {
   constexpr auto operator==(filter const&) const noexcept -> bool = default;
   PRAGMA_CLANG_WARNING_POP
 
+  auto process(value_t&& value) const -> std::expected<value_t, std::error_code> {
+    // Todo should this filter be available for double?
+    // clang-format off
+    PRAGMA_CLANG_WARNING_PUSH_OFF(-Wfloat-equal)
+    if (value == filter_out) {
+    PRAGMA_CLANG_WARNING_POP
+      // clang-format on
+      return detail::dropped();
+    }
+    return std::move(value);
+  }
+
   auto async_process(value_t&& value, auto&& completion_token) const {
-    auto executor{ asio::get_associated_executor(completion_token) };
-    return asio::async_compose<decltype(completion_token), void(std::expected<value_t, std::error_code>)>(
-        [this, moved_value = std::move(value)](auto& self) {
-          // Todo should this filter be available for double?
-          // clang-format off
-          PRAGMA_CLANG_WARNING_PUSH_OFF(-Wfloat-equal)
-          if (moved_value == filter_out) {
-          PRAGMA_CLANG_WARNING_POP
-            // clang-format on
-            self.complete(std::unexpected(std::make_error_code(std::errc::bad_message)));
-          } else {
-            self.complete(moved_value);
-          }
-        },
-        completion_token, executor);
+    return detail::async_complete(process(std::move(value)), std::forward<decltype(completion_token)>(completion_token));
   }
 
   struct glaze {
@@ -242,70 +419,591 @@ struct filter<filter_e::filter_out, value_t> {
   };
 };
 
+/// \brief behaviour output the median of the last `median_window` values
+template <detail::sampled value_t>
+struct filter<filter_e::median, value_t> {
+  std::size_t median_window{ 5 };
+  std::size_t send_every{ 1 };
+  static constexpr filter_e type{ filter_e::median };
+  constexpr auto operator==(filter const& other) const noexcept -> bool {
+    return median_window == other.median_window && send_every == other.send_every;
+  }
+
+  filter() = default;
+  filter(filter&&) noexcept = default;
+  auto operator=(filter&&) noexcept -> filter& = default;
+  // copies the configuration, the copy starts with an empty window
+  filter(filter const& other) : median_window{ other.median_window }, send_every{ other.send_every } {}
+  auto operator=(filter const& other) -> filter& {
+    median_window = other.median_window;
+    send_every = other.send_every;
+    return *this;
+  }
+
+  auto process(value_t&& value) const -> std::expected<value_t, std::error_code> {
+    using sample = detail::sample<value_t>;
+    if (!sample::valid(value)) {
+      return std::move(value);
+    }
+    window_.resize(median_window);
+    window_.push(sample::get(value));
+    if (!decimator_.pass(send_every)) {
+      return detail::dropped();
+    }
+    auto const median{ window_.at(0.5) };
+    if (!median) {
+      return detail::dropped();
+    }
+    return sample::make(median.value());
+  }
+
+  auto async_process(value_t&& value, auto&& completion_token) const {
+    return detail::async_complete(process(std::move(value)), std::forward<decltype(completion_token)>(completion_token));
+  }
+
+private:
+  // mutable is required since async_process is const
+  mutable detail::sorted_window<typename detail::sample<value_t>::rep> window_{};
+  mutable detail::decimator decimator_{};
+
+public:
+  struct glaze {
+    using type = filter;
+    static constexpr std::string_view name{ "tfc::ipc::filter::median" };
+    // clang-format off
+    static constexpr auto value{ glz::object(
+      "median_window", &type::median_window, "Number of most recent values to take the median of",
+      "send_every", &type::send_every, "Output only every n-th result, 1 outputs a result for every value"
+    ) };
+    // clang-format on
+  };
+};
+
+/// \brief behaviour output the given quantile of the last `quantile_window` values
+template <detail::sampled value_t>
+struct filter<filter_e::quantile, value_t> {
+  std::double_t quantile{ 0.9 };
+  std::size_t quantile_window{ 5 };
+  std::size_t send_every{ 1 };
+  static constexpr filter_e type{ filter_e::quantile };
+  // clang-format off
+  PRAGMA_CLANG_WARNING_PUSH_OFF(-Wfloat-equal)
+  // clang-format on
+  constexpr auto operator==(filter const& other) const noexcept -> bool {
+    return quantile == other.quantile && quantile_window == other.quantile_window && send_every == other.send_every;
+  }
+  PRAGMA_CLANG_WARNING_POP
+
+  filter() = default;
+  filter(filter&&) noexcept = default;
+  auto operator=(filter&&) noexcept -> filter& = default;
+  // copies the configuration, the copy starts with an empty window
+  filter(filter const& other)
+      : quantile{ other.quantile }, quantile_window{ other.quantile_window }, send_every{ other.send_every } {}
+  auto operator=(filter const& other) -> filter& {
+    quantile = other.quantile;
+    quantile_window = other.quantile_window;
+    send_every = other.send_every;
+    return *this;
+  }
+
+  auto process(value_t&& value) const -> std::expected<value_t, std::error_code> {
+    using sample = detail::sample<value_t>;
+    if (!sample::valid(value)) {
+      return std::move(value);
+    }
+    window_.resize(quantile_window);
+    window_.push(sample::get(value));
+    if (!decimator_.pass(send_every)) {
+      return detail::dropped();
+    }
+    auto const at_quantile{ window_.at(quantile) };
+    if (!at_quantile) {
+      return detail::dropped();
+    }
+    return sample::make(at_quantile.value());
+  }
+
+  auto async_process(value_t&& value, auto&& completion_token) const {
+    return detail::async_complete(process(std::move(value)), std::forward<decltype(completion_token)>(completion_token));
+  }
+
+private:
+  mutable detail::sorted_window<typename detail::sample<value_t>::rep> window_{};
+  mutable detail::decimator decimator_{};
+
+public:
+  struct glaze {
+    using type = filter;
+    static constexpr std::string_view name{ "tfc::ipc::filter::quantile" };
+    // clang-format off
+    static constexpr auto value{ glz::object(
+      "quantile", &type::quantile, "Quantile to output, in the range 0 to 1, 0.5 is the median",
+      "quantile_window", &type::quantile_window, "Number of most recent values to take the quantile of",
+      "send_every", &type::send_every, "Output only every n-th result, 1 outputs a result for every value"
+    ) };
+    // clang-format on
+  };
+};
+
+/// \brief behaviour output the average of the last `average_window` values
+template <detail::sampled value_t>
+struct filter<filter_e::sliding_window_moving_average, value_t> {
+  std::size_t average_window{ 15 };
+  std::size_t send_every{ 1 };
+  static constexpr filter_e type{ filter_e::sliding_window_moving_average };
+  constexpr auto operator==(filter const& other) const noexcept -> bool {
+    return average_window == other.average_window && send_every == other.send_every;
+  }
+
+  filter() = default;
+  filter(filter&&) noexcept = default;
+  auto operator=(filter&&) noexcept -> filter& = default;
+  // copies the configuration, the copy starts with an empty window
+  filter(filter const& other) : average_window{ other.average_window }, send_every{ other.send_every } {}
+  auto operator=(filter const& other) -> filter& {
+    average_window = other.average_window;
+    send_every = other.send_every;
+    return *this;
+  }
+
+  auto process(value_t&& value) const -> std::expected<value_t, std::error_code> {
+    using sample = detail::sample<value_t>;
+    using rep = typename sample::rep;
+    if (!sample::valid(value)) {
+      return std::move(value);
+    }
+    if (window_.resize(average_window)) {
+      sum_ = 0;
+    }
+    auto const current{ sample::get(value) };
+    sum_ += static_cast<std::double_t>(current);
+    if (auto const evicted{ window_.push(current) }) {
+      sum_ -= static_cast<std::double_t>(evicted.value());
+    }
+    if (window_.wrapped()) {
+      // start over once per lap so rounding errors of the running sum do not accumulate
+      sum_ = 0;
+      for (rep const item : window_.samples()) {
+        sum_ += static_cast<std::double_t>(item);
+      }
+    }
+    if (!decimator_.pass(send_every)) {
+      return detail::dropped();
+    }
+    return sample::make(detail::round_to<rep>(sum_ / static_cast<std::double_t>(window_.samples().size())));
+  }
+
+  auto async_process(value_t&& value, auto&& completion_token) const {
+    return detail::async_complete(process(std::move(value)), std::forward<decltype(completion_token)>(completion_token));
+  }
+
+private:
+  mutable detail::ring_window<typename detail::sample<value_t>::rep> window_{};
+  mutable std::double_t sum_{};
+  mutable detail::decimator decimator_{};
+
+public:
+  struct glaze {
+    using type = filter;
+    static constexpr std::string_view name{ "tfc::ipc::filter::sliding_window_moving_average" };
+    // clang-format off
+    static constexpr auto value{ glz::object(
+      "average_window", &type::average_window, "Number of most recent values to average",
+      "send_every", &type::send_every, "Output only every n-th result, 1 outputs a result for every value"
+    ) };
+    // clang-format on
+  };
+};
+
+/// \brief behaviour output the exponentially weighted average, new average = alpha * value + (1 - alpha) * average
+template <detail::sampled value_t>
+struct filter<filter_e::exponential_moving_average, value_t> {
+  std::double_t alpha{ 0.1 };
+  std::size_t send_every{ 1 };
+  static constexpr filter_e type{ filter_e::exponential_moving_average };
+  // clang-format off
+  PRAGMA_CLANG_WARNING_PUSH_OFF(-Wfloat-equal)
+  // clang-format on
+  constexpr auto operator==(filter const& other) const noexcept -> bool {
+    return alpha == other.alpha && send_every == other.send_every;
+  }
+  PRAGMA_CLANG_WARNING_POP
+
+  filter() = default;
+  filter(filter&&) noexcept = default;
+  auto operator=(filter&&) noexcept -> filter& = default;
+  // copies the configuration, the copy starts without an average
+  filter(filter const& other) : alpha{ other.alpha }, send_every{ other.send_every } {}
+  auto operator=(filter const& other) -> filter& {
+    alpha = other.alpha;
+    send_every = other.send_every;
+    return *this;
+  }
+
+  auto process(value_t&& value) const -> std::expected<value_t, std::error_code> {
+    using sample = detail::sample<value_t>;
+    if (!sample::valid(value)) {
+      return std::move(value);
+    }
+    auto const current{ static_cast<std::double_t>(sample::get(value)) };
+    auto const weight{ std::clamp(alpha, 0.0, 1.0) };
+    average_ = average_.has_value() ? weight * current + (1.0 - weight) * average_.value() : current;
+    if (!decimator_.pass(send_every)) {
+      return detail::dropped();
+    }
+    return sample::make(detail::round_to<typename sample::rep>(average_.value()));
+  }
+
+  auto async_process(value_t&& value, auto&& completion_token) const {
+    return detail::async_complete(process(std::move(value)), std::forward<decltype(completion_token)>(completion_token));
+  }
+
+private:
+  mutable std::optional<std::double_t> average_{};
+  mutable detail::decimator decimator_{};
+
+public:
+  struct glaze {
+    using type = filter;
+    static constexpr std::string_view name{ "tfc::ipc::filter::exponential_moving_average" };
+    // clang-format off
+    static constexpr auto value{ glz::object(
+      "alpha", &type::alpha, "Weight of each new value, in the range 0 to 1, lower is smoother",
+      "send_every", &type::send_every, "Output only every n-th result, 1 outputs a result for every value"
+    ) };
+    // clang-format on
+  };
+};
+
+/// \brief behaviour drop values arriving within `throttle` of the previous passed value
+template <typename value_t, typename clock_type>  // example std::chrono::steady_clock
+struct filter<filter_e::throttle, value_t, clock_type> {
+  std::chrono::milliseconds throttle{ 0 };
+  static constexpr filter_e type{ filter_e::throttle };
+  constexpr auto operator==(filter const& other) const noexcept -> bool { return throttle == other.throttle; }
+
+  filter() = default;
+  filter(filter&&) noexcept = default;
+  auto operator=(filter&&) noexcept -> filter& = default;
+  // copies the configuration, the copy lets the next value through
+  filter(filter const& other) : throttle{ other.throttle } {}
+  auto operator=(filter const& other) -> filter& {
+    throttle = other.throttle;
+    return *this;
+  }
+
+  auto process(value_t&& value) const -> std::expected<value_t, std::error_code> {
+    auto const now{ clock_type::now() };
+    if (last_passed_.has_value() && now - last_passed_.value() < throttle) {
+      return detail::dropped();
+    }
+    last_passed_ = now;
+    return std::move(value);
+  }
+
+  auto async_process(value_t&& value, auto&& completion_token) const {
+    return detail::async_complete(process(std::move(value)), std::forward<decltype(completion_token)>(completion_token));
+  }
+
+private:
+  mutable std::optional<typename clock_type::time_point> last_passed_{};
+
+public:
+  struct glaze {
+    using type = filter;
+    static constexpr std::string_view name{ "tfc::ipc::filter::throttle" };
+    static constexpr auto value{
+      glz::object("throttle", &type::throttle, "Minimum time between values, values arriving sooner are dropped")
+    };
+  };
+};
+
+/// \brief behaviour collect values for `throttle_average` and output their average at the end of the period
+/// The first value of a period completes when the period ends, the others are dropped immediately.
+/// \note IMPORTANT: period changes take effect on next period
+template <detail::sampled value_t, typename timer_type>  // example asio::steady_timer
+struct filter<filter_e::throttle_average, value_t, timer_type> {
+  std::chrono::milliseconds throttle_average{ 0 };
+  static constexpr filter_e type{ filter_e::throttle_average };
+  constexpr auto operator==(filter const& other) const noexcept -> bool {
+    return throttle_average == other.throttle_average;
+  }
+
+  filter() = default;
+  filter(filter&&) noexcept = default;
+  auto operator=(filter&&) noexcept -> filter& = default;
+  // copies the configuration, the copied object will hold on to its pending period `other`
+  filter(filter const& other) : throttle_average{ other.throttle_average } {}
+  auto operator=(filter const& other) -> filter& {
+    throttle_average = other.throttle_average;
+    return *this;
+  }
+  ~filter() {
+    if (state_ && state_->timer) {
+      state_->timer->cancel();
+    }
+  }
+
+  auto async_process(value_t&& value, auto&& completion_token) const {
+    using sample = detail::sample<value_t>;
+    if (!state_) {
+      state_ = std::make_shared<state_t>();
+    }
+    auto exe = asio::get_associated_executor(completion_token);
+    return asio::async_compose<decltype(completion_token), void(std::expected<value_t, std::error_code>)>(
+        [state = state_, period = throttle_average, copy = std::move(value), first_call = true](
+            auto& self, std::error_code code = {}) mutable {
+          if (code) {
+            // the filter was destroyed while waiting
+            self.complete(std::unexpected(code));
+            return;
+          }
+          if (!first_call) {
+            // end of period, output the average of everything collected
+            auto const average{ state->sum / static_cast<std::double_t>(state->count) };
+            state->timer.reset();
+            state->sum = 0;
+            state->count = 0;
+            self.complete(sample::make(detail::round_to<typename sample::rep>(average)));
+            return;
+          }
+          first_call = false;
+          if (!sample::valid(copy)) {
+            self.complete(std::move(copy));
+            return;
+          }
+          if (period == std::chrono::milliseconds{ 0 }) {
+            self.complete(std::move(copy));
+            return;
+          }
+          state->sum += static_cast<std::double_t>(sample::get(copy));
+          state->count++;
+          if (state->timer) {
+            // folded into the average of the pending period
+            self.complete(detail::dropped());
+            return;
+          }
+          state->timer.emplace(asio::get_associated_executor(self));
+          state->timer->expires_after(period);
+          state->timer->async_wait(std::move(self));
+        },
+        completion_token, exe);
+  }
+
+private:
+  struct state_t {
+    std::optional<timer_type> timer{};
+    std::double_t sum{};
+    std::size_t count{};
+  };
+  // shared with the pending operation, which may outlive a moved from filter
+  mutable std::shared_ptr<state_t> state_{};
+
+public:
+  struct glaze {
+    using type = filter;
+    static constexpr std::string_view name{ "tfc::ipc::filter::throttle_average" };
+    static constexpr auto value{ glz::object("throttle_average",
+                                             &type::throttle_average,
+                                             "Period to average values over, one average is output per period") };
+  };
+};
+
+/// \brief behaviour drop values which differ less than `delta` from the previous passed value
+template <detail::sampled value_t>
+struct filter<filter_e::delta, value_t> {
+  using difference_t = typename detail::sample<value_t>::difference_t;
+  difference_t delta{};
+  static constexpr filter_e type{ filter_e::delta };
+  // clang-format off
+  PRAGMA_CLANG_WARNING_PUSH_OFF(-Wfloat-equal)
+  // clang-format on
+  constexpr auto operator==(filter const& other) const noexcept -> bool { return delta == other.delta; }
+  PRAGMA_CLANG_WARNING_POP
+
+  filter() = default;
+  filter(filter&&) noexcept = default;
+  auto operator=(filter&&) noexcept -> filter& = default;
+  // copies the configuration, the copy lets the next value through
+  filter(filter const& other) : delta{ other.delta } {}
+  auto operator=(filter const& other) -> filter& {
+    delta = other.delta;
+    return *this;
+  }
+
+  auto process(value_t&& value) const -> std::expected<value_t, std::error_code> {
+    using sample = detail::sample<value_t>;
+    if (!sample::valid(value)) {
+      return std::move(value);
+    }
+    auto const current{ sample::get(value) };
+    if (last_passed_.has_value()) {
+      auto const previous{ last_passed_.value() };
+      auto const difference{ current < previous ? previous - current : current - previous };
+      if (difference < sample::magnitude(delta)) {
+        return detail::dropped();
+      }
+    }
+    last_passed_ = current;
+    return std::move(value);
+  }
+
+  auto async_process(value_t&& value, auto&& completion_token) const {
+    return detail::async_complete(process(std::move(value)), std::forward<decltype(completion_token)>(completion_token));
+  }
+
+private:
+  mutable std::optional<typename detail::sample<value_t>::rep> last_passed_{};
+
+public:
+  struct glaze {
+    using type = filter;
+    static constexpr std::string_view name{ "tfc::ipc::filter::delta" };
+    static constexpr auto value{
+      glz::object("delta", &type::delta, "Minimum change from the previous passed value, smaller changes are dropped")
+    };
+  };
+};
+
 namespace detail {
 template <typename value_t>
 struct any_filter_decl;
 template <>
 struct any_filter_decl<bool> {
   using value_t = bool;
-  using type = std::variant<filter<filter_e::invert, value_t>, filter<filter_e::timer, value_t, asio::steady_timer>>;
+  using type = std::variant<filter<filter_e::invert, value_t>,
+                            filter<filter_e::timer, value_t, asio::steady_timer>,
+                            filter<filter_e::throttle, value_t, std::chrono::steady_clock>>;
 };
 template <>
 struct any_filter_decl<std::int64_t> {
   using value_t = std::int64_t;
-  using type = std::
-      variant<filter<filter_e::filter_out, value_t>, filter<filter_e::offset, value_t>, filter<filter_e::multiply, value_t>>;
+  using type = std::variant<filter<filter_e::filter_out, value_t>,
+                            filter<filter_e::offset, value_t>,
+                            filter<filter_e::multiply, value_t>,
+                            filter<filter_e::median, value_t>,
+                            filter<filter_e::quantile, value_t>,
+                            filter<filter_e::sliding_window_moving_average, value_t>,
+                            filter<filter_e::exponential_moving_average, value_t>,
+                            filter<filter_e::throttle, value_t, std::chrono::steady_clock>,
+                            filter<filter_e::throttle_average, value_t, asio::steady_timer>,
+                            filter<filter_e::delta, value_t>>;
 };
 template <>
 struct any_filter_decl<std::uint64_t> {
   using value_t = std::uint64_t;
-  using type = std::
-      variant<filter<filter_e::filter_out, value_t>, filter<filter_e::offset, value_t>, filter<filter_e::multiply, value_t>>;
+  using type = std::variant<filter<filter_e::filter_out, value_t>,
+                            filter<filter_e::offset, value_t>,
+                            filter<filter_e::multiply, value_t>,
+                            filter<filter_e::median, value_t>,
+                            filter<filter_e::quantile, value_t>,
+                            filter<filter_e::sliding_window_moving_average, value_t>,
+                            filter<filter_e::exponential_moving_average, value_t>,
+                            filter<filter_e::throttle, value_t, std::chrono::steady_clock>,
+                            filter<filter_e::throttle_average, value_t, asio::steady_timer>,
+                            filter<filter_e::delta, value_t>>;
 };
 template <>
 struct any_filter_decl<std::double_t> {
   using value_t = std::double_t;
-  using type = std::
-      variant<filter<filter_e::filter_out, value_t>, filter<filter_e::offset, value_t>, filter<filter_e::multiply, value_t>>;
+  using type = std::variant<filter<filter_e::filter_out, value_t>,
+                            filter<filter_e::offset, value_t>,
+                            filter<filter_e::multiply, value_t>,
+                            filter<filter_e::median, value_t>,
+                            filter<filter_e::quantile, value_t>,
+                            filter<filter_e::sliding_window_moving_average, value_t>,
+                            filter<filter_e::exponential_moving_average, value_t>,
+                            filter<filter_e::throttle, value_t, std::chrono::steady_clock>,
+                            filter<filter_e::throttle_average, value_t, asio::steady_timer>,
+                            filter<filter_e::delta, value_t>>;
 };
 template <>
 struct any_filter_decl<std::string> {
   using value_t = std::string;
-  using type = std::variant<filter<filter_e::filter_out, value_t>>;
+  using type =
+      std::variant<filter<filter_e::filter_out, value_t>, filter<filter_e::throttle, value_t, std::chrono::steady_clock>>;
 };
 template <>
 struct any_filter_decl<details::mass_t> {
   using value_t = details::mass_t;
-  using type = std::variant<filter<filter_e::filter_out, value_t>>;
+  using type = std::variant<filter<filter_e::filter_out, value_t>,
+                            filter<filter_e::median, value_t>,
+                            filter<filter_e::quantile, value_t>,
+                            filter<filter_e::sliding_window_moving_average, value_t>,
+                            filter<filter_e::exponential_moving_average, value_t>,
+                            filter<filter_e::throttle, value_t, std::chrono::steady_clock>,
+                            filter<filter_e::throttle_average, value_t, asio::steady_timer>,
+                            filter<filter_e::delta, value_t>>;
 };
 template <>
 struct any_filter_decl<details::pressure_t> {
   using value_t = details::pressure_t;
-  using type = std::variant<filter<filter_e::filter_out, value_t>>;
+  using type = std::variant<filter<filter_e::filter_out, value_t>,
+                            filter<filter_e::median, value_t>,
+                            filter<filter_e::quantile, value_t>,
+                            filter<filter_e::sliding_window_moving_average, value_t>,
+                            filter<filter_e::exponential_moving_average, value_t>,
+                            filter<filter_e::throttle, value_t, std::chrono::steady_clock>,
+                            filter<filter_e::throttle_average, value_t, asio::steady_timer>,
+                            filter<filter_e::delta, value_t>>;
 };
 template <>
 struct any_filter_decl<details::temperature_t> {
   using value_t = details::temperature_t;
-  using type = std::variant<filter<filter_e::filter_out, value_t>>;
+  using type = std::variant<filter<filter_e::filter_out, value_t>,
+                            filter<filter_e::median, value_t>,
+                            filter<filter_e::quantile, value_t>,
+                            filter<filter_e::sliding_window_moving_average, value_t>,
+                            filter<filter_e::exponential_moving_average, value_t>,
+                            filter<filter_e::throttle, value_t, std::chrono::steady_clock>,
+                            filter<filter_e::throttle_average, value_t, asio::steady_timer>,
+                            filter<filter_e::delta, value_t>>;
 };
 template <>
 struct any_filter_decl<details::length_t> {
   using value_t = details::length_t;
-  using type = std::variant<filter<filter_e::filter_out, value_t>>;
+  using type = std::variant<filter<filter_e::filter_out, value_t>,
+                            filter<filter_e::median, value_t>,
+                            filter<filter_e::quantile, value_t>,
+                            filter<filter_e::sliding_window_moving_average, value_t>,
+                            filter<filter_e::exponential_moving_average, value_t>,
+                            filter<filter_e::throttle, value_t, std::chrono::steady_clock>,
+                            filter<filter_e::throttle_average, value_t, asio::steady_timer>,
+                            filter<filter_e::delta, value_t>>;
 };
 template <>
 struct any_filter_decl<details::voltage_t> {
   using value_t = details::voltage_t;
-  using type = std::variant<filter<filter_e::filter_out, value_t>>;
+  using type = std::variant<filter<filter_e::filter_out, value_t>,
+                            filter<filter_e::median, value_t>,
+                            filter<filter_e::quantile, value_t>,
+                            filter<filter_e::sliding_window_moving_average, value_t>,
+                            filter<filter_e::exponential_moving_average, value_t>,
+                            filter<filter_e::throttle, value_t, std::chrono::steady_clock>,
+                            filter<filter_e::throttle_average, value_t, asio::steady_timer>,
+                            filter<filter_e::delta, value_t>>;
 };
 template <>
 struct any_filter_decl<details::current_t> {
   using value_t = details::current_t;
-  using type = std::variant<filter<filter_e::filter_out, value_t>>;
+  using type = std::variant<filter<filter_e::filter_out, value_t>,
+                            filter<filter_e::median, value_t>,
+                            filter<filter_e::quantile, value_t>,
+                            filter<filter_e::sliding_window_moving_average, value_t>,
+                            filter<filter_e::exponential_moving_average, value_t>,
+                            filter<filter_e::throttle, value_t, std::chrono::steady_clock>,
+                            filter<filter_e::throttle_average, value_t, asio::steady_timer>,
+                            filter<filter_e::delta, value_t>>;
 };
 // json?
 template <typename value_t>
 using any_filter_decl_t = any_filter_decl<value_t>::type;
+
+template <typename>
+inline constexpr bool is_filter{ false };
+template <filter_e type, typename value_t, typename... args_t>
+inline constexpr bool is_filter<filter<type, value_t, args_t...>>{ true };
 }  // namespace detail
 
 template <typename value_t>
@@ -332,29 +1030,32 @@ public:
   ~filters() = default;
 
   /// \brief changes internal last_value state when filters have been processed
+  /// Synchronous filters are run inline, a coroutine is only spawned from the first asynchronous filter onwards.
   void operator()(auto&& value)
     requires std::same_as<std::remove_cvref_t<decltype(value)>, value_t>
   {
-    if (filters_->value().empty()) {
-      last_value_ = std::forward<decltype(value)>(value);
-      std::invoke(callback_, last_value_.value());
+    std::expected<value_t, std::error_code> return_value{ std::forward<decltype(value)>(value) };
+    auto const resume_at{ process_synchronous(return_value, 0) };
+    if (!return_value.has_value()) {
+      // The filter has erased the existence of inputted value, forget that this happened
+      return;
+    }
+    if (resume_at == filters_->value().size()) {
+      deliver(std::move(return_value.value()));
       return;
     }
-    std::expected<value_t, std::error_code> return_value{ std::forward<decltype(value)>(value) };
     asio::co_spawn(
         ctx_,
-        [this, return_val = std::move(return_value)] mutable -> asio::awaitable<std::expected<value_t, std::error_code>> {
-          for (auto const& filter : filters_->value()) {
+        [this, return_val = std::move(return_value),
+         index = resume_at] mutable -> asio::awaitable<std::expected<value_t, std::error_code>> {
+          while (return_val.has_value() && index < filters_->value().size()) {
             // move the value into the filter and the filter will return the value modified or not
             return_val = co_await std::visit(
                 [return_v = std::move(return_val)](auto&& arg) mutable -> auto {  // mutable to move return_value
                   return arg.async_process(std::move(return_v.value()), asio::use_awaitable);  //
                 },
-                filter);
-            if (!return_val.has_value()) {
-              // The filter has erased the existence of inputted value, exit the coroutine and forget that this happened
-              co_return std::move(return_val);
-            }
+                filters_->value()[index]);
+            index = process_synchronous(return_val, index + 1);
           }
           co_return std::move(return_val);
         },
@@ -363,8 +1064,7 @@ public:
             std::rethrow_exception(exception_ptr);
           }
           if (return_val.has_value()) {
-            last_value_ = std::move(return_val.value());
-            std::invoke(callback_, last_value_.value());
+            deliver(std::move(return_val.value()));
           } else {
             // I have now forgotten the original value/s
           }
@@ -407,6 +1107,33 @@ public:
   [[nodiscard]] auto value() const noexcept -> std::optional<value_t> const& { return last_value_; }
 
 private:
+  /// \brief run the synchronous filters starting at `index` until an asynchronous one is reached
+  /// \return index of the asynchronous filter, or the filter count if none is left
+  auto process_synchronous(std::expected<value_t, std::error_code>& value, std::size_t index) -> std::size_t {
+    auto const& config{ filters_->value() };
+    for (; index < config.size() && value.has_value(); index++) {
+      bool const synchronous{ std::visit(
+          [&value](auto const& filt) -> bool {
+            if constexpr (detail::synchronous_filter<std::remove_cvref_t<decltype(filt)>, value_t>) {
+              value = filt.process(std::move(value.value()));
+              return true;
+            } else {
+              return false;
+            }
+          },
+          config[index]) };
+      if (!synchronous) {
+        break;
+      }
+    }
+    return index;
+  }
+
+  void deliver(value_t&& value) {
+    last_value_ = std::move(value);
+    std::invoke(callback_, last_value_.value());
+  }
+
   asio::io_context& ctx_;
   confman_t filters_;
   callback_t callback_;
@@ -415,6 +1142,13 @@ private:
 
 }  // namespace tfc::ipc::filter
 
+// every signal and slot has its own filter config, all of which are read on start
+template <typename... filters_t>
+  requires(tfc::ipc::filter::detail::is_filter<filters_t> && ...)
+inline constexpr bool tfc::confman::binary_snapshot<tfc::confman::observable<std::vector<std::variant<filters_t...>>>>{
+  true
+};
+
 template <>
 struct glz::meta<tfc::ipc::filter::filter_e> {
   using enum tfc::ipc::filter::filter_e;
@@ -427,14 +1161,14 @@ struct glz::meta<tfc::ipc::filter::filter_e> {
                                               "offset", offset, "Adds a constant value to each sensor value",
                                               "multiply", multiply, "Multiplies each value by a constant value",
                                               "filter_out", filter_out, "Filter out specific values to drop and forget",
+                                              "median", median, "Median of the most recent values",
+                                              "quantile", quantile, "Quantile of the most recent values",
+                                              "sliding_window_moving_average", sliding_window_moving_average, "Average of recent values",
+                                              "exponential_moving_average", exponential_moving_average, "Weighted average",
+                                              "throttle", throttle, "Drop values arriving too soon after the previous one",
+                                              "throttle_average", throttle_average, "Average of all values within a period",
+                                              "delta", delta, "Drop values which have not changed enough",
                                               "calibrate_linear", calibrate_linear,
-                                              "median", median,
-                                              "quantile", quantile,
-                                              "sliding_window_moving_average", sliding_window_moving_average,
-                                              "exponential_moving_average", exponential_moving_average,
-                                              "throttle", throttle,
-                                              "throttle_average", throttle_average,
-                                              "delta", delta,
                                               "lambda", lambda) };
   // clang-format on
 };
@@ -1,23 +1,31 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <chrono>
 #include <concepts>
+#include <cstdint>
+#include <cstring>
 #include <expected>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <span>
 #include <string>
 #include <string_view>
+#include <tuple>
 #include <variant>
 
 #include <fmt/format.h>
 #include <azmq/socket.hpp>
 #include <boost/asio/compose.hpp>
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/steady_timer.hpp>
 #include <boost/system/error_code.hpp>
 
 #include <tfc/ipc/details/dbus_ipc.hpp>
+#include <tfc/ipc/details/shm.hpp>
 #include <tfc/ipc/details/type_description.hpp>
 #include <tfc/ipc/enums.hpp>
 #include <tfc/ipc/packet.hpp>
@@ -72,10 +80,11 @@ public:
   using packet_t = packet<value_t, type_desc::value_e>;
   static auto constexpr direction_v = direction_e::signal;
 
-  [[nodiscard]] static auto create(asio::io_context& ctx, std::string_view name)
+  /// \param transport transport_e::shm is only honoured for fixed size types, other types fall back to zmq
+  [[nodiscard]] static auto create(asio::io_context& ctx, std::string_view name, transport_e transport = transport_e::zmq)
       -> std::expected<std::shared_ptr<signal<type_desc>>, std::error_code> {
     auto ptr = std::shared_ptr<signal<type_desc>>(new signal(ctx, name));
-    auto error = ptr->init();
+    auto error = ptr->init(transport);
     if (error) {
       return std::unexpected(error);
     }
@@ -85,14 +94,8 @@ public:
   /// @param value is sent
   /// @return std::error_code, empty if no error.
   auto send(value_t const& value) -> std::error_code {
-    last_value_ = value;
-    std::vector<std::byte> send_buffer{};
-    if (auto serialize_err{ packet_t::serialize(last_value_.value(), send_buffer) }) {
-      return serialize_err;
-    }
-    std::size_t size = socket_.send(asio::buffer(send_buffer));
-    if (size != send_buffer.size()) {
-      return std::make_error_code(std::errc::value_too_large);
+    if (auto sent{ send_impl(value) }; !sent) {
+      return sent.error();
     }
     return {};
   }
@@ -100,49 +103,51 @@ public:
   /// @brief send value to subscriber
   /// @tparam completion_token_t a concept of type void(std::error_code, std::size_t)
   /// @param value is sent
+  /// @note Neither zmq pub sockets nor shared memory regions block on send, the value is handed over
+  /// immediately and the completion is dispatched through the executor.
   template <asio::completion_token_for<void(std::error_code, std::size_t)> completion_token_t>
   auto async_send(value_t const& value, completion_token_t&& token) ->
       typename asio::async_result<std::decay_t<completion_token_t>, void(std::error_code, std::size_t)>::return_type {
-    last_value_ = value;
-    auto send_buffer{ std::make_unique<std::vector<std::byte>>() };
-    if (auto serialize_error{ packet_t::serialize(last_value_.value(), *send_buffer) }) {
-      return asio::async_compose<completion_token_t, void(std::error_code, std::size_t)>(
-          [serialize_error](auto& self, std::error_code = {}, std::size_t = 0) { self.complete(serialize_error, 0); },
-          token);
-    }
-
-    enum struct state_e { write, complete };
-
-    auto& socket{ socket_ };
     return asio::async_compose<completion_token_t, void(std::error_code, std::size_t)>(
-        [&socket, buffer = std::move(send_buffer), state = state_e::write](auto& self, std::error_code err = {},
-                                                                           std::size_t bytes_sent = 0) mutable {
-          if (err) {
-            self.complete(err, bytes_sent);
+        [this, value, sent = std::expected<std::size_t, std::error_code>{}, posted = false](
+            auto& self, std::error_code = {}, std::size_t = 0) mutable {
+          if (!posted) {
+            // sent when the operation starts, a deferred token must not send before it is launched
+            sent = send_impl(value);
+            // do not recurse into the caller from within the initiating function
+            posted = true;
+            asio::post(std::move(self));
             return;
           }
-          switch (state) {
-            case state_e::write: {
-              state = state_e::complete;
-              azmq::async_send(socket, asio::buffer(*buffer), std::move(self));
-              break;
-            }
-            case state_e::complete: {
-              self.complete(err, bytes_sent);
-              break;
-            }
+          if (!sent) {
+            self.complete(sent.error(), 0);
+            return;
           }
+          self.complete({}, sent.value());
         },
-        token, socket_);
+        token, timer_);
   }
   [[nodiscard]] auto value() const noexcept -> auto const& { return last_value_; }
 
+  [[nodiscard]] auto transport() const noexcept -> transport_e { return shm_ ? transport_e::shm : transport_e::zmq; }
+
 private:
   signal(asio::io_context& ctx, std::string_view name)
       : transmission_base<type_desc>(name), timer_(ctx), socket_(ctx),
         socket_monitor_(socket_.monitor(ctx, ZMQ_EVENT_HANDSHAKE_SUCCEEDED)) {}
 
-  auto init() -> std::error_code {
+  auto init(transport_e transport) -> std::error_code {
+    if constexpr (concepts::fixed_size_value<value_t>) {
+      if (transport == transport_e::shm) {
+        auto region{ shm::region::create(this->full_name(), type_desc::value_e, packet_t::max_size()) };
+        if (!region) {
+          return region.error();
+        }
+        shm_.emplace(std::move(region.value()));
+        // Late joiners read the latest entry of the region, no need for the zmq handshake monitor
+        return {};
+      }
+    }
     boost::system::error_code error_code;
     socket_.bind(this->endpoint(), error_code);
     if (error_code) {
@@ -188,10 +193,43 @@ private:
           }
         });
   }
+  auto send_impl(value_t const& value) -> std::expected<std::size_t, std::error_code> {
+    last_value_ = value;
+    // header on the stack, string payloads are a view into last_value_
+    auto serialized{ packet_t::serialize(last_value_.value()) };
+    if (!serialized) {
+      return std::unexpected(serialized.error());
+    }
+    if (shm_) {
+      shm_->publish(serialized->header(), serialized->payload());
+      return serialized->size();
+    }
+    std::span<std::byte const> message{};
+    if (auto contiguous{ serialized->contiguous() }) {
+      message = contiguous.value();
+    } else {
+      // multiple buffers would be sent as a multipart message, gather into a buffer which is reused between sends
+      send_buffer_.clear();
+      serialized->append_to(send_buffer_);
+      message = send_buffer_;
+    }
+    boost::system::error_code error_code;
+    std::size_t const size{ socket_.send(asio::buffer(message.data(), message.size()), 0, error_code) };
+    if (error_code) {
+      return std::unexpected(error_code);
+    }
+    if (size != message.size()) {
+      return std::unexpected(std::make_error_code(std::errc::value_too_large));
+    }
+    return size;
+  }
+
   std::optional<value_t> last_value_{ std::nullopt };
   boost::asio::steady_timer timer_;
   azmq::pub_socket socket_;
   azmq::socket socket_monitor_;
+  std::optional<shm::region> shm_{ std::nullopt };
+  std::vector<std::byte> send_buffer_{};
 };
 
 /**@brief slot
@@ -205,50 +243,54 @@ public:
   using packet_t = packet<value_t, value_e>;
   static auto constexpr direction_v = direction_e::slot;
   static auto constexpr reconnect_interval = std::chrono::seconds(1);
+  /// Longest time between looking for the shared memory region of a signal which is not up
+  static auto constexpr max_probe_interval = std::chrono::seconds(30);
 
   [[nodiscard]] static auto create(asio::io_context& ctx, std::string_view name) -> std::shared_ptr<slot<type_desc>> {
     return std::shared_ptr<slot<type_desc>>(new slot(ctx, name));
   }
-  slot(asio::io_context& ctx, std::string_view name) : transmission_base<type_desc>(name), socket_(ctx) {}
+  slot(asio::io_context& ctx, std::string_view name)
+      : transmission_base<type_desc>(name), socket_(ctx), timer_(ctx), shm_probe_(ctx) {}
   /**
    * @brief
    * connect to the signal indicated by name
+   * @note signals publishing over shared memory are detected and preferred over zmq
    * */
   auto connect(std::string_view signal_name) -> std::error_code {
-    // TODO: Find out if these mutexes inside optimize single threaded are really needed
-    socket_ = azmq::sub_socket(socket_.get_io_context(), true);
-    std::string const socket_path{ utils::socket::zmq::ipc_endpoint_str(signal_name) };
-
-    boost::system::error_code error_code;
-    if (socket_.set_option(
-            azmq::socket::reconnect_ivl(std::chrono::duration_cast<std::chrono::milliseconds>(reconnect_interval).count()),
-            error_code)) {
-      return error_code;
-    }
-
-    if (socket_.connect(socket_path, error_code)) {
-      return error_code;
-    }
-    if (socket_.set_option(azmq::socket::subscribe(""), error_code)) {
-      return error_code;
-    }
-    return {};
+    generation_++;
+    signal_name_ = signal_name;
+    return connect_impl();
   }
 
   /**
    * @brief synchronous reception of slot data.
    * @return a new value sent to the slot
+   * @note blocks until a value is received, there is no limit on the size of the value
    */
-  [[nodiscard]] auto receive() -> std::expected<value_t&, std::error_code> {
-    std::array<std::byte, 1024> buffer;
+  [[nodiscard]] auto receive() -> std::expected<value_t, std::error_code> {
+    if constexpr (concepts::fixed_size_value<value_t>) {
+      while (shm_) {
+        if (shm_->detached()) {
+          if (auto connect_err{ connect_impl() }) {
+            return std::unexpected(connect_err);
+          }
+          continue;
+        }
+        auto const observed{ shm_->mapping().notify_word() };
+        if (auto value{ read_shm() }) {
+          return std::move(value.value());
+        }
+        shm_->mapping().wait(observed, reconnect_interval);
+      }
+    }
+    // zmq allocates the message storage to the exact size of what was sent
+    azmq::message message{};
     boost::system::error_code code;
-    auto bytes_received = socket_.receive(buffer, 0, code);
-
-    if (bytes_received < packet_t::header_size()) {
-      return std::unexpected(ipc_errors_e::message_to_small);
+    socket_.receive(message, 0, code);
+    if (code) {
+      return std::unexpected(code);
     }
-
-    return packet_t::deserialize(std::span(buffer.data(), bytes_received)).value;
+    return deserialize(message);
   }
 
   /// \brief schedule an async_read on the slot
@@ -259,31 +301,89 @@ public:
   template <typename completion_token_t>
   auto async_receive(completion_token_t&& token)
       -> asio::async_result<std::decay_t<completion_token_t>, void(std::expected<value_t, std::error_code>)>::return_type {
-    enum struct state_e { read, complete };
+    enum struct state_e { dispatch, zmq_complete, shm_wait, reconnect_wait };
 
-    std::unique_ptr<std::vector<std::byte>> receive_buffer{ std::make_unique<std::vector<std::byte>>() };
-    receive_buffer->resize(4096, {});
-    // todo receive header first then value
-
-    azmq::sub_socket& socket{ socket_ };
     return asio::async_compose<completion_token_t, void(std::expected<value_t, std::error_code>)>(
-        [&socket, state = state_e::read, buffer = std::move(receive_buffer)](auto& self, std::error_code err = {},
-                                                                             std::size_t bytes_received = 0) mutable {
-          if (err) {
-            self.complete(std::unexpected(err));
+        [this, state = state_e::dispatch, generation = generation_, lifetime = std::weak_ptr<void>{ lifetime_ },
+         alive = std::weak_ptr<void>{}](auto& self, std::error_code err = {}, auto&&... received) mutable {
+          if (state != state_e::dispatch && lifetime.expired()) {
+            // this slot has been destroyed while waiting, do not touch any of its members
+            self.complete(std::unexpected(err ? err : std::make_error_code(std::errc::operation_canceled)));
             return;
           }
           switch (state) {
-            case state_e::read: {
-              state = state_e::complete;
-              azmq::async_receive(socket, asio::buffer(*buffer), std::move(self));
+            case state_e::dispatch:
+              break;
+            case state_e::zmq_complete: {
+              if (err) {
+                // The zmq socket was dropped by the shared memory probe, carry on reading from the region
+                if (err == std::errc::operation_canceled && generation == generation_ && shm_) {
+                  break;
+                }
+                self.complete(std::unexpected(err));
+                return;
+              }
+              if (probing_) {
+                // the signal publishes over zmq, no need to look for a shared memory region anymore
+                probing_ = false;
+                shm_probe_.cancel();
+              }
+              // message read handler, void(error_code, azmq::message&, std::size_t)
+              if constexpr (sizeof...(received) == 2) {
+                self.complete(deserialize(std::get<0>(std::forward_as_tuple(received...))));
+              } else {
+                // resumed by something other than the zmq read, which carries no message to deserialize
+                self.complete(std::unexpected(std::make_error_code(std::errc::bad_message)));
+              }
+              return;
+            }
+            case state_e::shm_wait: {
+              if (alive.expired()) {
+                // the listener is gone, either this slot is being destroyed or it has been reconnected
+                self.complete(std::unexpected(std::make_error_code(std::errc::operation_canceled)));
+                return;
+              }
               break;
             }
-            case state_e::complete: {
-              self.complete(packet_t::deserialize(std::span{ buffer->data(), bytes_received }));
+            case state_e::reconnect_wait: {
+              if (err) {
+                self.complete(std::unexpected(err));
+                return;
+              }
+              if (generation != generation_) {
+                self.complete(std::unexpected(std::make_error_code(std::errc::operation_canceled)));
+                return;
+              }
+              if (auto connect_err{ connect_impl() }) {
+                self.complete(std::unexpected(connect_err));
+                return;
+              }
               break;
             }
           }
+          if constexpr (concepts::fixed_size_value<value_t>) {
+            if (shm_) {
+              if (auto value{ read_shm() }) {
+                self.complete(std::move(value.value()));
+                return;
+              }
+              if (shm_->detached()) {
+                // The signal has gone away, give it some time to come back and find out how it publishes then
+                shm_.reset();
+                state = state_e::reconnect_wait;
+                timer_.expires_after(reconnect_interval);
+                timer_.async_wait(std::move(self));
+                return;
+              }
+              state = state_e::shm_wait;
+              alive = shm_->alive();
+              shm_->async_wait(std::move(self));
+              return;
+            }
+          }
+          state = state_e::zmq_complete;
+          // receive into a zmq message, sized by zmq to fit whatever was sent
+          socket_.async_receive(std::move(self));
         },
         token, socket_);
   }
@@ -292,12 +392,176 @@ public:
    * @brief disconnect from signal
    */
   auto disconnect(std::string_view signal_name) {
+    generation_++;
+    probing_ = false;
+    shm_probe_.cancel();
+    shm_.reset();
+    zmq_monitor_.reset();
     [[maybe_unused]] boost::system::error_code code;
     return socket_.disconnect(signal_name.data(), code);
   }
 
+  [[nodiscard]] auto transport() const noexcept -> transport_e { return shm_ ? transport_e::shm : transport_e::zmq; }
+
+  /// \return time the last received value was sampled by its signal, see shm::sample_time
+  /// Values received over zmq carry no sample time, the time they were received is used instead.
+  [[nodiscard]] auto sampled_at() const noexcept -> std::chrono::steady_clock::time_point { return sampled_at_; }
+
 private:
+  auto connect_impl() -> std::error_code {
+    probing_ = false;
+    shm_probe_.cancel();
+    shm_.reset();
+    zmq_monitor_.reset();
+    if constexpr (concepts::fixed_size_value<value_t>) {
+      if (attach_shm()) {
+        return {};
+      }
+    }
+
+    // TODO: Find out if these mutexes inside optimize single threaded are really needed
+    socket_ = azmq::sub_socket(socket_.get_io_context(), true);
+    std::string const socket_path{ utils::socket::zmq::ipc_endpoint_str(signal_name_) };
+
+    if constexpr (concepts::fixed_size_value<value_t>) {
+      // created before connecting, so the handshake with a signal which is already up is not missed
+      zmq_monitor_.emplace(
+          socket_.monitor(socket_.get_io_context(), ZMQ_EVENT_HANDSHAKE_SUCCEEDED | ZMQ_EVENT_DISCONNECTED));
+    }
+
+    boost::system::error_code error_code;
+    if (socket_.set_option(
+            azmq::socket::reconnect_ivl(std::chrono::duration_cast<std::chrono::milliseconds>(reconnect_interval).count()),
+            error_code)) {
+      return error_code;
+    }
+
+    if (socket_.connect(socket_path, error_code)) {
+      return error_code;
+    }
+    if (socket_.set_option(azmq::socket::subscribe(""), error_code)) {
+      return error_code;
+    }
+    if constexpr (concepts::fixed_size_value<value_t>) {
+      // The signal might not be up yet, and it might be publishing over shared memory when it is
+      probing_ = true;
+      shm_probe_interval_ = reconnect_interval;
+      probe_shm();
+      watch_zmq_connection();
+    }
+    return {};
+  }
+
+  auto attach_shm() -> bool
+    requires concepts::fixed_size_value<value_t>
+  {
+    auto region{ shm::region::open(signal_name_, value_e, packet_t::max_size()) };
+    if (!region) {
+      return false;
+    }
+    // Start with the latest published value, same as a zmq signal sends its last value on handshake
+    auto const published{ region->write_index() };
+    auto listening{ shm::listener::create(socket_.get_io_context().get_executor(), std::move(region.value())) };
+    if (!listening) {
+      return false;
+    }
+    // Drop the zmq subscription, a pending zmq receive is aborted and resumes on the shared memory region
+    zmq_monitor_.reset();
+    socket_ = azmq::sub_socket(socket_.get_io_context(), true);
+    shm_index_ = published > 0 ? published - 1 : 0;
+    shm_ = std::move(listening.value());
+    return true;
+  }
+
+  /// \brief look for a shared memory region of the signal until one is found or the signal turns out to publish over zmq
+  /// The time between looks doubles up to max_probe_interval, a signal which is not up is not looked for every second.
+  void probe_shm()
+    requires concepts::fixed_size_value<value_t>
+  {
+    shm_probe_.expires_after(shm_probe_interval_);
+    shm_probe_.async_wait([this, generation = generation_](std::error_code const& err) {
+      if (err || generation != generation_ || !probing_) {
+        return;
+      }
+      if (attach_shm()) {
+        probing_ = false;
+        return;
+      }
+      shm_probe_interval_ = std::min(shm_probe_interval_ * 2, std::chrono::seconds{ max_probe_interval });
+      probe_shm();
+    });
+  }
+
+  /// \brief stop probing once the zmq handshake with the signal succeeds, signals publishing over shared memory do not
+  /// bind their zmq endpoint. Probing resumes when the signal disconnects, it may publish over shared memory when it
+  /// comes back.
+  void watch_zmq_connection()
+    requires concepts::fixed_size_value<value_t>
+  {
+    zmq_monitor_->async_receive([this, generation = generation_](std::error_code const& err, azmq::message& msg,
+                                                                 std::size_t) {
+      if (err || generation != generation_ || !zmq_monitor_) {
+        return;
+      }
+      std::uint16_t event{};
+      if (auto const buffer{ msg.buffer() }; buffer.size() >= sizeof(event)) {
+        std::memcpy(&event, buffer.data(), sizeof(event));
+      }
+      // the second frame of an event holds the endpoint
+      std::array<std::byte, 1024> endpoint{};
+      boost::system::error_code ignore{};
+      zmq_monitor_->receive(asio::buffer(endpoint), 0, ignore);
+      if (event == ZMQ_EVENT_HANDSHAKE_SUCCEEDED) {
+        probing_ = false;
+        shm_probe_.cancel();
+      } else if (event == ZMQ_EVENT_DISCONNECTED && !probing_ && !shm_) {
+        probing_ = true;
+        shm_probe_interval_ = reconnect_interval;
+        probe_shm();
+      }
+      watch_zmq_connection();
+    });
+  }
+
+  /// \brief deserialize straight from the message storage, the header is validated before the payload is touched
+  auto deserialize(azmq::message const& message) -> std::expected<value_t, std::error_code> {
+    sampled_at_ = std::chrono::steady_clock::now();
+    auto const buffer{ message.buffer() };
+    return packet_t::deserialize(std::span{ static_cast<std::byte const*>(buffer.data()), buffer.size() });
+  }
+
+  /// \return next value from the shared memory region, std::nullopt if nothing new has been published
+  auto read_shm() -> std::optional<std::expected<value_t, std::error_code>>
+    requires concepts::fixed_size_value<value_t>
+  {
+    std::array<std::byte, packet_t::max_size()> buffer{};
+    auto const& region{ shm_->mapping() };
+    while (true) {
+      auto size{ region.read(shm_index_, buffer, sampled_at_) };
+      if (size) {
+        shm_index_++;
+        return packet_t::deserialize(std::span{ buffer.data(), size.value() });
+      }
+      if (size.error() != std::errc::no_buffer_space) {
+        return std::nullopt;
+      }
+      // The writer lapped this reader, skip ahead to the latest value
+      shm_index_ = region.write_index() - 1;
+    }
+  }
+
   azmq::sub_socket socket_;
+  asio::steady_timer timer_;
+  asio::steady_timer shm_probe_;
+  std::chrono::seconds shm_probe_interval_{ reconnect_interval };
+  std::optional<azmq::socket> zmq_monitor_{};
+  std::string signal_name_{};
+  std::unique_ptr<shm::listener> shm_{};
+  std::uint64_t shm_index_{};
+  std::chrono::steady_clock::time_point sampled_at_{};
+  std::uint64_t generation_{};
+  bool probing_{ false };
+  std::shared_ptr<void> lifetime_{ std::make_shared<bool>() };
 };
 
 template <typename type_desc>
@@ -332,6 +596,9 @@ public:
 
   [[nodiscard]] auto full_name() const -> std::string { return slot_.full_name(); }
 
+  /// \return time the last received value was sampled, see slot::sampled_at
+  [[nodiscard]] auto sampled_at() const noexcept -> std::chrono::steady_clock::time_point { return slot_.sampled_at(); }
+
 private:
   slot_callback(asio::io_context& ctx, std::string_view name) : slot_{ ctx, name } {}
   void async_new_state(std::expected<value_t, std::error_code> new_value, tfc::stx::invocable<value_t> auto&& callback) {
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include <tfc/ipc/enums.hpp>
+
+namespace tfc::ipc::details {
+
+/// \brief Transport used by a signal to publish its values
+/// Slots detect the transport of the signal they are connected to, no configuration is needed on the receiving end.
+enum struct transport_e : std::uint8_t {
+  zmq = 0,  // azmq pub/sub over ipc:// sockets, supports every type
+  shm,      // shared memory ring under /dev/shm, only for fixed size types, falls back to zmq otherwise
+};
+
+namespace shm {
+
+namespace asio = boost::asio;
+
+class listener;
+class waiter;
+
+/// \brief Time at which the values published on this thread were sampled, for as long as it is in scope
+/// Entries are stamped with the time they are published unless a sample_time is in scope. A process which samples its
+/// inputs in cycles puts the time of the cycle in scope while it hands their values out, so readers see when a value
+/// was sampled rather than when it was delivered.
+class sample_time {
+public:
+  explicit sample_time(std::chrono::steady_clock::time_point sampled_at) noexcept;
+  sample_time(sample_time const&) = delete;
+  sample_time(sample_time&&) noexcept = delete;
+  auto operator=(sample_time const&) -> sample_time& = delete;
+  auto operator=(sample_time&&) noexcept -> sample_time& = delete;
+  ~sample_time();
+
+  /// \return the sample time in scope on this thread, the current time when there is none
+  [[nodiscard]] static auto now() noexcept -> std::chrono::steady_clock::time_point;
+
+private:
+  std::chrono::steady_clock::time_point previous_{};
+};
+
+/// \brief Shared memory region backing a single signal
+/// The region is a ring of `capacity` entries, each entry guarded by a seqlock. Each entry holds one serialized
+/// `packet<value_t, type_e>`, the same wire format as used over zmq. There is a single writer (the signal) and
+/// any number of readers (slots). Synchronous readers wait on a futex in the region header, processes listening
+/// asynchronously are subscribed to the region and woken through their doorbell, see listener.
+class region {
+public:
+  static constexpr std::uint32_t default_capacity{ 64 };
+
+  /// \brief create the region for the given signal, replaces regions left behind by a previous owner
+  /// Readers of a replaced region are told it is closed.
+  /// \param signal_name full name of the signal, see transmission_base::full_name
+  /// \param type type of packets stored in the region
+  /// \param entry_size maximum size of a serialized packet
+  /// \param capacity number of entries in the ring, must be a power of two
+  [[nodiscard]] static auto create(std::string_view signal_name,
+                                   type_e type,
+                                   std::size_t entry_size,
+                                   std::uint32_t capacity = default_capacity) -> std::expected<region, std::error_code>;
+
+  /// \brief open an existing region of the given signal for reading
+  /// \return std::errc::no_such_file_or_directory if the signal does not publish over shared memory
+  [[nodiscard]] static auto open(std::string_view signal_name, type_e type, std::size_t entry_size)
+      -> std::expected<region, std::error_code>;
+
+  /// \return name of the shared memory object, relative to /dev/shm
+  [[nodiscard]] static auto object_name(std::string_view signal_name) -> std::string;
+
+  region(region const&) = delete;
+  auto operator=(region const&) -> region& = delete;
+  region(region&&) noexcept;
+  auto operator=(region&&) noexcept -> region&;
+  ~region();
+
+  /// \brief writer only, copy the serialized packet into the next entry and wake readers
+  void publish(std::span<std::byte const> packet) noexcept { publish(packet, {}); }
+
+  /// \brief writer only, gather header and payload into the next entry and wake readers
+  /// The entry is stamped with sample_time::now()
+  void publish(std::span<std::byte const> header, std::span<std::byte const> payload) noexcept;
+
+  /// \brief reader only, copy entry `index` to `out`
+  /// \return size of the packet or
+  /// std::errc::resource_unavailable_try_again if the entry has not been published yet
+  /// std::errc::no_buffer_space if the writer has lapped the reader and the entry is gone
+  [[nodiscard]] auto read(std::uint64_t index, std::span<std::byte> out) const noexcept
+      -> std::expected<std::size_t, std::error_code>;
+
+  /// \brief reader only, copy entry `index` to `out` and the time its value was sampled to `sampled_at`
+  /// \return same as read(index, out), `sampled_at` is only written on success
+  [[nodiscard]] auto read(std::uint64_t index,
+                          std::span<std::byte> out,
+                          std::chrono::steady_clock::time_point& sampled_at) const noexcept
+      -> std::expected<std::size_t, std::error_code>;
+
+  /// \return index of the next entry to be published
+  [[nodiscard]] auto write_index() const noexcept -> std::uint64_t;
+
+  [[nodiscard]] auto capacity() const noexcept -> std::uint32_t;
+
+  [[nodiscard]] auto entry_size() const noexcept -> std::size_t;
+
+  /// \return true if the writer has closed the region
+  [[nodiscard]] auto closed() const noexcept -> bool;
+
+  /// \return true if the shared memory object has been unlinked or replaced by a new writer
+  /// \note performs a stat syscall, not intended for the hot path
+  [[nodiscard]] auto replaced() const noexcept -> bool;
+
+  /// \return current value of the futex word, incremented on each publish
+  [[nodiscard]] auto notify_word() const noexcept -> std::uint32_t;
+
+  /// \brief block until the futex word differs from `observed` or `timeout` elapses
+  void wait(std::uint32_t observed, std::chrono::milliseconds timeout) const noexcept;
+
+  /// \brief wake every reader waiting on this region
+  void wake_all() const noexcept;
+
+private:
+  friend class listener;
+  friend class waiter;
+  struct header;
+  struct entry;
+
+  /// \brief ring the doorbells of the processes listening to this region
+  static void ring_subscribers(header const& head) noexcept;
+  void subscribe(std::size_t doorbell) const noexcept;
+  void unsubscribe(std::size_t doorbell) const noexcept;
+
+  region(int file_descriptor, std::byte* memory, std::size_t size, std::string name, bool owner) noexcept;
+  [[nodiscard]] auto get_header() const noexcept -> header*;
+  [[nodiscard]] auto entry_at(std::uint64_t index) const noexcept -> entry*;
+  void release() noexcept;
+
+  int fd_{ -1 };
+  std::byte* memory_{ nullptr };
+  std::size_t size_{};
+  std::string name_{};
+  bool owner_{ false };
+};
+
+/// \brief Listens for publishes on a region and relays them to an asio executor
+/// A process has a single doorbell, a futex every region it listens to rings on publish. One thread per process,
+/// shared by all of its listeners, sleeps on the doorbell and wakes the asio handlers of the regions which changed,
+/// one handler posted per executor for all of them.
+class listener {
+public:
+  /// \return std::errc::too_many_files_open if every doorbell on the machine is taken
+  [[nodiscard]] static auto create(asio::any_io_executor executor, region&& reg)
+      -> std::expected<std::unique_ptr<listener>, std::error_code>;
+
+  listener(listener const&) = delete;
+  listener(listener&&) noexcept = delete;
+  auto operator=(listener const&) -> listener& = delete;
+  auto operator=(listener&&) noexcept -> listener& = delete;
+  ~listener();
+
+  [[nodiscard]] auto mapping() const noexcept -> region const& { return region_; }
+
+  /// \return true when the region has been closed or replaced, the owner should reconnect
+  [[nodiscard]] auto detached() const noexcept -> bool { return state_->detached.load(std::memory_order_acquire); }
+
+  /// \return token which expires when this listener is destroyed
+  [[nodiscard]] auto alive() const noexcept -> std::weak_ptr<void> { return state_; }
+
+  /// \brief wait for the next publish on the region
+  /// Completes right away if something was published since the previous wait completed.
+  /// \note the handler receives operation_aborted in both the notify case and the teardown case,
+  /// check `alive` to distinguish between the two.
+  template <typename completion_token_t>
+  auto async_wait(completion_token_t&& token) {
+    if (state_->missed) {
+      state_->missed = false;
+      // posted, the wait below is in place by the time it runs
+      asio::post(state_->notify.get_executor(), [weak_state = std::weak_ptr{ state_ }] {
+        if (auto state = weak_state.lock()) {
+          state->wake();
+        }
+      });
+    }
+    return state_->notify.async_wait(std::forward<completion_token_t>(token));
+  }
+
+private:
+  friend class waiter;
+
+  struct state_t {
+    explicit state_t(asio::any_io_executor executor) : notify{ std::move(executor) } {
+      notify.expires_at(asio::steady_timer::time_point::max());
+    }
+    /// \brief complete the pending wait, or the next one if none is pending
+    void wake() {
+      pending.store(false, std::memory_order_release);
+      if (notify.cancel() == 0) {
+        missed = true;
+      }
+    }
+    asio::steady_timer notify;
+    bool missed{ false };  // only touched from the executor
+    std::atomic<bool> pending{ false };
+    std::atomic<bool> detached{ false };
+  };
+
+  listener(region&& reg, std::shared_ptr<state_t> state, std::shared_ptr<waiter> shared_waiter) noexcept;
+
+  region region_;
+  std::shared_ptr<state_t> state_;
+  std::shared_ptr<waiter> waiter_;
+};
+
+}  // namespace shm
+
+}  // namespace tfc::ipc::details
@@ -1,15 +1,19 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
 #include <expected>
+#include <optional>
 #include <ranges>
+#include <span>
 #include <type_traits>
 #include <vector>
 
+#include <tfc/ipc/details/type_description.hpp>
 #include <tfc/ipc/enums.hpp>
 
 namespace tfc::ipc::details {
@@ -32,6 +36,13 @@ struct header_t {
     std::copy_n(reinterpret_cast<std::byte*>(&header.type), sizeof(type), std::back_inserter(buffer));
     std::copy_n(reinterpret_cast<std::byte*>(&header.value_size), sizeof(value_size), std::back_inserter(buffer));
   }
+  static void serialize_into(header_t const& header, std::span<std::byte> buffer) noexcept {
+    assert(buffer.size() >= size());
+    auto iter{ buffer.begin() };
+    iter = std::copy_n(reinterpret_cast<std::byte const*>(&header.version), sizeof(version), iter);
+    iter = std::copy_n(reinterpret_cast<std::byte const*>(&header.type), sizeof(type), iter);
+    std::copy_n(reinterpret_cast<std::byte const*>(&header.value_size), sizeof(value_size), iter);
+  }
   static auto deserialize(header_t& result, auto&& buffer_iter) -> std::error_code {
     std::copy_n(buffer_iter, sizeof(version), reinterpret_cast<std::byte*>(&result.version));
     buffer_iter += sizeof(version);
@@ -52,6 +63,63 @@ struct header_t {
 };
 static_assert(header_t<type_e::unknown>::size() == 10);
 
+namespace concepts {
+/// \brief value types whose serialized packet has a known upper bound in size
+template <typename value_t>
+concept fixed_size_value = std::is_fundamental_v<value_t> || is_expected_quantity<value_t>;
+}  // namespace concepts
+
+template <typename value_type, type_e type_enum>
+struct packet;
+
+/// \brief A serialized packet ready to be written, without any heap allocation
+/// The header and fixed size payloads are stored inline, string payloads are a view into the serialized value.
+template <type_e type_enum>
+class serialized_packet {
+public:
+  // largest fixed size payload is std::expected<quantity<int64_t>, enum>, 9 bytes
+  static constexpr std::size_t inline_capacity{ 16 };
+
+  [[nodiscard]] auto header() const noexcept -> std::span<std::byte const> {
+    return std::span{ storage_ }.first(header_t<type_enum>::size());
+  }
+
+  [[nodiscard]] auto payload() const noexcept -> std::span<std::byte const> {
+    if (!external_.empty()) {
+      return external_;
+    }
+    return std::span{ storage_ }.subspan(header_t<type_enum>::size(), inline_size_);
+  }
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return header_t<type_enum>::size() + payload().size(); }
+
+  /// \return header and payload in one span when the payload is stored inline
+  [[nodiscard]] auto contiguous() const noexcept -> std::optional<std::span<std::byte const>> {
+    if (!external_.empty()) {
+      return std::nullopt;
+    }
+    return std::span{ storage_ }.first(header_t<type_enum>::size() + inline_size_);
+  }
+
+  /// \return header and payload, in order, for scatter-gather writes
+  [[nodiscard]] auto buffers() const noexcept -> std::array<std::span<std::byte const>, 2> { return { header(), payload() }; }
+
+  void append_to(std::vector<std::byte>& buffer) const {
+    buffer.reserve(buffer.size() + size());
+    for (auto const part : buffers()) {
+      buffer.insert(buffer.end(), part.begin(), part.end());
+    }
+  }
+
+private:
+  template <typename, type_e>
+  friend struct packet;
+
+  std::array<std::byte, header_t<type_enum>::size() + inline_capacity> storage_{};
+  std::size_t inline_size_{};
+  std::span<std::byte const> external_{};
+};
+
 /// \brief packet struct to de/serialize data to socket
 template <typename value_type, type_e type_enum>
 struct packet {
@@ -61,21 +129,50 @@ struct packet {
   header_t<type_enum> header{};
   value_t value{};
 
-  // value size is populated
-  static auto serialize(value_t const& value, std::vector<std::byte>& buffer) -> std::error_code {
-    header_t<type_enum> my_header{};
+  /// \return upper bound of a serialized packet of value_t, header included
+  static constexpr auto max_size() noexcept -> std::size_t
+    requires concepts::fixed_size_value<value_t>
+  {
+    if constexpr (std::is_fundamental_v<value_t>) {
+      return header_t<type_enum>::size() + sizeof(value_t);
+    } else {
+      // + 1 byte to indicate whether it is expected or unexpected
+      return header_t<type_enum>::size() + 1 +
+             std::max(sizeof(typename value_t::value_type::rep), sizeof(typename value_t::error_type));
+    }
+  }
+
+  /// \brief serialize into a stack allocated header, the payload is stored inline or viewed in place
+  /// \note for string types the result refers to `value` which must outlive it and stay unchanged
+  static auto serialize(value_t const& value) -> std::expected<serialized_packet<type_enum>, std::error_code> {
+    using header_type = header_t<type_enum>;
+    if constexpr (concepts::fixed_size_value<value_t>) {
+      static_assert(max_size() <= header_type::size() + serialized_packet<type_enum>::inline_capacity);
+    }
+    serialized_packet<type_enum> result{};
+    header_type my_header{};
+    auto payload{ std::span{ result.storage_ }.subspan(header_type::size()) };
 
     if constexpr (std::is_fundamental_v<value_t>) {
       my_header.value_size = sizeof(value_t);
+      std::copy_n(reinterpret_cast<std::byte const*>(&value), sizeof(value_t), payload.begin());
+      result.inline_size_ = sizeof(value_t);
     } else if constexpr (concepts::is_expected_quantity<value_t>) {
       if constexpr (std::is_enum_v<typename value_t::error_type>) {
         // + 1 byte to indicate whether it is expected or unexpected
         static_assert(std::is_fundamental_v<typename value_t::value_type::rep>);
         if (value.has_value()) {
           my_header.value_size = sizeof(typename value_t::value_type::rep{}) + 1;
+          payload[0] = std::byte{ static_cast<std::uint8_t>(true) };  // indicate this is expected
+          std::copy_n(reinterpret_cast<std::byte const*>(&value.value()), sizeof(typename value_t::value_type::rep),
+                      std::next(payload.begin()));
         } else {
           my_header.value_size = sizeof(typename value_t::error_type{}) + 1;
+          payload[0] = std::byte{ static_cast<std::uint8_t>(false) };  // indicate this is unexpected
+          std::copy_n(reinterpret_cast<std::byte const*>(&value.error()), sizeof(typename value_t::error_type),
+                      std::next(payload.begin()));
         }
+        result.inline_size_ = my_header.value_size;
       } else {
         []<bool flag = false> {
           static_assert(flag, "Only std::expected<quantity, enum> is supported.");
@@ -85,56 +182,62 @@ struct packet {
     } else {
       static_assert(std::is_member_function_pointer_v<decltype(&value_t::size)>, "Serialize for value type not supported");
       static_assert(std::is_same_v<decltype(value_t().size()), std::size_t>);
-      my_header.value_size = value.size();
-    }
-
-    const std::size_t buffer_size{ header_t<type_enum>::size() + my_header.value_size };
-    buffer.reserve(buffer_size);
-    header_t<type_enum>::serialize(my_header, buffer);
-
-    if constexpr (std::is_fundamental_v<value_t>) {
-      std::copy_n(reinterpret_cast<std::byte const*>(&value), my_header.value_size, std::back_inserter(buffer));
-    } else if constexpr (concepts::is_expected_quantity<value_t>) {
-      if (value.has_value()) {
-        buffer.push_back(std::byte{ static_cast<std::uint8_t>(true) });  // indicate this is expected
-        std::copy_n(reinterpret_cast<std::byte const*>(&value.value()), sizeof(typename value_t::value_type::rep),
-                    std::back_inserter(buffer));
-      } else {
-        buffer.push_back(std::byte{ static_cast<std::uint8_t>(false) });  // indicate this is unexpected
-        std::copy_n(reinterpret_cast<std::byte const*>(&value.error()), sizeof(typename value_t::error_type),
-                    std::back_inserter(buffer));
-      }
-    } else {
       // has member function data
       static_assert(std::is_pointer_v<decltype(value.data())>);
-      // Todo why copy the data instead of creating a view into the data?
-      // we should use std::span
-      std::copy_n(reinterpret_cast<std::byte const*>(value.data()), my_header.value_size, std::back_inserter(buffer));
+      my_header.value_size = value.size();
+      result.external_ = std::as_bytes(std::span{ value.data(), value.size() });
     }
 
-    if (buffer.size() != buffer_size) {
-      return std::make_error_code(std::errc::message_size);
+    header_type::serialize_into(my_header, result.storage_);
+    return result;
+  }
+
+  /// \brief serialize by appending header and payload to buffer
+  static auto serialize(value_t const& value, std::vector<std::byte>& buffer) -> std::error_code {
+    auto serialized{ serialize(value) };
+    if (!serialized) {
+      return serialized.error();
     }
+    serialized->append_to(buffer);
     return {};
   }
 
-  static constexpr auto deserialize(std::ranges::view auto&& buffer) -> std::expected<value_t, std::error_code> {
+  /// \brief read and validate the header in front of a serialized packet, the payload is not touched
+  /// \return the header if `buffer` holds exactly one packet of this type
+  static constexpr auto peek_header(std::span<std::byte const> buffer) -> std::expected<header_t<type_enum>, std::error_code> {
     if (buffer.size() < header_t<type_enum>::size()) {
       return std::unexpected(std::make_error_code(std::errc::message_size));
     }
-
-    packet<value_t, type_v> result{};
+    header_t<type_enum> header{};
     auto buffer_iter{ std::begin(buffer) };
-    header_t<type_enum>::deserialize(result.header, buffer_iter);
-
-    if (result.header.type != type_v) {
+    if (header_t<type_enum>::deserialize(header, buffer_iter)) {
       return std::unexpected{ std::make_error_code(std::errc::bad_message) };
     }
-
-    // todo partial buffer?
-    if (buffer.size() != header_t<type_enum>::size() + result.header.value_size) {
+    // never copy more than the value can hold
+    if constexpr (std::is_fundamental_v<value_t>) {
+      if (header.value_size != sizeof(value_t)) {
+        return std::unexpected(std::make_error_code(std::errc::message_size));
+      }
+    } else if constexpr (concepts::is_expected_quantity<value_t>) {
+      if (header.value_size < 2 || header.value_size > max_size() - header_t<type_enum>::size()) {
+        return std::unexpected(std::make_error_code(std::errc::message_size));
+      }
+    }
+    if (buffer.size() != header_t<type_enum>::size() + header.value_size) {
       return std::unexpected(std::make_error_code(std::errc::message_size));
     }
+    return header;
+  }
+
+  static constexpr auto deserialize(std::ranges::view auto&& buffer) -> std::expected<value_t, std::error_code> {
+    std::span<std::byte const> const bytes{ std::ranges::data(buffer), std::ranges::size(buffer) };
+    auto header{ peek_header(bytes) };
+    if (!header) {
+      return std::unexpected(header.error());
+    }
+
+    packet<value_t, type_v> result{ .header = header.value() };
+    auto buffer_iter{ std::next(bytes.begin(), header_t<type_enum>::size()) };
 
     if constexpr (std::is_fundamental_v<value_t>) {
       static_assert(sizeof(value_t) <= 8);
@@ -132,6 +132,41 @@ auto ipc_manager_client::connections(std::function<void(std::map<std::string, st
         }
       });
 }
+auto ipc_manager_client::changes_since(std::uint64_t sequence,
+                                       std::function<void(std::error_code const&, std::vector<change> const&)>&& handler)
+    -> void {
+  connection_->async_method_call(
+      [captured_handler = std::move(handler)](const boost::system::error_code& error, const std::string& response) {
+        if (error) {
+          captured_handler(error, {});
+          return;
+        }
+        auto changes = glz::read_json<std::vector<change>>(response);
+        if (!changes) {
+          fmt::println(stderr, "Changes since parse error: {}", glz::format_error(changes.error(), response));
+          captured_handler(std::make_error_code(std::errc::bad_message), {});
+          return;
+        }
+        captured_handler({}, changes.value());
+      },
+      ipc_ruler_service_name_, ipc_ruler_object_path_, ipc_ruler_interface_name_, consts::changes_since_method.data(),
+      sequence);
+}
+auto ipc_manager_client::register_changes_callback(const std::function<void(change const&)>& change_callback)
+    -> std::unique_ptr<sdbusplus::bus::match::match> {
+  namespace rules = sdbusplus::bus::match::rules;
+  return make_match(rules::type::signal() + rules::sender(ipc_ruler_service_name_) + rules::path(ipc_ruler_object_path_) +
+                        rules::interface(ipc_ruler_interface_name_) + rules::member(std::string{ consts::changes_signal }),
+                    [change_callback](sdbusplus::message_t& msg) {
+                      auto const [sequence, json] = msg.unpack<std::tuple<std::uint64_t, std::string>>();
+                      auto entry = glz::read_json<change>(json);
+                      if (!entry) {
+                        fmt::println(stderr, "Change {} parse error: {}", sequence, glz::format_error(entry.error(), json));
+                        return;
+                      }
+                      change_callback(entry.value());
+                    });
+}
 auto ipc_manager_client::connect(std::string_view slot_name,
                                  std::string_view signal_name,
                                  std::function<void(std::error_code const&)>&& handler) -> void {
@@ -160,6 +195,9 @@ auto ipc_manager_client::make_match(const std::string& match_rule,
   return std::make_unique<sdbusplus::bus::match::match>(*connection_, match_rule, callback);
 }
 auto ipc_manager_client::match_callback(sdbusplus::message_t& msg) -> void {
+  if (std::string_view{ msg.get_member() } != consts::connection_change) {
+    return;
+  }
   auto container = msg.unpack<std::tuple<std::string, std::string>>();
   std::string const slot_name = std::get<0>(container);
   std::string const signal_name = std::get<1>(container);
@@ -0,0 +1,593 @@
+#include <tfc/ipc/details/shm.hpp>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <csignal>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <boost/asio/post.hpp>
+
+#include <tfc/utils/pragmas.hpp>
+
+namespace tfc::ipc::details::shm {
+
+namespace {
+constexpr std::uint32_t region_magic{ 0x74666373 };  // "tfcs"
+constexpr std::uint8_t region_version{ 3 };
+constexpr std::size_t cache_line{ 64 };
+constexpr std::string_view dev_shm{ "/dev/shm" };
+constexpr std::string_view doorbell_table_name{ "/tfc.ipc.doorbells" };
+constexpr std::size_t doorbell_count{ 256 };
+constexpr std::size_t subscriber_bits{ 64 };
+
+constexpr auto round_up(std::size_t value, std::size_t alignment) noexcept -> std::size_t {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+auto futex(std::atomic<std::uint32_t>* word, int operation, std::uint32_t value, timespec const* timeout) noexcept -> long {
+  static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t));
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+  return syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(word), operation, value, timeout, nullptr, 0);
+}
+
+// see sample_time, the epoch when none is in scope
+thread_local std::chrono::steady_clock::time_point sample_time_in_scope{};
+
+auto errno_code() noexcept -> std::error_code {
+  return { errno, std::generic_category() };
+}
+
+/// \brief woken by writers of the regions its process listens to
+struct alignas(cache_line) doorbell {
+  std::atomic<std::int32_t> pid{ 0 };  // owning process, 0 when free
+  std::atomic<std::uint32_t> word{ 0 };
+  std::atomic<std::uint32_t> waiters{ 0 };
+};
+
+/// \brief doorbells of every listening process on the machine, all zero is a valid initial state
+struct doorbell_table {
+  std::array<doorbell, doorbell_count> doorbells;
+};
+
+/// \return the doorbell table, created by the first process needing it, nullptr if it cannot be mapped
+auto doorbells() noexcept -> doorbell_table* {
+  static doorbell_table* const table{ []() -> doorbell_table* {
+    int const file_descriptor{ ::shm_open(doorbell_table_name.data(), O_CREAT | O_RDWR | O_CLOEXEC, 0660) };
+    if (file_descriptor == -1) {
+      return nullptr;
+    }
+    // processes creating the table at the same time truncate it to the same size, the memory stays zero filled
+    struct stat info {};
+    if (::fstat(file_descriptor, &info) == -1 ||
+        (static_cast<std::size_t>(info.st_size) < sizeof(doorbell_table) &&
+         ::ftruncate(file_descriptor, static_cast<off_t>(sizeof(doorbell_table))) == -1)) {
+      ::close(file_descriptor);
+      return nullptr;
+    }
+    void* memory{ ::mmap(nullptr, sizeof(doorbell_table), PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0) };
+    ::close(file_descriptor);
+    if (memory == MAP_FAILED) {
+      return nullptr;
+    }
+    return std::launder(reinterpret_cast<doorbell_table*>(memory));
+  }() };
+  return table;
+}
+
+void ring(doorbell& bell) noexcept {
+  bell.word.fetch_add(1, std::memory_order_seq_cst);
+  // Only pay for the syscall if the waiter is actually sleeping
+  if (bell.waiters.load(std::memory_order_seq_cst) > 0) {
+    futex(&bell.word, FUTEX_WAKE, INT_MAX, nullptr);
+  }
+}
+
+/// \return index of a doorbell now owned by this process, taken over from a process which has exited if need be
+auto claim_doorbell(doorbell_table& table) noexcept -> std::optional<std::size_t> {
+  auto const pid{ static_cast<std::int32_t>(::getpid()) };
+  for (std::size_t idx{ 0 }; idx < table.doorbells.size(); idx++) {
+    auto& bell{ table.doorbells[idx] };
+    auto owner{ bell.pid.load(std::memory_order_acquire) };
+    if (owner != 0 && (owner == pid || ::kill(owner, 0) == 0 || errno != ESRCH)) {
+      continue;
+    }
+    if (bell.pid.compare_exchange_strong(owner, pid, std::memory_order_acq_rel)) {
+      return idx;
+    }
+  }
+  return std::nullopt;
+}
+}  // namespace
+
+struct region::header {
+  std::atomic<std::uint32_t> magic{ 0 };
+  std::uint8_t version{ region_version };
+  type_e type{ type_e::unknown };
+  std::uint32_t capacity{};
+  std::uint64_t entry_size{};
+  std::uint64_t entry_stride{};
+  alignas(cache_line) std::atomic<std::uint64_t> write_index{ 0 };
+  alignas(cache_line) std::atomic<std::uint32_t> notify{ 0 };
+  std::atomic<std::uint32_t> waiters{ 0 };  // synchronous readers sleeping on notify
+  std::atomic<std::uint32_t> closed{ 0 };
+  // bit per doorbell of the processes listening to the region
+  std::array<std::atomic<std::uint64_t>, doorbell_count / subscriber_bits> subscribers{};
+};
+
+struct region::entry {
+  // odd while the writer is copying, 2 * index + 2 when entry `index` is complete
+  std::atomic<std::uint64_t> sequence{ 0 };
+  std::uint64_t size{};
+  std::int64_t sampled_at{};  // steady clock nanoseconds, see sample_time
+  // followed by entry_size bytes of packet data
+  [[nodiscard]] auto data() noexcept -> std::byte* { return reinterpret_cast<std::byte*>(this) + sizeof(entry); }
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free);
+
+sample_time::sample_time(std::chrono::steady_clock::time_point sampled_at) noexcept
+    : previous_{ std::exchange(sample_time_in_scope, sampled_at) } {}
+
+sample_time::~sample_time() {
+  sample_time_in_scope = previous_;
+}
+
+auto sample_time::now() noexcept -> std::chrono::steady_clock::time_point {
+  if (sample_time_in_scope == std::chrono::steady_clock::time_point{}) {
+    return std::chrono::steady_clock::now();
+  }
+  return sample_time_in_scope;
+}
+
+auto region::object_name(std::string_view signal_name) -> std::string {
+  std::string name{ fmt::format("/tfc.ipc.{}", signal_name) };
+  // slashes are not allowed in the name of a shared memory object, except for the leading one
+  std::replace(std::next(name.begin()), name.end(), '/', '_');
+  return name;
+}
+
+auto region::create(std::string_view signal_name, type_e type, std::size_t entry_size, std::uint32_t capacity)
+    -> std::expected<region, std::error_code> {
+  if (!std::has_single_bit(capacity)) {
+    return std::unexpected(std::make_error_code(std::errc::invalid_argument));
+  }
+  if (doorbells() == nullptr) {
+    return std::unexpected(std::make_error_code(std::errc::not_enough_memory));
+  }
+  auto name{ object_name(signal_name) };
+  // Remove whatever a previous owner left behind, readers still attached to it are told it is closed and reconnect
+  if (auto previous{ open(signal_name, type, 0) }) {
+    previous->get_header()->closed.store(1, std::memory_order_release);
+    previous->wake_all();
+  }
+  ::shm_unlink(name.c_str());
+  int const file_descriptor{ ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC, 0660) };
+  if (file_descriptor == -1) {
+    return std::unexpected(errno_code());
+  }
+  std::size_t const stride{ round_up(sizeof(entry) + entry_size, cache_line) };
+  std::size_t const size{ round_up(sizeof(header), cache_line) + stride * capacity };
+  if (::ftruncate(file_descriptor, static_cast<off_t>(size)) == -1) {
+    auto error{ errno_code() };
+    ::close(file_descriptor);
+    ::shm_unlink(name.c_str());
+    return std::unexpected(error);
+  }
+  void* memory{ ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0) };
+  if (memory == MAP_FAILED) {
+    auto error{ errno_code() };
+    ::close(file_descriptor);
+    ::shm_unlink(name.c_str());
+    return std::unexpected(error);
+  }
+  auto* head{ new (memory) header{} };
+  head->type = type;
+  head->capacity = capacity;
+  head->entry_size = entry_size;
+  head->entry_stride = stride;
+  region result{ file_descriptor, static_cast<std::byte*>(memory), size, std::move(name), true };
+  for (std::uint64_t idx{ 0 }; idx < capacity; idx++) {
+    new (result.entry_at(idx)) entry{};
+  }
+  // readers validate the magic, publish it last
+  head->magic.store(region_magic, std::memory_order_release);
+  return result;
+}
+
+auto region::open(std::string_view signal_name, type_e type, std::size_t entry_size)
+    -> std::expected<region, std::error_code> {
+  if (doorbells() == nullptr) {
+    return std::unexpected(std::make_error_code(std::errc::not_enough_memory));
+  }
+  auto name{ object_name(signal_name) };
+  // read and write, readers register themselves as futex waiters and subscribers in the header
+  int const file_descriptor{ ::shm_open(name.c_str(), O_RDWR | O_CLOEXEC, 0) };
+  if (file_descriptor == -1) {
+    return std::unexpected(errno_code());
+  }
+  struct stat info {};
+  if (::fstat(file_descriptor, &info) == -1) {
+    auto error{ errno_code() };
+    ::close(file_descriptor);
+    return std::unexpected(error);
+  }
+  auto const size{ static_cast<std::size_t>(info.st_size) };
+  if (size < sizeof(header)) {
+    ::close(file_descriptor);
+    return std::unexpected(std::make_error_code(std::errc::protocol_error));
+  }
+  void* memory{ ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0) };
+  if (memory == MAP_FAILED) {
+    auto error{ errno_code() };
+    ::close(file_descriptor);
+    return std::unexpected(error);
+  }
+  // from here on the region destructor cleans up
+  region result{ file_descriptor, static_cast<std::byte*>(memory), size, std::move(name), false };
+  auto const* head{ result.get_header() };
+  if (head->magic.load(std::memory_order_acquire) != region_magic || head->version != region_version) {
+    return std::unexpected(std::make_error_code(std::errc::protocol_error));
+  }
+  if (head->type != type) {
+    return std::unexpected(std::make_error_code(std::errc::wrong_protocol_type));
+  }
+  if (head->entry_size < entry_size ||
+      round_up(sizeof(header), cache_line) + head->entry_stride * head->capacity > size) {
+    return std::unexpected(std::make_error_code(std::errc::message_size));
+  }
+  return result;
+}
+
+region::region(int file_descriptor, std::byte* memory, std::size_t size, std::string name, bool owner) noexcept
+    : fd_{ file_descriptor }, memory_{ memory }, size_{ size }, name_{ std::move(name) }, owner_{ owner } {}
+
+region::region(region&& other) noexcept
+    : fd_{ std::exchange(other.fd_, -1) }, memory_{ std::exchange(other.memory_, nullptr) },
+      size_{ std::exchange(other.size_, 0) }, name_{ std::move(other.name_) }, owner_{ std::exchange(other.owner_, false) } {}
+
+auto region::operator=(region&& other) noexcept -> region& {
+  if (this != &other) {
+    release();
+    fd_ = std::exchange(other.fd_, -1);
+    memory_ = std::exchange(other.memory_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    name_ = std::move(other.name_);
+    owner_ = std::exchange(other.owner_, false);
+  }
+  return *this;
+}
+
+region::~region() {
+  release();
+}
+
+void region::release() noexcept {
+  if (memory_ != nullptr) {
+    if (owner_) {
+      get_header()->closed.store(1, std::memory_order_release);
+      wake_all();
+      // a new writer may already have taken over the name, in that case it is not ours to remove
+      if (!replaced()) {
+        ::shm_unlink(name_.c_str());
+      }
+    }
+    ::munmap(memory_, size_);
+    memory_ = nullptr;
+  }
+  if (fd_ != -1) {
+    ::close(fd_);
+    fd_ = -1;
+  }
+}
+
+auto region::get_header() const noexcept -> header* {
+  return std::launder(reinterpret_cast<header*>(memory_));
+}
+
+auto region::entry_at(std::uint64_t index) const noexcept -> entry* {
+  auto const* head{ get_header() };
+  auto const offset{ round_up(sizeof(header), cache_line) + (index & (head->capacity - 1)) * head->entry_stride };
+  return std::launder(reinterpret_cast<entry*>(memory_ + offset));
+}
+
+void region::publish(std::span<std::byte const> header, std::span<std::byte const> payload) noexcept {
+  auto* head{ get_header() };
+  assert(owner_ && "Only the owner of a region may publish");
+  assert(header.size() + payload.size() <= head->entry_size && "Packet does not fit in region entry");
+  // single writer, no contention on the write index
+  auto const index{ head->write_index.load(std::memory_order_relaxed) };
+  auto* slot{ entry_at(index) };
+  slot->sequence.store(2 * index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot->size = header.size() + payload.size();
+  slot->sampled_at = std::chrono::duration_cast<std::chrono::nanoseconds>(sample_time::now().time_since_epoch()).count();
+  std::memcpy(slot->data(), header.data(), header.size());
+  if (!payload.empty()) {
+    std::memcpy(slot->data() + header.size(), payload.data(), payload.size());
+  }
+  slot->sequence.store(2 * index + 2, std::memory_order_release);
+  head->write_index.store(index + 1, std::memory_order_release);
+  head->notify.fetch_add(1, std::memory_order_seq_cst);
+  // Only pay for the syscall if someone is actually sleeping
+  if (head->waiters.load(std::memory_order_seq_cst) > 0) {
+    futex(&head->notify, FUTEX_WAKE, INT_MAX, nullptr);
+  }
+  ring_subscribers(*head);
+}
+
+void region::ring_subscribers(header const& head) noexcept {
+  auto* table{ doorbells() };
+  for (std::size_t word{ 0 }; word < head.subscribers.size(); word++) {
+    auto bits{ head.subscribers[word].load(std::memory_order_seq_cst) };
+    while (bits != 0) {
+      ring(table->doorbells[word * subscriber_bits + static_cast<std::size_t>(std::countr_zero(bits))]);
+      bits &= bits - 1;
+    }
+  }
+}
+
+void region::subscribe(std::size_t doorbell) const noexcept {
+  get_header()->subscribers[doorbell / subscriber_bits].fetch_or(std::uint64_t{ 1 } << (doorbell % subscriber_bits),
+                                                                std::memory_order_seq_cst);
+}
+
+void region::unsubscribe(std::size_t doorbell) const noexcept {
+  get_header()->subscribers[doorbell / subscriber_bits].fetch_and(~(std::uint64_t{ 1 } << (doorbell % subscriber_bits)),
+                                                                 std::memory_order_seq_cst);
+}
+
+auto region::read(std::uint64_t index, std::span<std::byte> out) const noexcept -> std::expected<std::size_t, std::error_code> {
+  std::chrono::steady_clock::time_point sampled_at{};
+  return read(index, out, sampled_at);
+}
+
+auto region::read(std::uint64_t index, std::span<std::byte> out, std::chrono::steady_clock::time_point& sampled_at)
+    const noexcept -> std::expected<std::size_t, std::error_code> {
+  auto const* head{ get_header() };
+  if (index >= head->write_index.load(std::memory_order_acquire)) {
+    return std::unexpected(std::make_error_code(std::errc::resource_unavailable_try_again));
+  }
+  auto* slot{ entry_at(index) };
+  auto const expected_sequence{ 2 * index + 2 };
+  auto const before{ slot->sequence.load(std::memory_order_acquire) };
+  if (before != expected_sequence) {
+    return std::unexpected(std::make_error_code(std::errc::no_buffer_space));
+  }
+  auto const size{ std::min<std::size_t>(slot->size, head->entry_size) };
+  if (size > out.size()) {
+    return std::unexpected(std::make_error_code(std::errc::message_size));
+  }
+  std::memcpy(out.data(), slot->data(), size);
+  std::chrono::nanoseconds const stamp{ slot->sampled_at };
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (slot->sequence.load(std::memory_order_relaxed) != before) {
+    // the writer wrapped around while we were copying
+    return std::unexpected(std::make_error_code(std::errc::no_buffer_space));
+  }
+  using std::chrono::steady_clock;
+  sampled_at = steady_clock::time_point{ std::chrono::duration_cast<steady_clock::duration>(stamp) };
+  return size;
+}
+
+auto region::write_index() const noexcept -> std::uint64_t {
+  return get_header()->write_index.load(std::memory_order_acquire);
+}
+
+auto region::capacity() const noexcept -> std::uint32_t {
+  return get_header()->capacity;
+}
+
+auto region::entry_size() const noexcept -> std::size_t {
+  return get_header()->entry_size;
+}
+
+auto region::closed() const noexcept -> bool {
+  return get_header()->closed.load(std::memory_order_acquire) != 0;
+}
+
+auto region::replaced() const noexcept -> bool {
+  struct stat mine {};
+  struct stat current {};
+  if (::fstat(fd_, &mine) == -1) {
+    return true;
+  }
+  std::string const path{ fmt::format("{}{}", dev_shm, name_) };
+  if (::stat(path.c_str(), &current) == -1) {
+    return true;
+  }
+  return mine.st_ino != current.st_ino || mine.st_dev != current.st_dev;
+}
+
+auto region::notify_word() const noexcept -> std::uint32_t {
+  return get_header()->notify.load(std::memory_order_seq_cst);
+}
+
+void region::wait(std::uint32_t observed, std::chrono::milliseconds timeout) const noexcept {
+  auto* head{ get_header() };
+  head->waiters.fetch_add(1, std::memory_order_seq_cst);
+  if (head->notify.load(std::memory_order_seq_cst) == observed) {
+    auto const seconds{ std::chrono::duration_cast<std::chrono::seconds>(timeout) };
+    timespec const relative{ .tv_sec = seconds.count(),
+                             .tv_nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(timeout - seconds).count() };
+    // shared between processes, FUTEX_PRIVATE_FLAG must not be used
+    futex(&head->notify, FUTEX_WAIT, observed, &relative);
+  }
+  head->waiters.fetch_sub(1, std::memory_order_seq_cst);
+}
+
+void region::wake_all() const noexcept {
+  auto* head{ get_header() };
+  head->notify.fetch_add(1, std::memory_order_seq_cst);
+  futex(&head->notify, FUTEX_WAKE, INT_MAX, nullptr);
+  ring_subscribers(*head);
+}
+
+/// \brief The thread of a process waiting on its doorbell, shared by all of its listeners
+class waiter {
+public:
+  /// \return the waiter of this process, created by the first listener
+  static auto instance() -> std::expected<std::shared_ptr<waiter>, std::error_code> {
+    static std::mutex mutex{};
+    // clang-format off
+    PRAGMA_CLANG_WARNING_PUSH_OFF(-Wexit-time-destructors)
+    // clang-format on
+    static std::weak_ptr<waiter> current{};
+    PRAGMA_CLANG_WARNING_POP
+    std::scoped_lock const lock{ mutex };
+    if (auto existing{ current.lock() }) {
+      return existing;
+    }
+    auto* table{ doorbells() };
+    if (table == nullptr) {
+      return std::unexpected(std::make_error_code(std::errc::not_enough_memory));
+    }
+    auto const index{ claim_doorbell(*table) };
+    if (!index) {
+      return std::unexpected(std::make_error_code(std::errc::too_many_files_open));
+    }
+    auto created{ std::make_shared<waiter>(table->doorbells[index.value()], index.value()) };
+    current = created;
+    return created;
+  }
+
+  waiter(doorbell& bell, std::size_t index) : bell_{ bell }, index_{ index } {
+    thread_ = std::jthread{ [this](std::stop_token const& stop_token) { run(stop_token); } };
+  }
+  waiter(waiter const&) = delete;
+  waiter(waiter&&) = delete;
+  auto operator=(waiter const&) -> waiter& = delete;
+  auto operator=(waiter&&) -> waiter& = delete;
+  ~waiter() {
+    thread_.request_stop();
+    ring(bell_);
+    thread_.join();
+    bell_.pid.store(0, std::memory_order_release);
+  }
+
+  void add(listener& owner) {
+    std::scoped_lock const lock{ mutex_ };
+    owner.region_.subscribe(index_);
+    // observed after subscribing, whatever is published from here on rings the doorbell
+    entries_.emplace_back(entry{ .owner = &owner,
+                                 .observed = owner.region_.notify_word(),
+                                 .executor = owner.state_->notify.get_executor() });
+  }
+
+  void remove(listener& owner) {
+    std::scoped_lock const lock{ mutex_ };
+    std::erase_if(entries_, [&owner](entry const& item) { return item.owner == &owner; });
+    // other listeners of this process may be on the same region
+    if (std::ranges::none_of(entries_, [&owner](entry const& item) {
+          return item.owner->region_.name_ == owner.region_.name_;
+        })) {
+      owner.region_.unsubscribe(index_);
+    }
+  }
+
+private:
+  struct entry {
+    listener* owner{};
+    std::uint32_t observed{};
+    asio::any_io_executor executor{};
+    bool detached{ false };
+  };
+
+  void run(std::stop_token const& stop_token) {
+    while (!stop_token.stop_requested()) {
+      auto const observed{ bell_.word.load(std::memory_order_seq_cst) };
+      dispatch();
+      bell_.waiters.fetch_add(1, std::memory_order_seq_cst);
+      if (bell_.word.load(std::memory_order_seq_cst) == observed && !stop_token.stop_requested()) {
+        futex(&bell_.word, FUTEX_WAIT, observed, nullptr);
+      }
+      bell_.waiters.fetch_sub(1, std::memory_order_seq_cst);
+    }
+  }
+
+  /// \brief wake the listeners whose region has changed, one handler posted per executor
+  void dispatch() {
+    std::vector<std::pair<asio::any_io_executor, std::vector<std::weak_ptr<listener::state_t>>>> posts{};
+    {
+      std::scoped_lock const lock{ mutex_ };
+      for (auto& item : entries_) {
+        auto const& mapping{ item.owner->region_ };
+        auto const current{ mapping.notify_word() };
+        bool const closed{ mapping.closed() };
+        if ((current == item.observed && !closed) || item.detached) {
+          continue;
+        }
+        item.observed = current;
+        auto& state{ *item.owner->state_ };
+        if (closed) {
+          item.detached = true;
+          state.detached.store(true, std::memory_order_release);
+        }
+        // coalesce notifications, one pending handler is enough to drain the ring
+        if (state.pending.exchange(true, std::memory_order_acq_rel)) {
+          continue;
+        }
+        auto post{ std::ranges::find(posts, item.executor, &decltype(posts)::value_type::first) };
+        if (post == posts.end()) {
+          post = posts.emplace(posts.end(), item.executor, std::vector<std::weak_ptr<listener::state_t>>{});
+        }
+        post->second.emplace_back(item.owner->state_);
+      }
+    }
+    for (auto& [executor, states] : posts) {
+      asio::post(executor, [states = std::move(states)] {
+        for (auto const& weak_state : states) {
+          if (auto state = weak_state.lock()) {
+            state->wake();
+          }
+        }
+      });
+    }
+  }
+
+  doorbell& bell_;
+  std::size_t index_;
+  std::mutex mutex_{};
+  std::vector<entry> entries_{};
+  std::jthread thread_{};
+};
+
+auto listener::create(asio::any_io_executor executor, region&& reg)
+    -> std::expected<std::unique_ptr<listener>, std::error_code> {
+  auto shared_waiter{ waiter::instance() };
+  if (!shared_waiter) {
+    return std::unexpected(shared_waiter.error());
+  }
+  std::unique_ptr<listener> result{ new listener{ std::move(reg), std::make_shared<state_t>(std::move(executor)),
+                                                  std::move(shared_waiter.value()) } };
+  result->waiter_->add(*result);
+  return result;
+}
+
+listener::listener(region&& reg, std::shared_ptr<state_t> state, std::shared_ptr<waiter> shared_waiter) noexcept
+    : region_{ std::move(reg) }, state_{ std::move(state) }, waiter_{ std::move(shared_waiter) } {}
+
+listener::~listener() {
+  // once removed the waiter does not touch this listener anymore
+  waiter_->remove(*this);
+}
+
+}  // namespace tfc::ipc::details::shm
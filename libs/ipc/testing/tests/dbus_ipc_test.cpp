@@ -0,0 +1,92 @@
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <boost/asio.hpp>
+#include <boost/ut.hpp>
+
+#include <tfc/ipc/details/dbus_ipc.hpp>
+#include <tfc/testing/clock.hpp>
+
+namespace asio = boost::asio;
+namespace ut = boost::ut;
+
+using std::chrono::operator""ms;
+
+using tfc::ipc::details::mirror_config;
+using tfc::ipc::details::mirror_e;
+using ut::operator""_test;
+using ut::expect;
+
+struct mirror_test {
+  using timer_t = asio::basic_waitable_timer<tfc::testing::clock, tfc::testing::wait_traits>;
+  asio::io_context ctx{};
+  std::vector<std::int64_t> emitted{};
+  std::shared_ptr<tfc::ipc::details::mirror<std::int64_t, timer_t>> mirror{
+    std::make_shared<tfc::ipc::details::mirror<std::int64_t, timer_t>>(
+        ctx.get_executor(),
+        [this](std::int64_t const& value) { emitted.emplace_back(value); })
+  };
+  void advance(std::chrono::milliseconds duration) {
+    tfc::testing::clock::set_ticks(tfc::testing::clock::now() + duration);
+    ctx.run_for(1ms);
+  }
+};
+
+auto main(int, char**) -> int {
+  "every value is emitted by default"_test = [] {
+    mirror_test test{};
+    expect(mirror_config{}.mode == mirror_e::every);
+    test.mirror->configure(mirror_config{});
+    test.mirror->update(1);
+    test.mirror->update(1);
+    test.mirror->update(2);
+    test.advance(100ms);
+    expect(test.emitted == std::vector<std::int64_t>{ 1, 1, 2 });
+  };
+
+  "on change emits first value and coalesces the rest of the interval"_test = [] {
+    mirror_test test{};
+    test.mirror->configure(mirror_config{ .mode = mirror_e::on_change, .interval = 100ms });
+    for (std::int64_t value{ 1 }; value <= 10; value++) {
+      test.mirror->update(value);
+    }
+    expect(test.emitted == std::vector<std::int64_t>{ 1 });
+    test.advance(100ms);
+    expect(test.emitted == std::vector<std::int64_t>{ 1, 10 });
+    test.advance(100ms);
+    expect(test.emitted == std::vector<std::int64_t>{ 1, 10 });
+  };
+
+  "on change skips unchanged values"_test = [] {
+    mirror_test test{};
+    test.mirror->configure(mirror_config{ .mode = mirror_e::on_change, .interval = 0ms });
+    test.mirror->update(1);
+    test.mirror->update(1);
+    test.mirror->update(2);
+    expect(test.emitted == std::vector<std::int64_t>{ 1, 2 });
+  };
+
+  "periodic emits latest value every interval"_test = [] {
+    mirror_test test{};
+    test.mirror->configure(mirror_config{ .mode = mirror_e::periodic, .interval = 100ms });
+    test.mirror->update(1);
+    test.mirror->update(2);
+    expect(test.emitted.empty());
+    test.advance(100ms);
+    test.advance(100ms);
+    expect(test.emitted == std::vector<std::int64_t>{ 2, 2 });
+  };
+
+  "off only keeps the value"_test = [] {
+    mirror_test test{};
+    test.mirror->configure(mirror_config{ .mode = mirror_e::off });
+    test.mirror->update(42);
+    test.advance(100ms);
+    expect(test.emitted.empty());
+    expect(test.mirror->value() == 42);
+  };
+
+  return 0;
+}
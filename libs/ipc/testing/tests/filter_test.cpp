@@ -256,6 +256,130 @@ auto main(int, char**) -> int {
     ctx.run_one_for(1ms);
   };
 
+  "filter median"_test = []() {
+    asio::io_context ctx{};
+    asio::co_spawn(
+        ctx,
+        []() -> asio::awaitable<void> {
+          filter<filter_e::median, std::int64_t> median_test{};
+          median_test.median_window = 3;
+          std::vector<std::int64_t> results{};
+          for (std::int64_t const value : { 5, 100, 1, 9, -40, 3 }) {
+            auto return_value = co_await median_test.async_process(std::int64_t{ value }, asio::use_awaitable);
+            expect(return_value.has_value() >> fatal);
+            results.emplace_back(return_value.value());
+          }
+          expect(results == std::vector<std::int64_t>{ 5, 5, 5, 9, 1, 3 });
+          co_return;
+        },
+        asio::detached);
+    ctx.run_one_for(1ms);
+  };
+
+  "filter quantile"_test = []() {
+    filter<filter_e::quantile, std::double_t> quantile_test{};
+    quantile_test.quantile = 0.9;
+    quantile_test.quantile_window = 10;
+    std::expected<std::double_t, std::error_code> return_value{};
+    for (std::int64_t value{ 1 }; value <= 20; value++) {
+      return_value = quantile_test.process(static_cast<std::double_t>(value));
+    }
+    expect(return_value.has_value() >> fatal);
+    // window holds 11 to 20
+    expect(return_value.value() > 18.9 && return_value.value() < 19.1);
+  };
+
+  "filter quantile with an empty window configured"_test = []() {
+    filter<filter_e::quantile, std::int64_t> quantile_test{};
+    quantile_test.quantile_window = 0;
+    // the window holds at least the latest value
+    for (std::int64_t const value : { 3, 7, 1 }) {
+      auto const return_value{ quantile_test.process(std::int64_t{ value }) };
+      expect(return_value.has_value() >> fatal);
+      expect(return_value.value() == value);
+    }
+  };
+
+  "filter sliding window moving average"_test = []() {
+    filter<filter_e::sliding_window_moving_average, std::uint64_t> average_test{};
+    average_test.average_window = 4;
+    average_test.send_every = 2;
+    std::vector<std::expected<std::uint64_t, std::error_code>> results{};
+    for (std::uint64_t const value : { 4, 8, 12, 16, 20, 24 }) {
+      results.emplace_back(average_test.process(std::uint64_t{ value }));
+    }
+    expect((results.size() == 6) >> fatal);
+    expect(!results[0].has_value());
+    expect(results[1] == 6);
+    expect(!results[2].has_value());
+    expect(results[3] == 10);
+    expect(!results[4].has_value());
+    expect(results[5] == 18);
+  };
+
+  "filter exponential moving average"_test = []() {
+    filter<filter_e::exponential_moving_average, std::int64_t> average_test{};
+    average_test.alpha = 0.5;
+    expect(average_test.process(10) == 10);
+    expect(average_test.process(20) == 15);
+    expect(average_test.process(21) == 18);
+  };
+
+  "filter delta"_test = []() {
+    filter<filter_e::delta, std::int64_t> delta_test{};
+    delta_test.delta = 5;
+    expect(delta_test.process(10) == 10);
+    expect(!delta_test.process(14).has_value());
+    expect(delta_test.process(15) == 15);
+    expect(!delta_test.process(11).has_value());
+    expect(delta_test.process(-15) == -15);
+  };
+
+  "mass median passes errors through"_test = []() {
+    using tfc::ipc::details::mass_t;
+    filter<filter_e::median, mass_t> median_test{};
+    median_test.median_window = 3;
+    expect(median_test.process(10 * mp_units::si::gram) == 10 * mp_units::si::gram);
+    expect(median_test.process(std::unexpected(tfc::ipc::mass_error_e::cell_fault)) ==
+           mass_t{ std::unexpected(tfc::ipc::mass_error_e::cell_fault) });
+    expect(median_test.process(30 * mp_units::si::gram) == 10 * mp_units::si::gram);
+    expect(median_test.process(20 * mp_units::si::gram) == 20 * mp_units::si::gram);
+  };
+
+  "filter throttle"_test = []() {
+    filter<filter_e::throttle, bool, tfc::testing::clock> throttle_test{};
+    throttle_test.throttle = 10s;
+    expect(throttle_test.process(true) == true);
+    tfc::testing::clock::set_ticks(tfc::testing::clock::now() + 9s);
+    expect(!throttle_test.process(false).has_value());
+    tfc::testing::clock::set_ticks(tfc::testing::clock::now() + 1s);
+    expect(throttle_test.process(false) == false);
+  };
+
+  "filter throttle average"_test = []() {
+    asio::io_context ctx{};
+    filter<filter_e::throttle_average, std::int64_t,
+           asio::basic_waitable_timer<tfc::testing::clock, tfc::testing::wait_traits>>
+        average_test{};
+    average_test.throttle_average = 10s;
+    std::vector<std::expected<std::int64_t, std::error_code>> results{};
+    for (std::int64_t const value : { 1, 2, 6 }) {
+      average_test.async_process(std::int64_t{ value },
+                                 asio::bind_executor(ctx.get_executor(), [&results](auto&& return_value) {
+                                   results.emplace_back(std::forward<decltype(return_value)>(return_value));
+                                 }));
+    }
+    ctx.run_for(1ms);
+    // the two latter values are folded into the average of the first one
+    expect((results.size() == 2) >> fatal);
+    expect(!results[0].has_value());
+    expect(!results[1].has_value());
+    tfc::testing::clock::set_ticks(tfc::testing::clock::now() + 10s);
+    ctx.run_for(1ms);
+    expect((results.size() == 3) >> fatal);
+    expect(results[2] == 3);
+  };
+
 // reason is pure virtual method call in construction of
 // std::shared_ptr<sdbusplus::asio::connection> connection{ std::make_shared<sdbusplus::asio::connection>(ctx) };
 #ifdef __clang__
@@ -346,6 +470,19 @@ auto main(int, char**) -> int {
       test.ctx.run_one_for(1ms);
       expect(call_count == 2);
     };
+
+    "synchronous filters deliver inline"_test = [] {
+      std::optional<bool> received{};
+      invert_config_test test{ .callback = [&received](bool value) { received = value; } };
+      {
+        auto config = test.filters.config()->value();
+        config.emplace_back(filter<filter_e::invert, bool>{});
+        test.filters.config().make_change().value() = config;
+      }
+      test.filters(false);
+      // no coroutine has been spawned, the value is delivered before the io context is polled
+      expect(received == true);
+    };
   };
 #endif
 
@@ -70,6 +70,97 @@ auto main(int argc, char** argv) -> int {
     ut::expect(ipc_manager->get_all_signals()[0].created_by == "sender");
   };
 
+  "ipc_manager connection index"_test = []() {
+    auto ipc_manager = std::make_unique<manager_t>(true);
+    ipc_manager->set_callback([](std::string_view, std::string_view) {});
+    using tfc::ipc::details::type_e;
+    ipc_manager->register_signal("sender", "signal_a", "it's quoted", type_e::_bool);
+    ipc_manager->register_signal("sender", "signal_b", "", type_e::_bool);
+    ipc_manager->register_slot("receiver", "slot_a", "", type_e::_bool);
+    ipc_manager->register_slot("receiver", "slot_b", "", type_e::_bool);
+    ut::expect(ipc_manager->get_all_signals()[0].description == "it's quoted");
+
+    ipc_manager->connect("slot_a", "signal_a");
+    ipc_manager->connect("slot_b", "signal_a");
+    ut::expect(ipc_manager->get_all_connections() ==
+               std::map<std::string, std::vector<std::string>>{ { "signal_a", { "slot_a", "slot_b" } } });
+
+    ipc_manager->connect("slot_b", "signal_b");
+    ut::expect(ipc_manager->get_all_connections() ==
+               std::map<std::string, std::vector<std::string>>{ { "signal_a", { "slot_a" } },
+                                                                { "signal_b", { "slot_b" } } });
+
+    ipc_manager->disconnect("slot_a");
+    ut::expect(ipc_manager->get_all_connections() ==
+               std::map<std::string, std::vector<std::string>>{ { "signal_b", { "slot_b" } } });
+
+    // re-registering keeps the connection
+    ipc_manager->register_slot("receiver", "slot_b", "new description", type_e::_bool);
+    ut::expect(ipc_manager->get_all_slots()[1].connected_to == "signal_b");
+    ut::expect(ipc_manager->get_all_slots()[1].description == "new description");
+  };
+
+  "ipc_manager lists in registration order"_test = []() {
+    auto ipc_manager = std::make_unique<manager_t>(true);
+    ipc_manager->set_callback([](std::string_view, std::string_view) {});
+    using tfc::ipc::details::type_e;
+    for (auto const* name : { "zulu", "alpha", "mike" }) {
+      ipc_manager->register_signal("sender", name, "", type_e::_bool);
+      ipc_manager->register_slot("receiver", name, "", type_e::_bool);
+    }
+    // re-registering keeps the position
+    ipc_manager->register_signal("sender", "zulu", "again", type_e::_bool);
+    ipc_manager->register_slot("receiver", "zulu", "again", type_e::_bool);
+
+    auto const signals{ ipc_manager->get_all_signals() };
+    auto const slots{ ipc_manager->get_all_slots() };
+    ut::expect((signals.size() == 3) >> ut::fatal);
+    ut::expect((slots.size() == 3) >> ut::fatal);
+    ut::expect(signals[0].name == "zulu" && signals[1].name == "alpha" && signals[2].name == "mike");
+    ut::expect(slots[0].name == "zulu" && slots[1].name == "alpha" && slots[2].name == "mike");
+    ut::expect(signals[0].description == "again");
+  };
+
+  "ipc_manager change feed"_test = []() {
+    auto ipc_manager = std::make_unique<manager_t>(true);
+    using tfc::ipc::details::type_e;
+    using tfc::ipc_ruler::change_e;
+    std::vector<tfc::ipc_ruler::change> fed{};
+    ipc_manager->set_callback([](std::string_view, std::string_view) {});
+    ipc_manager->set_change_callback([&fed](tfc::ipc_ruler::change const& entry) { fed.emplace_back(entry); });
+    ut::expect(ipc_manager->sequence() == 0);
+    ut::expect(ipc_manager->changes_since(0).value().empty());
+
+    ipc_manager->register_signal("sender", "signal", "", type_e::_bool);
+    ipc_manager->register_slot("receiver", "slot", "", type_e::_bool);
+    ipc_manager->connect("slot", "signal");
+    ipc_manager->register_signal("sender", "signal", "new description", type_e::_bool);
+    ut::expect(ipc_manager->sequence() == 4);
+    ut::expect(fed.size() == 4);
+
+    auto const changes{ ipc_manager->changes_since(1) };
+    ut::expect(changes.has_value() >> ut::fatal);
+    ut::expect((changes->size() == 3) >> ut::fatal);
+    ut::expect(changes->at(0).sequence == 2);
+    ut::expect(changes->at(0).kind == change_e::added);
+    ut::expect(changes->at(0).slot_entry.has_value());
+    ut::expect(changes->at(1).kind == change_e::changed);
+    ut::expect(changes->at(1).slot_entry->connected_to == "signal");
+    ut::expect(changes->at(2).signal_entry->description == "new description");
+
+    // a sequence from a former ipc-ruler instance
+    ut::expect(!ipc_manager->changes_since(5).has_value());
+  };
+
+  "ipc_manager change feed drops old changes"_test = []() {
+    auto ipc_manager = std::make_unique<manager_t>(true);
+    for (std::size_t idx{}; idx < manager_t::change_log_capacity + 1; idx++) {
+      ipc_manager->register_signal("sender", fmt::format("signal_{}", idx), "", tfc::ipc::details::type_e::_bool);
+    }
+    ut::expect(!ipc_manager->changes_since(0).has_value());
+    ut::expect(ipc_manager->changes_since(1).value().size() == manager_t::change_log_capacity);
+  };
+
   "get signals empty"_test = [] {
     test_instance instance{};
     // Check if the correct empty list is reported for signals
@@ -383,6 +474,20 @@ auto main(int argc, char** argv) -> int {
     ut::expect(invocation == test_values.size());
   };
 
+  "changes since over dbus"_test = []() {
+    test_instance instance{};
+    instance.ipc_manager_client.register_signal("test_signal", "", tfc::ipc::details::type_e::_bool, [](const auto&) {});
+    instance.ctx.run_for(std::chrono::milliseconds(5));
+    instance.ipc_manager_client.changes_since(0, [&instance](std::error_code const& err, auto const& changes) {
+      ut::expect(!err);
+      ut::expect((changes.size() == 1) >> ut::fatal);
+      ut::expect(changes[0].signal_entry->name == "test_signal");
+      instance.ran = true;
+    });
+    instance.ctx.run_for(std::chrono::milliseconds(5));
+    ut::expect(instance.ran);
+  };
+
   "Test callback functionality"_test = []() {
     test_class test_class_instance;
 
@@ -89,6 +89,39 @@ auto main(int argc, char** argv) -> int {
     };
   };
 
+  "serialized packet without allocation"_test = [] {
+    auto const fundamental{ packet<std::int64_t, type_e::_int64_t>::serialize(-1337) };
+    expect(fundamental.has_value() >> fatal);
+    expect(fundamental->contiguous().has_value() >> fatal);
+    expect(fundamental->size() == packet<std::int64_t, type_e::_int64_t>::max_size());
+    auto const fundamental_value{ packet<std::int64_t, type_e::_int64_t>::deserialize(
+        std::span{ fundamental->contiguous().value() }) };
+    expect(fundamental_value.has_value() >> fatal);
+    expect(fundamental_value.value() == -1337);
+
+    std::string const text{ "hello world from another world" };
+    auto const string_view{ packet<std::string, type_e::_string>::serialize(text) };
+    expect(string_view.has_value() >> fatal);
+    // the payload is a view into the string, not a copy
+    expect(!string_view->contiguous().has_value());
+    expect(static_cast<void const*>(string_view->payload().data()) == static_cast<void const*>(text.data()));
+    std::vector<std::byte> gathered{};
+    string_view->append_to(gathered);
+    std::vector<std::byte> serialized{};
+    expect(!packet<std::string, type_e::_string>::serialize(text, serialized) >> fatal);
+    expect(gathered == serialized);
+  };
+
+  "deserialize rejects inconsistent header"_test = [] {
+    std::vector<std::byte> serialized{};
+    expect(!packet<std::int64_t, type_e::_int64_t>::serialize(42, serialized) >> fatal);
+    serialized.push_back(std::byte{ 0 });  // trailing garbage
+    expect(!packet<std::int64_t, type_e::_int64_t>::deserialize(std::span(std::cbegin(serialized), std::cend(serialized)))
+                .has_value());
+    serialized.resize(4);  // truncated header
+    expect(!packet<std::int64_t, type_e::_int64_t>::peek_header(serialized).has_value());
+  };
+
   "ipc stop receiver"_test = [] {
     asio::io_context ctx;
     auto sender = tfc::ipc::details::uint_signal_ptr::element_type::create(ctx, "name").value();
@@ -136,6 +169,49 @@ auto main(int argc, char** argv) -> int {
     expect(receiver_called);
   };
 
+  "ipc over shared memory"_test = [] {
+    asio::io_context ctx;
+    auto sender = tfc::ipc::details::uint_signal_ptr::element_type::create(ctx, "shm_name",
+                                                                           tfc::ipc::details::transport_e::shm)
+                      .value();
+    expect(sender->transport() == tfc::ipc::details::transport_e::shm);
+    std::vector<std::uint64_t> received{};
+    auto receiver = tfc::ipc::details::uint_slot_cb_ptr::element_type::create(ctx, "unused");
+    receiver->connect(sender->full_name(), [&ctx, &received](std::uint64_t val) {
+      received.push_back(val);
+      if (received.size() == 3) {
+        ctx.stop();
+      }
+    });
+    asio::steady_timer timer{ ctx };
+    timer.expires_after(std::chrono::milliseconds(1));
+    timer.async_wait([&sender](auto) {
+      sender->send(1);
+      sender->send(2);
+      sender->send(3);
+    });
+
+    ctx.run_for(std::chrono::seconds(1));
+    expect(received == std::vector<std::uint64_t>{ 1, 2, 3 });
+  };
+
+  "shared memory late joiner receives last value"_test = [] {
+    asio::io_context ctx;
+    auto sender = tfc::ipc::details::bool_signal_ptr::element_type::create(ctx, "shm_late",
+                                                                           tfc::ipc::details::transport_e::shm)
+                      .value();
+    sender->send(true);
+    std::optional<bool> received{};
+    auto receiver = tfc::ipc::details::bool_slot_cb_ptr::element_type::create(ctx, "unused");
+    receiver->connect(sender->full_name(), [&ctx, &received](bool val) {
+      received = val;
+      ctx.stop();
+    });
+    ctx.run_for(std::chrono::seconds(1));
+    expect(received.has_value() >> fatal);
+    expect(received.value());
+  };
+
   "code_example"_test = []() {
     auto ctx{ asio::io_context() };
     auto sender{ tfc::ipc::details::string_signal_ptr::element_type::create(ctx, "name").value() };
@@ -183,6 +259,8 @@ auto main(int argc, char** argv) -> int {
                   data_t<type_int>{ .value = 3 },
                   data_t<type_json>{ .value = R"({"i":287,"d":3.14,"hello":"Hello World","arr":[1,2,3])" },
                   data_t<type_string>{ .value = "hello world from another world" },
+                  // larger than any fixed receive buffer, must arrive in one piece
+                  data_t<type_string>{ .value = std::string(64 * 1024, 'x') },
                   data_t<type_uint>{ .value = std::numeric_limits<std::uint64_t>::max() } };
 
   return 0;
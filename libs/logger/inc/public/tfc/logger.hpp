@@ -6,6 +6,7 @@
 #include <string_view>
 
 #include <fmt/core.h>
+#include <fmt/format.h>
 
 namespace spdlog {
 class async_logger;
@@ -63,43 +64,43 @@ public:
   // clang-format off
   template <lvl_e log_level, typename t1>
   void log(fmt::format_string<t1> msg, t1&& p1, std::source_location loc = std::source_location::current()) const {
-    log_(log_level, fmt::vformat(msg, fmt::make_format_args(p1)), loc);
+    format_log_(log_level, msg, loc, p1);
   }
   template <lvl_e log_level, typename t1, typename t2>
   void log(fmt::format_string<t1, t2> msg, t1&& p1, t2&& p2, std::source_location loc = std::source_location::current()) const {
-    log_(log_level, fmt::vformat(msg, fmt::make_format_args(p1, p2)), loc);
+    format_log_(log_level, msg, loc, p1, p2);
   }
   template <lvl_e log_level, typename t1, typename t2, typename t3>
   void log(fmt::format_string<t1, t2, t3> msg, t1&& p1, t2&& p2, t3&& p3, std::source_location loc = std::source_location::current()) const {
-    log_(log_level, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3)), loc);
+    format_log_(log_level, msg, loc, p1, p2, p3);
   }
   template <lvl_e log_level, typename t1, typename t2, typename t3, typename t4>
   void log(fmt::format_string<t1, t2, t3, t4> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, std::source_location loc = std::source_location::current()) const {
-    log_(log_level, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4)), loc);
+    format_log_(log_level, msg, loc, p1, p2, p3, p4);
   }
   template <lvl_e log_level, typename t1, typename t2, typename t3, typename t4, typename t5>
   void log(fmt::format_string<t1, t2, t3, t4, t5> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, std::source_location loc = std::source_location::current()) const {
-    log_(log_level, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5)), loc);
+    format_log_(log_level, msg, loc, p1, p2, p3, p4, p5);
   }
   template <lvl_e log_level, typename t1, typename t2, typename t3, typename t4, typename t5, typename t6>
   void log(fmt::format_string<t1, t2, t3, t4, t5, t6> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, std::source_location loc = std::source_location::current()) const {
-    log_(log_level, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6)), loc);
+    format_log_(log_level, msg, loc, p1, p2, p3, p4, p5, p6);
   }
   template <lvl_e log_level, typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7>
   void log(fmt::format_string<t1, t2, t3, t4, t5, t6, t7> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, std::source_location loc = std::source_location::current()) const {
-    log_(log_level, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7)), loc);
+    format_log_(log_level, msg, loc, p1, p2, p3, p4, p5, p6, p7);
   }
   template <lvl_e log_level, typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8>
   void log(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, std::source_location loc = std::source_location::current()) const {
-    log_(log_level, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8)), loc);
+    format_log_(log_level, msg, loc, p1, p2, p3, p4, p5, p6, p7, p8);
   }
   template <lvl_e log_level, typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8, typename t9>
   void log(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8, t9> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, std::source_location loc = std::source_location::current()) const {
-    log_(log_level, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9)), loc);
+    format_log_(log_level, msg, loc, p1, p2, p3, p4, p5, p6, p7, p8, p9);
   }
   template <lvl_e log_level, typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8, typename t9, typename t10>
-  void log(fmt::format_string<t1, t2, t3, t4, t4, t5, t6, t7, t8, t9, t10> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, t10&& p10, std::source_location loc = std::source_location::current()) const {
-    log_(log_level, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10)), loc);
+  void log(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8, t9, t10> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, t10&& p10, std::source_location loc = std::source_location::current()) const {
+    format_log_(log_level, msg, loc, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10);
   }
 
   void trace(std::string_view msg, std::source_location loc = std::source_location::current()) const {
@@ -107,43 +108,43 @@ public:
   }
   template <typename t1>
   void trace(fmt::format_string<t1> msg, t1&& p1, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::trace, fmt::vformat(msg, fmt::make_format_args(p1)), loc);
+    format_log_(lvl_e::trace, msg, loc, p1);
   }
   template <typename t1, typename t2>
   void trace(fmt::format_string<t1, t2> msg, t1&& p1, t2&& p2, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::trace, fmt::vformat(msg, fmt::make_format_args(p1, p2)), loc);
+    format_log_(lvl_e::trace, msg, loc, p1, p2);
   }
   template <typename t1, typename t2, typename t3>
   void trace(fmt::format_string<t1, t2, t3> msg, t1&& p1, t2&& p2, t3&& p3, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::trace, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3)), loc);
+    format_log_(lvl_e::trace, msg, loc, p1, p2, p3);
   }
   template <typename t1, typename t2, typename t3, typename t4>
   void trace(fmt::format_string<t1, t2, t3, t4> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::trace, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4)), loc);
+    format_log_(lvl_e::trace, msg, loc, p1, p2, p3, p4);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5>
   void trace(fmt::format_string<t1, t2, t3, t4, t5> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::trace, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5)), loc);
+    format_log_(lvl_e::trace, msg, loc, p1, p2, p3, p4, p5);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6>
   void trace(fmt::format_string<t1, t2, t3, t4, t5, t6> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::trace, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6)), loc);
+    format_log_(lvl_e::trace, msg, loc, p1, p2, p3, p4, p5, p6);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7>
   void trace(fmt::format_string<t1, t2, t3, t4, t5, t6, t7> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::trace, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7)), loc);
+    format_log_(lvl_e::trace, msg, loc, p1, p2, p3, p4, p5, p6, p7);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8>
   void trace(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::trace, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8)), loc);
+    format_log_(lvl_e::trace, msg, loc, p1, p2, p3, p4, p5, p6, p7, p8);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8, typename t9>
   void trace(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8, t9> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::trace, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9)), loc);
+    format_log_(lvl_e::trace, msg, loc, p1, p2, p3, p4, p5, p6, p7, p8, p9);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8, typename t9, typename t10>
-  void trace(fmt::format_string<t1, t2, t3, t4, t4, t5, t6, t7, t8, t9, t10> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, t10&& p10, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::trace, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10)), loc);
+  void trace(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8, t9, t10> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, t10&& p10, std::source_location loc = std::source_location::current()) const {
+    format_log_(lvl_e::trace, msg, loc, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10);
   }
 
   void debug(std::string_view msg, std::source_location loc = std::source_location::current()) const {
@@ -151,43 +152,43 @@ public:
   }
   template <typename t1>
   void debug(fmt::format_string<t1> msg, t1&& p1, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::debug, fmt::vformat(msg, fmt::make_format_args(p1)), loc);
+    format_log_(lvl_e::debug, msg, loc, p1);
   }
   template <typename t1, typename t2>
   void debug(fmt::format_string<t1, t2> msg, t1&& p1, t2&& p2, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::debug, fmt::vformat(msg, fmt::make_format_args(p1, p2)), loc);
+    format_log_(lvl_e::debug, msg, loc, p1, p2);
   }
   template <typename t1, typename t2, typename t3>
   void debug(fmt::format_string<t1, t2, t3> msg, t1&& p1, t2&& p2, t3&& p3, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::debug, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3)), loc);
+    format_log_(lvl_e::debug, msg, loc, p1, p2, p3);
   }
   template <typename t1, typename t2, typename t3, typename t4>
   void debug(fmt::format_string<t1, t2, t3, t4> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::debug, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4)), loc);
+    format_log_(lvl_e::debug, msg, loc, p1, p2, p3, p4);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5>
   void debug(fmt::format_string<t1, t2, t3, t4, t5> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::debug, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5)), loc);
+    format_log_(lvl_e::debug, msg, loc, p1, p2, p3, p4, p5);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6>
   void debug(fmt::format_string<t1, t2, t3, t4, t5, t6> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::debug, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6)), loc);
+    format_log_(lvl_e::debug, msg, loc, p1, p2, p3, p4, p5, p6);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7>
   void debug(fmt::format_string<t1, t2, t3, t4, t5, t6, t7> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::debug, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7)), loc);
+    format_log_(lvl_e::debug, msg, loc, p1, p2, p3, p4, p5, p6, p7);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8>
   void debug(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::debug, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8)), loc);
+    format_log_(lvl_e::debug, msg, loc, p1, p2, p3, p4, p5, p6, p7, p8);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8, typename t9>
   void debug(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8, t9> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::debug, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9)), loc);
+    format_log_(lvl_e::debug, msg, loc, p1, p2, p3, p4, p5, p6, p7, p8, p9);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8, typename t9, typename t10>
-  void debug(fmt::format_string<t1, t2, t3, t4, t4, t5, t6, t7, t8, t9, t10> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, t10&& p10, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::debug, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10)), loc);
+  void debug(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8, t9, t10> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, t10&& p10, std::source_location loc = std::source_location::current()) const {
+    format_log_(lvl_e::debug, msg, loc, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10);
   }
 
   void info(std::string_view msg, std::source_location loc = std::source_location::current()) const {
@@ -195,43 +196,43 @@ public:
   }
   template <typename t1>
   void info(fmt::format_string<t1> msg, t1&& p1, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::info, fmt::vformat(msg, fmt::make_format_args(p1)), loc);
+    format_log_(lvl_e::info, msg, loc, p1);
   }
   template <typename t1, typename t2>
   void info(fmt::format_string<t1, t2> msg, t1&& p1, t2&& p2, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::info, fmt::vformat(msg, fmt::make_format_args(p1, p2)), loc);
+    format_log_(lvl_e::info, msg, loc, p1, p2);
   }
   template <typename t1, typename t2, typename t3>
   void info(fmt::format_string<t1, t2, t3> msg, t1&& p1, t2&& p2, t3&& p3, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::info, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3)), loc);
+    format_log_(lvl_e::info, msg, loc, p1, p2, p3);
   }
   template <typename t1, typename t2, typename t3, typename t4>
   void info(fmt::format_string<t1, t2, t3, t4> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::info, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4)), loc);
+    format_log_(lvl_e::info, msg, loc, p1, p2, p3, p4);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5>
   void info(fmt::format_string<t1, t2, t3, t4, t5> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::info, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5)), loc);
+    format_log_(lvl_e::info, msg, loc, p1, p2, p3, p4, p5);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6>
   void info(fmt::format_string<t1, t2, t3, t4, t5, t6> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::info, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6)), loc);
+    format_log_(lvl_e::info, msg, loc, p1, p2, p3, p4, p5, p6);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7>
   void info(fmt::format_string<t1, t2, t3, t4, t5, t6, t7> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::info, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7)), loc);
+    format_log_(lvl_e::info, msg, loc, p1, p2, p3, p4, p5, p6, p7);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8>
   void info(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::info, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8)), loc);
+    format_log_(lvl_e::info, msg, loc, p1, p2, p3, p4, p5, p6, p7, p8);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8, typename t9>
   void info(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8, t9> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::info, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9)), loc);
+    format_log_(lvl_e::info, msg, loc, p1, p2, p3, p4, p5, p6, p7, p8, p9);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8, typename t9, typename t10>
-  void info(fmt::format_string<t1, t2, t3, t4, t4, t5, t6, t7, t8, t9, t10> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, t10&& p10, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::info, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10)), loc);
+  void info(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8, t9, t10> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, t10&& p10, std::source_location loc = std::source_location::current()) const {
+    format_log_(lvl_e::info, msg, loc, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10);
   }
 
   void warn(std::string_view msg, std::source_location loc = std::source_location::current()) const {
@@ -239,43 +240,43 @@ public:
   }
   template <typename t1>
   void warn(fmt::format_string<t1> msg, t1&& p1, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::warn, fmt::vformat(msg, fmt::make_format_args(p1)), loc);
+    format_log_(lvl_e::warn, msg, loc, p1);
   }
   template <typename t1, typename t2>
   void warn(fmt::format_string<t1, t2> msg, t1&& p1, t2&& p2, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::warn, fmt::vformat(msg, fmt::make_format_args(p1, p2)), loc);
+    format_log_(lvl_e::warn, msg, loc, p1, p2);
   }
   template <typename t1, typename t2, typename t3>
   void warn(fmt::format_string<t1, t2, t3> msg, t1&& p1, t2&& p2, t3&& p3, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::warn, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3)), loc);
+    format_log_(lvl_e::warn, msg, loc, p1, p2, p3);
   }
   template <typename t1, typename t2, typename t3, typename t4>
   void warn(fmt::format_string<t1, t2, t3, t4> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::warn, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4)), loc);
+    format_log_(lvl_e::warn, msg, loc, p1, p2, p3, p4);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5>
   void warn(fmt::format_string<t1, t2, t3, t4, t5> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::warn, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5)), loc);
+    format_log_(lvl_e::warn, msg, loc, p1, p2, p3, p4, p5);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6>
   void warn(fmt::format_string<t1, t2, t3, t4, t5, t6> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::warn, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6)), loc);
+    format_log_(lvl_e::warn, msg, loc, p1, p2, p3, p4, p5, p6);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7>
   void warn(fmt::format_string<t1, t2, t3, t4, t5, t6, t7> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::warn, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7)), loc);
+    format_log_(lvl_e::warn, msg, loc, p1, p2, p3, p4, p5, p6, p7);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8>
   void warn(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::warn, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8)), loc);
+    format_log_(lvl_e::warn, msg, loc, p1, p2, p3, p4, p5, p6, p7, p8);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8, typename t9>
   void warn(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8, t9> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::warn, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9)), loc);
+    format_log_(lvl_e::warn, msg, loc, p1, p2, p3, p4, p5, p6, p7, p8, p9);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8, typename t9, typename t10>
-  void warn(fmt::format_string<t1, t2, t3, t4, t4, t5, t6, t7, t8, t9, t10> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, t10&& p10, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::warn, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10)), loc);
+  void warn(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8, t9, t10> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, t10&& p10, std::source_location loc = std::source_location::current()) const {
+    format_log_(lvl_e::warn, msg, loc, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10);
   }
 
   void error(std::string_view msg, std::source_location loc = std::source_location::current()) const {
@@ -283,43 +284,43 @@ public:
   }
   template <typename t1>
   void error(fmt::format_string<t1> msg, t1&& p1, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::error, fmt::vformat(msg, fmt::make_format_args(p1)), loc);
+    format_log_(lvl_e::error, msg, loc, p1);
   }
   template <typename t1, typename t2>
   void error(fmt::format_string<t1, t2> msg, t1&& p1, t2&& p2, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::error, fmt::vformat(msg, fmt::make_format_args(p1, p2)), loc);
+    format_log_(lvl_e::error, msg, loc, p1, p2);
   }
   template <typename t1, typename t2, typename t3>
   void error(fmt::format_string<t1, t2, t3> msg, t1&& p1, t2&& p2, t3&& p3, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::error, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3)), loc);
+    format_log_(lvl_e::error, msg, loc, p1, p2, p3);
   }
   template <typename t1, typename t2, typename t3, typename t4>
   void error(fmt::format_string<t1, t2, t3, t4> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::error, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4)), loc);
+    format_log_(lvl_e::error, msg, loc, p1, p2, p3, p4);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5>
   void error(fmt::format_string<t1, t2, t3, t4, t5> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::error, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5)), loc);
+    format_log_(lvl_e::error, msg, loc, p1, p2, p3, p4, p5);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6>
   void error(fmt::format_string<t1, t2, t3, t4, t5, t6> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::error, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6)), loc);
+    format_log_(lvl_e::error, msg, loc, p1, p2, p3, p4, p5, p6);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7>
   void error(fmt::format_string<t1, t2, t3, t4, t5, t6, t7> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::error, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7)), loc);
+    format_log_(lvl_e::error, msg, loc, p1, p2, p3, p4, p5, p6, p7);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8>
   void error(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::error, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8)), loc);
+    format_log_(lvl_e::error, msg, loc, p1, p2, p3, p4, p5, p6, p7, p8);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8, typename t9>
   void error(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8, t9> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::error, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9)), loc);
+    format_log_(lvl_e::error, msg, loc, p1, p2, p3, p4, p5, p6, p7, p8, p9);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8, typename t9, typename t10>
-  void error(fmt::format_string<t1, t2, t3, t4, t4, t5, t6, t7, t8, t9, t10> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, t10&& p10, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::error, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10)), loc);
+  void error(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8, t9, t10> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, t10&& p10, std::source_location loc = std::source_location::current()) const {
+    format_log_(lvl_e::error, msg, loc, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10);
   }
 
   void critical(std::string_view msg, std::source_location loc = std::source_location::current()) const {
@@ -327,43 +328,43 @@ public:
   }
   template <typename t1>
   void critical(fmt::format_string<t1> msg, t1&& p1, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::critical, fmt::vformat(msg, fmt::make_format_args(p1)), loc);
+    format_log_(lvl_e::critical, msg, loc, p1);
   }
   template <typename t1, typename t2>
   void critical(fmt::format_string<t1, t2> msg, t1&& p1, t2&& p2, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::critical, fmt::vformat(msg, fmt::make_format_args(p1, p2)), loc);
+    format_log_(lvl_e::critical, msg, loc, p1, p2);
   }
   template <typename t1, typename t2, typename t3>
   void critical(fmt::format_string<t1, t2, t3> msg, t1&& p1, t2&& p2, t3&& p3, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::critical, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3)), loc);
+    format_log_(lvl_e::critical, msg, loc, p1, p2, p3);
   }
   template <typename t1, typename t2, typename t3, typename t4>
   void critical(fmt::format_string<t1, t2, t3, t4> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::critical, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4)), loc);
+    format_log_(lvl_e::critical, msg, loc, p1, p2, p3, p4);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5>
   void critical(fmt::format_string<t1, t2, t3, t4, t5> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::critical, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5)), loc);
+    format_log_(lvl_e::critical, msg, loc, p1, p2, p3, p4, p5);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6>
   void critical(fmt::format_string<t1, t2, t3, t4, t5, t6> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::critical, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6)), loc);
+    format_log_(lvl_e::critical, msg, loc, p1, p2, p3, p4, p5, p6);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7>
   void critical(fmt::format_string<t1, t2, t3, t4, t5, t6, t7> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::critical, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7)), loc);
+    format_log_(lvl_e::critical, msg, loc, p1, p2, p3, p4, p5, p6, p7);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8>
   void critical(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::critical, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8)), loc);
+    format_log_(lvl_e::critical, msg, loc, p1, p2, p3, p4, p5, p6, p7, p8);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8, typename t9>
   void critical(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8, t9> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::critical, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9)), loc);
+    format_log_(lvl_e::critical, msg, loc, p1, p2, p3, p4, p5, p6, p7, p8, p9);
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8, typename t9, typename t10>
-  void critical(fmt::format_string<t1, t2, t3, t4, t4, t5, t6, t7, t8, t9, t10> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, t10&& p10, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::critical, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10)), loc);
+  void critical(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8, t9, t10> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, t10&& p10, std::source_location loc = std::source_location::current()) const {
+    format_log_(lvl_e::critical, msg, loc, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10);
   }
 
   /**
@@ -372,7 +373,32 @@ public:
    * */
   void set_loglevel(lvl_e log_level);
 
+  /**
+   * @brief Check whether messages of a level are logged, f.e. before computing expensive arguments
+   * @param log_level level of the message
+   * @return true if messages of log_level pass the current log level
+   */
+  [[nodiscard]] auto enabled(lvl_e log_level) const noexcept -> bool;
+
 private:
+  /**
+   * @brief Format and log messages, nothing is formatted when log_lvl is disabled
+   * The message is formatted into a stack buffer, the same inline size as spdlog::memory_buf_t, and handed to spdlog
+   * as a view. The format string has already been checked at compile time by the public overloads.
+   * @param log_lvl Log level
+   * @param msg Format string
+   * @param args Variables embedded into the msg
+   */
+  template <typename... args_t>
+  void format_log_(lvl_e log_lvl, fmt::string_view msg, std::source_location loc, args_t&... args) const {
+    if (!enabled(log_lvl)) {
+      return;
+    }
+    fmt::basic_memory_buffer<char, 250> buffer{};
+    fmt::vformat_to(fmt::appender{ buffer }, msg, fmt::make_format_args(args...));
+    log_(log_lvl, std::string_view{ buffer.data(), buffer.size() }, loc);
+  }
+
   /**
    * @brief Log messages
    * @param log_lvl Log level
@@ -5,6 +5,20 @@
 
 using std::string_view_literals::operator""sv;
 
+namespace {
+/// counts how often it has been formatted
+struct formatted_count {
+  int& count;
+};
+}  // namespace
+
+template <>
+struct fmt::formatter<formatted_count> : fmt::formatter<int> {
+  auto format(formatted_count const& value, format_context& ctx) const {
+    return fmt::formatter<int>::format(++value.count, ctx);
+  }
+};
+
 auto main(int argc, char** argv) -> int {
   using boost::ut::operator""_test;
   using boost::ut::expect;
@@ -29,4 +43,18 @@ auto main(int argc, char** argv) -> int {
 
     expect(true);
   };
+
+  "disabled levels are not formatted"_test = [] {
+    tfc::logger::logger foo("key");
+    foo.set_loglevel(tfc::logger::lvl_e::info);
+    int count{};
+    foo.trace("Not formatted {}", formatted_count{ count });
+    foo.debug("Not formatted {}", formatted_count{ count });
+    expect(count == 0);
+    expect(!foo.enabled(tfc::logger::lvl_e::debug));
+    expect(foo.enabled(tfc::logger::lvl_e::info));
+    foo.info("Formatted {}", formatted_count{ count });
+    foo.log<tfc::logger::lvl_e::warn>("Formatted {}", formatted_count{ count });
+    expect(count == 2);
+  };
 }
@@ -1,7 +1,13 @@
 #pragma once
 
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <vector>
 
 #include <fmt/chrono.h>
 #include <mp-units/systems/si/chrono.h>
@@ -16,6 +22,7 @@
 #include <tfc/motor/dbus_tags.hpp>
 #include <tfc/motor/enums.hpp>
 #include <tfc/motor/errors.hpp>
+#include <tfc/motor/mailbox.hpp>
 #include <tfc/stx/function_traits.hpp>
 
 namespace tfc::motor::types {
@@ -92,6 +99,178 @@ private:
     }
     connected_ = response;
     ping_.cancel();
+    if (!connected_) {
+      close_mailbox();
+    } else if (!commands_.has_value()) {
+      open_mailbox();
+    }
+  }
+
+  /// Create the command region and ask the drive to read it, commands go through D-Bus until it has answered
+  void open_mailbox() {
+    using mailbox::channel_e;
+    auto commands{ mailbox::writer<mailbox::command>::create(
+        mailbox::region_name(impl_name, slave_id_, channel_e::commands)) };
+    auto responses{ mailbox::reader<mailbox::response>::open(
+        ctx_.get_executor(), mailbox::region_name(impl_name, slave_id_, channel_e::responses)) };
+    auto status{ ipc::details::shm::region::open(mailbox::region_name(impl_name, slave_id_, channel_e::status),
+                                                 mailbox::region_type, sizeof(mailbox::status)) };
+    if (!commands || !responses || !status) {
+      // the drive is served by an ethercat process without a mailbox, retried on the next ping
+      logger_.trace("Mailbox not available, commands go through D-Bus");
+      return;
+    }
+    commands_.emplace(std::move(commands.value()));
+    responses_ = std::move(responses.value());
+    status_.emplace(std::move(status.value()));
+    connection_->async_method_call_timed(
+        [this, alive = responses_->alive()](std::error_code const& err, dbus::message::open_mailbox reply) {
+          if (alive.expired()) {
+            return;  // closed while waiting for the answer
+          }
+          if (err || reply.err != errors::err_enum::success) {
+            logger_.warn("Unable to open mailbox, commands go through D-Bus: {}",
+                         err ? err.message() : motor_error(reply.err).message());
+            close_mailbox();
+            return;
+          }
+          logger_.trace("Mailbox open");
+          session_ = reply.session;
+          mailbox_open_ = true;
+          receive_responses();
+        },
+        service_name_, path_, interface_name_, std::string{ method::open_mailbox }, ping_response_timeout.count());
+  }
+
+  /// Drop the mailbox, commands waiting for a response complete with motor_not_connected
+  void close_mailbox() {
+    mailbox_open_ = false;
+    session_ = 0;
+    commands_.reset();
+    responses_.reset();
+    status_.reset();
+    auto pending{ std::exchange(pending_, {}) };
+    for (auto& [id, cmd] : pending) {
+      cmd.handler(motor_error(errors::err_enum::motor_not_connected), 0);
+    }
+  }
+
+  void receive_responses() {
+    responses_->async_wait([this, alive = responses_->alive()](std::error_code const&) {
+      // completion handlers may close the mailbox, check the reader is still alive after each of them
+      while (!alive.expired()) {
+        auto response{ responses_->next() };
+        if (!response) {
+          break;
+        }
+        if (auto itr{ pending_.find(response->id) }; itr != pending_.end()) {
+          auto handler{ std::move(itr->second.handler) };
+          pending_.erase(itr);
+          handler(motor_error(response->err), response->micrometre);
+        }
+      }
+      if (alive.expired()) {
+        return;
+      }
+      if (responses_->lost() > 0) {
+        logger_.error("Lost {} mailbox responses, closing mailbox", responses_->lost());
+        close_mailbox();
+        return;
+      }
+      if (responses_->detached()) {
+        logger_.info("Drive closed the mailbox");
+        close_mailbox();
+        return;
+      }
+      receive_responses();
+    });
+  }
+
+  using command_handler = std::move_only_function<void(std::error_code const&, std::int64_t micrometre)>;
+
+  /// A command posted to the mailbox, waiting for its response
+  struct pending_command {
+    std::uint64_t index{};  // in the command region
+    std::chrono::steady_clock::time_point read_by{};
+    std::chrono::steady_clock::time_point done_by{};
+    command_handler handler{};
+  };
+
+  /// \return index of the next command the drive will read, 0 until it publishes a status of this session
+  [[nodiscard]] auto commands_read() const noexcept -> std::uint64_t {
+    if (!status_.has_value()) {
+      return 0;
+    }
+    if (auto const drive{ mailbox::latest<mailbox::status>(status_.value()) }; drive && drive->session == session_) {
+      return drive->commands_read;
+    }
+    return 0;
+  }
+
+  /// Post a command, the handler completes with its response or
+  /// std::errc::no_buffer_space when the ring is full of commands the drive has not read
+  /// std::errc::timed_out when the drive has not read it by the read deadline or it has not completed within timeout
+  void post_command(mailbox::command cmd, std::chrono::microseconds timeout, command_handler handler) {
+    auto const now{ std::chrono::steady_clock::now() };
+    cmd.id = next_command_id_++;
+    cmd.session = session_;
+    cmd.read_by = mailbox::make_read_by(now);
+    auto const index{ commands_->write_index() };
+    auto const read{ commands_read() };
+    if (auto const posted{ commands_->try_post(cmd, read) }; !posted) {
+      logger_.warn("Mailbox full, {} commands not read by the drive", index - read);
+      handler(posted.error(), 0);
+      return;
+    }
+    auto const done_by{ timeout == std::chrono::microseconds::max() ? std::chrono::steady_clock::time_point::max()
+                                                                    : now + timeout };
+    // the drive answers a command it reads after cmd.read_by with timed_out and never runs it, the sender gives up on
+    // a drive which reads nothing a read deadline later, so a command read just in time is in the drive status by then
+    pending_.emplace(cmd.id, pending_command{ .index = index,
+                                              .read_by = now + mailbox::read_deadline * 2,
+                                              .done_by = done_by,
+                                              .handler = std::move(handler) });
+    watch_deadlines();
+  }
+
+  /// Expire pending commands past their deadline, as long as there are any
+  void watch_deadlines() {
+    if (deadlines_armed_) {
+      return;
+    }
+    deadlines_armed_ = true;
+    deadlines_.expires_after(mailbox::read_deadline / 4);
+    deadlines_.async_wait([this](std::error_code const& err) {
+      if (err) {
+        return;
+      }
+      deadlines_armed_ = false;
+      expire_commands();
+      if (!pending_.empty()) {
+        watch_deadlines();
+      }
+    });
+  }
+
+  void expire_commands() {
+    auto const read{ commands_read() };
+    auto const now{ std::chrono::steady_clock::now() };
+    std::vector<command_handler> expired{};
+    std::erase_if(pending_, [read, now, &expired](auto& entry) {
+      auto& cmd{ entry.second };
+      if ((cmd.index >= read && now >= cmd.read_by) || now >= cmd.done_by) {
+        expired.emplace_back(std::move(cmd.handler));
+        return true;
+      }
+      return false;
+    });
+    if (!expired.empty()) {
+      logger_.warn("{} mailbox commands timed out", expired.size());
+    }
+    // completion handlers may post new commands, the pending commands are settled before they run
+    for (auto& handler : expired) {
+      handler(std::make_error_code(std::errc::timed_out), 0);
+    }
   }
 
   void on_ping_timeout(std::error_code const& err) {
@@ -115,6 +294,15 @@ private:
   }
 
   bool connected_{ false };
+  std::optional<mailbox::writer<mailbox::command>> commands_{};
+  std::unique_ptr<mailbox::reader<mailbox::response>> responses_{};
+  std::optional<ipc::details::shm::region> status_{};
+  bool mailbox_open_{ false };
+  std::uint64_t session_{};
+  std::uint64_t next_command_id_{ 1 };
+  std::unordered_map<std::uint64_t, pending_command> pending_{};
+  asio::steady_timer deadlines_{ ctx_ };
+  bool deadlines_armed_{ false };
   [[nodiscard]] std::error_code motor_seems_valid() const noexcept {
     if (!connected_) {
       return motor_error(errors::err_enum::motor_not_connected);
@@ -133,6 +321,7 @@ public:
       logger_.warn("Configuration changed from {} to {}. It is not recomended to switch motors on a running system!", old_id,
                    new_id);
       connected_ = false;
+      close_mailbox();
       slave_id_ = new_id;
       path_ = dbus::make_path_name(impl_name, slave_id_);
       logger_ = logger::logger{ fmt::format("atv320motor.{}", slave_id_) };
@@ -145,6 +334,17 @@ public:
   ~atv320motor() = default;
 
   auto connected() -> bool { return connected_; }
+
+  /// \return true when commands go through the shared memory mailbox instead of D-Bus
+  [[nodiscard]] auto mailbox_open() const noexcept -> bool { return mailbox_open_; }
+
+  /// \return the status of the drive from its last process data cycle, std::nullopt unless the mailbox is open
+  [[nodiscard]] auto status() const noexcept -> std::optional<mailbox::status> {
+    if (!mailbox_open_ || !status_.has_value()) {
+      return std::nullopt;
+    }
+    return mailbox::latest<mailbox::status>(status_.value());
+  }
   template <QuantityOf<mp_units::isq::length> travel_t = micrometre_t,
             typename signature_t = void(std::error_code, travel_t)>
   auto convey(QuantityOf<mp_units::isq::velocity> auto, asio::completion_token_for<signature_t> auto&& token) ->
@@ -309,6 +509,14 @@ private:
             self.complete(sanity_check, {});
             return;
           }
+          if (auto const cmd{ mailbox::make_command(method_name, args...) }; cmd && mailbox_open_) {
+            post_command(cmd.value(), method_call_timeout,
+                         [self_m = std::move(self)](std::error_code const& err, std::int64_t micrometre) mutable {
+                           micrometre_t const length{ micrometre * micrometre_t::reference };
+                           self_m.complete(err, length.force_in(second_arg_t::reference));
+                         });
+            return;
+          }
 
           connection_->async_method_call_timed(
               [this, self_m = std::move(self), method_name](std::error_code const& err,
@@ -335,20 +543,40 @@ private:
             self.complete(sanity_check);
             return;
           }
-
-          connection_->async_method_call_timed(
-              [this, self_m = std::move(self), method_name](std::error_code const& err, errors::err_enum motor_err) mutable {
-                if (err) {
-                  logger_.warn("{} failure: {}", method_name, err.message());
-                  self_m.complete(err);
-                  return;
-                }
-                using enum errors::err_enum;
-                self_m.complete(motor_error(motor_err));
-              },
-              service_name_, path_, interface_name_, std::string(method_name), timeout.count(), args...);
+          if (auto const cmd{ mailbox::make_command(method_name, args...) }; cmd && mailbox_open_) {
+            using mailbox::command_e;
+            bool const stopping{ cmd->type == command_e::stop || cmd->type == command_e::quick_stop };
+            post_command(cmd.value(), timeout,
+                         [this, self_m = std::move(self), method_name, stopping, args...](std::error_code const& err,
+                                                                                          std::int64_t) mutable {
+                           // the drive may not have read the stop, send it over D-Bus as well, stopping twice is harmless
+                           if (stopping && (err == std::errc::no_buffer_space || err == std::errc::timed_out)) {
+                             logger_.warn("{} not read through the mailbox: {}, sending it over D-Bus", method_name,
+                                          err.message());
+                             error_only_method_call<timeout>(method_name, std::move(self_m), args...);
+                             return;
+                           }
+                           self_m.complete(err);
+                         });
+            return;
+          }
+          error_only_method_call<timeout>(method_name, std::move(self), args...);
         },
         token);
   }
+  template <std::chrono::microseconds const& timeout>
+  void error_only_method_call(std::string_view method_name, auto self, auto... args) {
+    connection_->async_method_call_timed(
+        [this, self_m = std::move(self), method_name](std::error_code const& err, errors::err_enum motor_err) mutable {
+          if (err) {
+            logger_.warn("{} failure: {}", method_name, err.message());
+            self_m.complete(err);
+            return;
+          }
+          using enum errors::err_enum;
+          self_m.complete(motor_error(motor_err));
+        },
+        service_name_, path_, interface_name_, std::string(method_name), timeout.count(), args...);
+  }
 };
 }  // namespace tfc::motor::types
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string_view>
 
 #include <fmt/format.h>
@@ -44,6 +45,8 @@ static constexpr std::string_view move_micrometre{ "Move_Micrometre" };
 static constexpr std::string_view move_home{ "Move_Home" };
 static constexpr std::string_view notify_after_micrometre{ "NotifyAfter_Micrometre" };
 static constexpr std::string_view notify_from_home_micrometre{ "NotifyFromHome_Micrometre" };
+// Start reading commands from the shared memory mailbox of the caller, see tfc/motor/mailbox.hpp
+static constexpr std::string_view open_mailbox{ "OpenMailbox" };
 }  // namespace method
 
 namespace types {
@@ -70,6 +73,13 @@ struct needs_homing {
   static constexpr auto dbus_reflection{ [](auto&& self) { return stx::to_tuple(std::forward<decltype(self)>(self)); } };
 };
 
+/// Reply of OpenMailbox, the session has to be in every command of the mailbox
+struct open_mailbox {
+  errors::err_enum err{ errors::err_enum::unknown };
+  std::uint64_t session{};
+  static constexpr auto dbus_reflection{ [](auto&& self) { return stx::to_tuple(std::forward<decltype(self)>(self)); } };
+};
+
 }  // namespace message
 
 }  // namespace tfc::motor::dbus
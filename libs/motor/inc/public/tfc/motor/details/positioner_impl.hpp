@@ -1,12 +1,21 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <chrono>
+#include <cmath>
+#include <concepts>
 #include <cstdint>
+#include <functional>
 #include <iterator>
+#include <limits>
+#include <map>
+#include <memory_resource>
 #include <optional>
 #include <string_view>
+#include <utility>
 #include <variant>
+#include <vector>
 
 #include <mp-units/systems/international.h>
 #include <mp-units/systems/si.h>
@@ -110,49 +119,115 @@ struct circular_buffer {
   typename std::array<storage_t, len>::iterator insert_pos_{ std::begin(buffer_) + 1 };  // this is front + 1
 };
 
+/// Statistics of the intervals between events over a window of the last circular_buffer_len intervals.
+/// The window starts out filled with zero intervals.
+/// Mean and variance are exact for the window, they are updated in constant time by replacing the oldest interval
+/// (Welford's update for a sliding window) and recomputed from the window each time it has been replaced entirely,
+/// so rounding errors do not accumulate. The sums used by estimated_interval are kept the same way.
 template <typename clock_t = asio::steady_timer::time_point::clock, std::size_t circular_buffer_len = 128>
 struct time_series_statistics {
   using duration_t = typename clock_t::duration;
   using time_point_t = typename clock_t::time_point;
 
+  /// \param now time the event was sampled, the first event only marks the start of the first interval
   void update(time_point_t const& now) noexcept {
-    // now let's calculate the average interval and variance
-    last_interval_ = now - buffer_.front().time_point;
-    auto const current_variance_increment{ std::pow(static_cast<double>(last_interval_.count()) - average_, 2) };
-
-    auto const removed{ buffer_.emplace(now, last_interval_, current_variance_increment) };
-
-    average_ += static_cast<double>(last_interval_.count() - removed.interval_duration.count()) / circular_buffer_len;
-    // Note the variance is actually incorrect but it serves the purpose of detecting if the variance is increasing or not.
-    // It is incorrect because it uses mean of values that have already been removed from the buffer to determine the
-    // incremental variance of the older items in the buffer. I think it is impossible to calculate the correct variance in
-    // constant time. For reference, see
-    // https://math.stackexchange.com/questions/102978/incremental-computation-of-standard-deviation
-    variance_ += (current_variance_increment - removed.variance_increment) / circular_buffer_len;
+    last_interval_ = count_ == 0 ? duration_t{} : now - buffer_.front().time_point;
+    count_++;
+    auto const removed{ buffer_.emplace(now, last_interval_) };
+
+    auto const added_value{ static_cast<double>(last_interval_.count()) };
+    auto const removed_value{ static_cast<double>(removed.interval_duration.count()) };
+    auto const previous_average{ average_ };
+    average_ += (added_value - removed_value) / circular_buffer_len;
+    sum_of_squares_ += (added_value - removed_value) * (added_value - average_ + removed_value - previous_average);
+    // every interval ages by one, the added one has age zero and the removed one has aged out of the window
+    constexpr auto len{ static_cast<double>(circular_buffer_len) };
+    sum_by_age_squared_ += 2 * sum_by_age_ + sum_ - len * len * removed_value;
+    sum_by_age_ += sum_ - len * removed_value;
+    sum_ += added_value - removed_value;
+    if (count_ % circular_buffer_len == 0) {
+      recompute();
+    }
   }
 
   auto buffer() const noexcept -> auto const& { return buffer_; }
 
-  auto average() const noexcept -> duration_t { return duration_t{ static_cast<typename duration_t::rep>(average_) }; }
+  auto average() const noexcept -> duration_t { return to_duration(average_); }
 
   auto last_interval() const noexcept -> duration_t { return last_interval_; }
 
-  auto stddev() const noexcept -> duration_t {
-    // assert(variance_ >= 0, "Variance is squared so it should be positive.");
-    return duration_t{ static_cast<typename duration_t::rep>(std::sqrt(variance_)) };
+  auto variance() const noexcept -> double { return std::max(sum_of_squares_, 0.0) / circular_buffer_len; }
+
+  auto stddev() const noexcept -> duration_t { return to_duration(std::sqrt(variance())); }
+
+  /// \brief interval between events estimated by a least squares fit of the event times in the window
+  /// A delayed event lengthens one interval and shortens the next, the fit weighs the intervals in the middle of the
+  /// window the most so such jitter cancels out, while average() is decided by the first and last event alone.
+  /// Only intervals which have been measured are used, zero when there are none.
+  auto estimated_interval() const noexcept -> duration_t {
+    auto const measured{ std::min<std::uint64_t>(count_ == 0 ? 0 : count_ - 1, circular_buffer_len) };
+    if (measured == 0) {
+      return duration_t{};
+    }
+    // the fit of n + 1 event times weighs the interval of age a by (a + 1) * (n - a) = n + (n - 1) * a - a * a, the
+    // intervals older than n are zero so the sums over the whole window can be used
+    auto const n{ static_cast<double>(measured) };
+    auto const weighted_sum{ n * sum_ + (n - 1) * sum_by_age_ - sum_by_age_squared_ };
+    auto const weights{ n * (n + 1) * (n + 2) / 6 };
+    return to_duration(weighted_sum / weights);
+  }
+
+  static auto to_duration(double count) noexcept -> duration_t {
+    return duration_t{ static_cast<typename duration_t::rep>(std::llround(count)) };
   }
 
   struct event_storage {
     time_point_t time_point{};
     duration_t interval_duration{};
-    double variance_increment{};
   };
+
+  void recompute() noexcept {
+    sum_ = 0;
+    sum_by_age_ = 0;
+    sum_by_age_squared_ = 0;
+    for (std::size_t age{}; age < circular_buffer_len; age++) {
+      auto const value{ static_cast<double>(buffer_[age].interval_duration.count()) };
+      auto const weight{ static_cast<double>(age) };
+      sum_ += value;
+      sum_by_age_ += weight * value;
+      sum_by_age_squared_ += weight * weight * value;
+    }
+    average_ = sum_ / circular_buffer_len;
+    sum_of_squares_ = 0;
+    for (auto const& event : buffer_.buffer_) {
+      sum_of_squares_ += std::pow(static_cast<double>(event.interval_duration.count()) - average_, 2);
+    }
+  }
+
   double average_{};
-  double variance_{};
+  double sum_of_squares_{};
+  // sums of the intervals in the window, plain and weighted by their age and squared age, for estimated_interval
+  double sum_{};
+  double sum_by_age_{};
+  double sum_by_age_squared_{};
+  std::uint64_t count_{};
   duration_t last_interval_{};
   circular_buffer<event_storage, circular_buffer_len> buffer_{};
 };
 
+/// \return time the latest value of the slot was sampled by its signal, the current time when the slot does not
+/// know or uses another clock
+template <typename clock_t, typename slot_t>
+auto sampled_at(slot_t const& slot) noexcept -> typename clock_t::time_point {
+  if constexpr (requires {
+                  { slot.sampled_at() } -> std::same_as<typename clock_t::time_point>;
+                }) {
+    return slot.sampled_at();
+  } else {
+    return clock_t::now();
+  }
+}
+
 template <typename manager_client_t = ipc_ruler::ipc_manager_client&,
           typename bool_slot_t = ipc::slot<ipc::details::type_bool, manager_client_t>,
           typename clock_t = asio::steady_timer::time_point::clock,
@@ -167,15 +242,17 @@ struct tachometer {
       : position_update_callback_{ std::move(position_update_callback) }, induction_sensor_{
           conn->get_io_context(), manager, fmt::format("tacho_{}", name),
           "Tachometer input, usually induction sensor directed to rotational metal star or plastic ring with metal bolts.",
-          std::bind_front(&tachometer::update, this)
+          [this](bool new_value) { update(new_value, sampled_at<clock_t>(induction_sensor_)); }
         } {}
 
-  void update(bool first_new_val) noexcept {
+  void update(bool first_new_val) noexcept { update(first_new_val, clock_t::now()); }
+
+  /// \param sampled_at time the input was sampled, jitter in delivering the value does not affect the statistics
+  void update(bool first_new_val, time_point_t sampled_at) noexcept {
     if (!first_new_val) {
       return;
     }
-    auto now{ clock_t::now() };
-    statistics_.update(now);
+    statistics_.update(sampled_at);
     auto constexpr increment{ 1 };
     position_ += increment;
     auto err{ errors::err_enum::success };
@@ -185,7 +262,7 @@ struct tachometer {
         statistics_.last_interval() < statistics_.average() * 4) {
       err = errors::err_enum::positioning_missing_event;
     }
-    std::invoke(position_update_callback_, increment, statistics().average(), statistics().stddev(), err);
+    std::invoke(position_update_callback_, increment, statistics().estimated_interval(), statistics().stddev(), err);
   }
 
   auto statistics() const noexcept -> auto const& { return statistics_; }
@@ -201,6 +278,7 @@ template <typename manager_client_t = ipc_ruler::ipc_manager_client&,
           typename clock_t = asio::steady_timer::time_point::clock,
           std::size_t circular_buffer_len = 128>
 struct encoder {
+  using time_point_t = typename clock_t::time_point;
   explicit encoder(std::shared_ptr<sdbusplus::asio::connection> conn,
                    manager_client_t manager,
                    std::string_view name,
@@ -209,11 +287,11 @@ struct encoder {
         sensor_a_{ conn->get_io_context(), manager, fmt::format("tacho_a_{}", name),
                    "First input of tachometer, with two sensors, usually induction sensor directed to rotational metal "
                    "star or plastic ring of metal bolts.",
-                   std::bind_front(&encoder::first_tacho_update, this) },
+                   [this](bool new_value) { first_tacho_update(new_value, sampled_at<clock_t>(sensor_a_)); } },
         sensor_b_{ conn->get_io_context(), manager, fmt::format("tacho_b_{}", name),
                    "First input of tachometer, with two sensors, usually induction sensor directed to rotational metal "
                    "star or plastic ring of metal bolts.",
-                   std::bind_front(&encoder::second_tacho_update, this) } {}
+                   [this](bool new_value) { second_tacho_update(new_value, sampled_at<clock_t>(sensor_b_)); } } {}
 
   struct storage {
     enum struct last_event_e : std::uint8_t { unknown = 0, first, second };
@@ -224,22 +302,27 @@ struct encoder {
 
   using last_event_t = typename storage::last_event_e;
 
-  void first_tacho_update(bool first_new_val) noexcept {
+  void first_tacho_update(bool first_new_val) noexcept { first_tacho_update(first_new_val, clock_t::now()); }
+
+  /// \param sampled_at time the input was sampled, jitter in delivering the value does not affect the statistics
+  void first_tacho_update(bool first_new_val, time_point_t sampled_at) noexcept {
     auto const increment{ first_new_val ? buffer_.front().second_tacho_state ? std::int8_t{ 1 } : std::int8_t{ -1 }
                           : buffer_.front().second_tacho_state ? std::int8_t{ -1 }
                                                                : std::int8_t{ 1 } };
-    update(increment, first_new_val, buffer_.front().second_tacho_state, storage::last_event_e::first);
+    update(increment, first_new_val, buffer_.front().second_tacho_state, storage::last_event_e::first, sampled_at);
   }
 
-  void second_tacho_update(bool second_new_val) noexcept {
+  void second_tacho_update(bool second_new_val) noexcept { second_tacho_update(second_new_val, clock_t::now()); }
+
+  /// \param sampled_at time the input was sampled, jitter in delivering the value does not affect the statistics
+  void second_tacho_update(bool second_new_val, time_point_t sampled_at) noexcept {
     auto const increment{ second_new_val ? buffer_.front().first_tacho_state ? std::int8_t{ -1 } : std::int8_t{ 1 }
                           : buffer_.front().first_tacho_state ? std::int8_t{ 1 }
                                                               : std::int8_t{ -1 } };
-    update(increment, buffer_.front().first_tacho_state, second_new_val, storage::last_event_e::second);
+    update(increment, buffer_.front().first_tacho_state, second_new_val, storage::last_event_e::second, sampled_at);
   }
 
-  void update(std::int8_t increment, bool first, bool second, last_event_t event) noexcept {
-    auto const now{ clock_t::now() };
+  void update(std::int8_t increment, bool first, bool second, last_event_t event, time_point_t sampled_at) noexcept {
     position_ += increment;
     errors::err_enum err{ errors::err_enum::success };
     if (buffer_[0].last_event == event && buffer_[1].last_event == event) {
@@ -248,9 +331,9 @@ struct encoder {
     } else if (buffer_[0].last_event == event && buffer_[1].last_event == buffer_[2].last_event) {
       err = errors::err_enum::positioning_AA_BB_events;
     }
-    statistics_.update(now);
+    statistics_.update(sampled_at);
     buffer_.emplace(first, second, event);
-    std::invoke(position_update_callback_, increment, statistics_.average(), statistics_.stddev(), err);
+    std::invoke(position_update_callback_, increment, statistics_.estimated_interval(), statistics_.stddev(), err);
   }
 
   std::int64_t position_{};  // todo now this is only for testing purposes, need to refactor tests
@@ -313,6 +396,96 @@ constexpr auto make_between_callable(unsigned_t before, unsigned_t now, bool for
   return [before, now](unsigned_t x) -> bool { return x >= now && x <= before; };
 }
 
+/// Pending position notifications ordered by position.
+/// Scheduling and cancelling is O(log n), firing the k notifications passed by a move is O(log n + k).
+/// Map nodes are recycled through a pool, so a steady stream of notifications does not hit the allocator.
+template <typename position_t, typename value_t>
+class notification_scheduler {
+public:
+  /// Identifies a scheduled notification, used to cancel it
+  struct handle {
+    position_t position{};
+    std::uint64_t id{};
+  };
+
+  notification_scheduler() = default;
+  notification_scheduler(notification_scheduler const&) = delete;
+  auto operator=(notification_scheduler const&) -> notification_scheduler& = delete;
+  notification_scheduler(notification_scheduler&&) noexcept = delete;
+  auto operator=(notification_scheduler&&) noexcept -> notification_scheduler& = delete;
+  ~notification_scheduler() = default;
+
+  auto schedule(position_t position, value_t&& value) -> handle {
+    handle const result{ position, next_id_++ };
+    entries_.emplace(key_t{ result.position, result.id }, std::move(value));
+    return result;
+  }
+
+  /// \return the value of the notification, std::nullopt if it has already fired or been cancelled
+  auto cancel(handle const& notification) -> std::optional<value_t> {
+    auto itr{ entries_.find(key_t{ notification.position, notification.id }) };
+    if (itr == entries_.end()) {
+      return std::nullopt;
+    }
+    std::optional<value_t> result{ std::move(itr->second) };
+    entries_.erase(itr);
+    return result;
+  }
+
+  /// \brief fire every notification from before to now, both included, same as make_between_callable
+  /// Moves which wrap around the ends of position_t are handled, notifications fire in the order they are passed.
+  /// \return number of notifications fired
+  template <std::invocable<value_t&&> callback_t>
+  auto fire(position_t before, position_t now, bool forward, callback_t&& callback) -> std::size_t {
+    // callbacks may schedule new notifications, take the fired ones out before calling any of them
+    std::vector<value_t> fired{ std::exchange(fired_, {}) };
+    auto const take{ [this, &fired](auto first, auto last) {
+      for (auto itr{ first }; itr != last; ++itr) {
+        fired.emplace_back(std::move(itr->second));
+      }
+      entries_.erase(first, last);
+    } };
+    auto const [from, to]{ forward ? std::pair{ before, now } : std::pair{ now, before } };
+    auto const lower{ [this](position_t position) { return entries_.lower_bound(key_t{ position, 0 }); } };
+    auto const upper{ [this](position_t position) {
+      return entries_.upper_bound(key_t{ position, std::numeric_limits<std::uint64_t>::max() });
+    } };
+    if (from <= to) {
+      take(lower(from), upper(to));
+    } else {
+      take(lower(from), entries_.end());
+      take(entries_.begin(), upper(to));
+    }
+    if (!forward) {
+      std::ranges::reverse(fired);
+    }
+    auto const count{ fired.size() };
+    for (auto& value : fired) {
+      std::invoke(callback, std::move(value));
+    }
+    fired.clear();
+    fired_ = std::move(fired);
+    return count;
+  }
+
+  void for_each(std::invocable<value_t&> auto&& callback) {
+    for (auto& [key, value] : entries_) {
+      std::invoke(callback, value);
+    }
+  }
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return entries_.size(); }
+  [[nodiscard]] auto empty() const noexcept -> bool { return entries_.empty(); }
+
+private:
+  // the id keeps notifications at the same position apart and in the order they were scheduled
+  using key_t = std::pair<position_t, std::uint64_t>;
+  std::pmr::unsynchronized_pool_resource pool_{};
+  std::pmr::map<key_t, value_t> entries_{ &pool_ };
+  std::vector<value_t> fired_{};
+  std::uint64_t next_id_{};
+};
+
 }  // namespace detail
 
 }  // namespace tfc::motor::positioner
@@ -38,6 +38,7 @@ enum struct err_enum : int {  // todo refactor to error_code_e ? or just error_e
   permission_denied = 30,
   operation_canceled = 31,  // only used between client and server, user should use std::errc::operation_canceled
   frequency_drive_reports_fault = 32,
+  timed_out = 33,  // only used between client and server, user should use std::errc::timed_out
   unknown = 100,
 };
 
@@ -59,6 +60,9 @@ inline std::error_code motor_error(const errors::err_enum error) {
   if (error == errors::err_enum::operation_canceled) {
     return std::make_error_code(std::errc::operation_canceled);
   }
+  if (error == errors::err_enum::timed_out) {
+    return std::make_error_code(std::errc::timed_out);
+  }
   auto const error_int = static_cast<int>(error);
   return std::error_code(error_int, category());
 }
@@ -72,6 +76,9 @@ inline errors::err_enum motor_enum(const std::error_code err) {
   if (err == std::errc::operation_canceled) {
     return operation_canceled;
   }
+  if (err == std::errc::timed_out) {
+    return timed_out;
+  }
   if (!err) {
     return success;
   }
@@ -0,0 +1,311 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fmt/format.h>
+#include <boost/asio/any_io_executor.hpp>
+
+#include <tfc/ipc/details/shm.hpp>
+#include <tfc/motor/dbus_tags.hpp>
+#include <tfc/motor/enums.hpp>
+#include <tfc/motor/errors.hpp>
+
+/// Shared memory command and status channel between a motor client and the ethercat process.
+/// D-Bus is used to find the motor and to open the mailbox, after that commands, their responses and the cyclic status
+/// of the drive go through shared memory regions, see tfc/ipc/details/shm.hpp.
+/// Each region has a single writer:
+///   commands  written by the motor client, read by the ethercat process
+///   responses written by the ethercat process, one per command when it completes
+///   status    written by the ethercat process every process data cycle
+/// OpenMailbox hands the peer a session, commands of any other session are rejected. The status tells the peer how far
+/// the drive has read its commands, the peer never posts more commands than the ring holds unread and gives up on
+/// commands which are not read by their deadline.
+namespace tfc::motor::mailbox {
+
+namespace asio = boost::asio;
+namespace shm = ipc::details::shm;
+
+enum struct command_e : std::uint8_t {
+  run = 0,
+  run_at_speedratio,
+  run_microsecond,
+  run_at_speedratio_microsecond,
+  stop,
+  quick_stop,
+  reset,
+  convey_micrometre,
+  move_micrometre,
+  move_speedratio_micrometre,
+  move_home,
+  notify_after_micrometre,
+  notify_from_home_micrometre,
+};
+
+/// The D-Bus method each command replaces, methods missing here are only available over D-Bus
+inline constexpr std::array<std::pair<std::string_view, command_e>, 13> methods{ {
+    { dbus::method::run, command_e::run },
+    { dbus::method::run_at_speedratio, command_e::run_at_speedratio },
+    { dbus::method::run_microsecond, command_e::run_microsecond },
+    { dbus::method::run_at_speedratio_microsecond, command_e::run_at_speedratio_microsecond },
+    { dbus::method::stop, command_e::stop },
+    { dbus::method::quick_stop, command_e::quick_stop },
+    { dbus::method::reset, command_e::reset },
+    { dbus::method::convey_micrometre, command_e::convey_micrometre },
+    { dbus::method::move_micrometre, command_e::move_micrometre },
+    { dbus::method::move_speedratio_micrometre, command_e::move_speedratio_micrometre },
+    { dbus::method::move_home, command_e::move_home },
+    { dbus::method::notify_after_micrometre, command_e::notify_after_micrometre },
+    { dbus::method::notify_from_home_micrometre, command_e::notify_from_home_micrometre },
+} };
+
+constexpr auto command_of(std::string_view method_name) noexcept -> std::optional<command_e> {
+  auto const itr{ std::ranges::find(methods, method_name, &std::pair<std::string_view, command_e>::first) };
+  if (itr == methods.end()) {
+    return std::nullopt;
+  }
+  return itr->second;
+}
+
+/// Time the drive has to read a command before its sender gives up on it
+inline constexpr std::chrono::milliseconds read_deadline{ 500 };
+
+/// \return read_by of a command posted now, see command::read_by
+inline auto make_read_by(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now()) noexcept
+    -> std::int64_t {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>((now + read_deadline).time_since_epoch()).count();
+}
+
+/// \return true if a command read at `now` is past its read_by, the drive then answers it with timed_out unrun
+inline auto stale(std::int64_t read_by,
+                  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now()) noexcept -> bool {
+  return read_by != 0 && std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count() > read_by;
+}
+
+struct command {
+  std::uint64_t id{};
+  std::uint64_t session{};  // see OpenMailbox
+  // CLOCK_MONOTONIC nanoseconds, the sender has given up on the command if the drive reads it later, 0 for no deadline
+  std::int64_t read_by{};
+  command_e type{ command_e::stop };
+  direction_e direction{ direction_e::forward };
+  double speedratio{};  // percent
+  std::int64_t micrometre{};
+  std::int64_t microsecond{};
+};
+
+struct response {
+  std::uint64_t id{};
+  errors::err_enum err{ errors::err_enum::unknown };
+  std::int64_t micrometre{};
+};
+
+struct status {
+  std::int64_t position_from_home{};  // micrometre
+  std::int16_t frequency{};           // decihertz
+  std::uint16_t current{};            // deciampere
+  std::uint8_t state_402{};           // cia_402::states_e
+  errors::err_enum drive_error{ errors::err_enum::success };
+  std::uint64_t session{};        // of the open mailbox, 0 when none is open
+  std::uint64_t commands_read{};  // index of the next command the drive will read
+};
+
+static_assert(std::is_trivially_copyable_v<command>);
+static_assert(std::is_trivially_copyable_v<response>);
+static_assert(std::is_trivially_copyable_v<status>);
+
+namespace detail {
+constexpr void assign(command& cmd, dbus::types::speedratio_t speedratio) noexcept {
+  cmd.speedratio = speedratio.numerical_value_in(mp_units::percent);
+}
+constexpr void assign(command& cmd, dbus::types::micrometre_t length) noexcept {
+  cmd.micrometre = length.numerical_value_in(dbus::types::micrometre_t::unit);
+}
+constexpr void assign(command& cmd, dbus::types::microsecond_t time) noexcept {
+  cmd.microsecond = time.numerical_value_in(dbus::types::microsecond_t::unit);
+}
+constexpr void assign(command& cmd, direction_e direction) noexcept {
+  cmd.direction = direction;
+}
+
+template <typename arg_t>
+concept command_argument = requires(command& cmd, arg_t arg) { detail::assign(cmd, arg); };
+}  // namespace detail
+
+/// \return the command equivalent of a D-Bus method call, std::nullopt if it has none
+template <typename... args_t>
+constexpr auto make_command(std::string_view method_name, args_t... args) noexcept -> std::optional<command> {
+  if constexpr (!(detail::command_argument<args_t> && ...)) {
+    return std::nullopt;
+  } else {
+    auto const type{ command_of(method_name) };
+    if (!type) {
+      return std::nullopt;
+    }
+    command result{ .type = type.value() };
+    (detail::assign(result, args), ...);
+    return result;
+  }
+}
+
+enum struct channel_e : std::uint8_t {
+  commands = 0,
+  responses,
+  status,
+};
+
+/// \return name of the region of a motor channel, unique per implementation and slave
+inline auto region_name(std::string_view implementation_name, std::uint16_t slave_id, channel_e channel) -> std::string {
+  constexpr std::array<std::string_view, 3> channel_names{ "commands", "responses", "status" };
+  return fmt::format("motor.{}.{}.{}", implementation_name, slave_id, channel_names[std::to_underlying(channel)]);
+}
+
+/// The regions carry raw mailbox structs, not ipc packets
+inline constexpr auto region_type{ ipc::details::type_e::unknown };
+
+/// Owner of a channel region
+template <typename message_t>
+class writer {
+public:
+  static auto create(std::string_view name) -> std::expected<writer, std::error_code> {
+    auto region{ shm::region::create(name, region_type, sizeof(message_t)) };
+    if (!region) {
+      return std::unexpected{ region.error() };
+    }
+    return writer{ std::move(region.value()) };
+  }
+
+  void post(message_t const& message) noexcept { region_.publish(std::as_bytes(std::span{ &message, 1 })); }
+
+  /// \brief post unless the ring is full of messages the reader has not read
+  /// \param read index of the next message the reader will read
+  /// \return std::errc::no_buffer_space instead of overwriting a message which has not been read
+  auto try_post(message_t const& message, std::uint64_t read) noexcept -> std::expected<void, std::error_code> {
+    if (region_.write_index() - read >= region_.capacity()) {
+      return std::unexpected{ std::make_error_code(std::errc::no_buffer_space) };
+    }
+    post(message);
+    return {};
+  }
+
+  /// \return index of the next message to be posted
+  [[nodiscard]] auto write_index() const noexcept -> std::uint64_t { return region_.write_index(); }
+
+private:
+  explicit writer(shm::region&& region) noexcept : region_{ std::move(region) } {}
+  shm::region region_;
+};
+
+/// \return the message at index, std::errc::resource_unavailable_try_again if it is not published yet and
+/// std::errc::no_buffer_space if the writer has lapped the reader
+template <typename message_t>
+auto read(shm::region const& region, std::uint64_t index) noexcept -> std::expected<message_t, std::error_code> {
+  std::array<std::byte, sizeof(message_t)> buffer{};
+  auto const size{ region.read(index, buffer) };
+  if (!size) {
+    return std::unexpected{ size.error() };
+  }
+  if (size.value() != sizeof(message_t)) {
+    return std::unexpected{ std::make_error_code(std::errc::protocol_error) };
+  }
+  message_t message{};
+  std::memcpy(&message, buffer.data(), sizeof(message_t));
+  return message;
+}
+
+/// \return the latest message of a region, read without waiting, std::nullopt if nothing has been published
+template <typename message_t>
+auto latest(shm::region const& region) noexcept -> std::optional<message_t> {
+  // the writer may lap the entry while it is being copied, the next one is then at least as new
+  for (std::size_t attempt = 0; attempt < 3; attempt++) {
+    auto const published{ region.write_index() };
+    if (published == 0) {
+      return std::nullopt;
+    }
+    if (auto message{ read<message_t>(region, published - 1) }) {
+      return message.value();
+    }
+  }
+  return std::nullopt;
+}
+
+/// Reads every message of a channel in order, woken by the writer through the region futex
+template <typename message_t>
+class reader {
+public:
+  static auto open(asio::any_io_executor executor, std::string_view name)
+      -> std::expected<std::unique_ptr<reader>, std::error_code> {
+    auto region{ shm::region::open(name, region_type, sizeof(message_t)) };
+    if (!region) {
+      return std::unexpected{ region.error() };
+    }
+    auto listener{ shm::listener::create(std::move(executor), std::move(region.value())) };
+    if (!listener) {
+      return std::unexpected{ listener.error() };
+    }
+    // only messages posted from now on, whatever was posted before was meant for a previous reader
+    // every message posted after this index rings the doorbell of the listener
+    auto const index{ listener.value()->mapping().write_index() };
+    return std::unique_ptr<reader>{ new reader{ std::move(listener.value()), index } };
+  }
+
+  /// \return the next message, std::nullopt when all have been read
+  /// \note messages lapped by the writer are lost, lost() counts them, a writer using try_post never laps
+  auto next() noexcept -> std::optional<message_t> {
+    auto const& region{ listener_->mapping() };
+    while (true) {
+      auto message{ read<message_t>(region, index_) };
+      if (message) {
+        index_++;
+        return message.value();
+      }
+      if (message.error() != std::errc::no_buffer_space) {
+        return std::nullopt;
+      }
+      // continue with the oldest message still in the ring
+      auto const oldest{ region.write_index() - region.capacity() + 1 };
+      lost_ += oldest - index_;
+      index_ = oldest;
+    }
+  }
+
+  [[nodiscard]] auto lost() const noexcept -> std::uint64_t { return lost_; }
+
+  /// \return index of the next message to be read, see writer::try_post
+  [[nodiscard]] auto read_index() const noexcept -> std::uint64_t { return index_; }
+
+  /// \return true when the writer has gone away, the reader should be dropped
+  [[nodiscard]] auto detached() const noexcept -> bool { return listener_->detached(); }
+
+  /// \return token which expires when this reader is destroyed
+  [[nodiscard]] auto alive() const noexcept -> std::weak_ptr<void> { return listener_->alive(); }
+
+  /// \brief wait for the writer to post, see shm::listener::async_wait
+  /// \note read the waiting messages with next() first, the wait completes when the writer posts again
+  template <typename completion_token_t>
+  auto async_wait(completion_token_t&& token) {
+    return listener_->async_wait(std::forward<completion_token_t>(token));
+  }
+
+private:
+  reader(std::unique_ptr<shm::listener> listener, std::uint64_t index)
+      : listener_{ std::move(listener) }, index_{ index } {}
+
+  std::unique_ptr<shm::listener> listener_;
+  std::uint64_t index_{};
+  std::uint64_t lost_{};
+};
+
+}  // namespace tfc::motor::mailbox
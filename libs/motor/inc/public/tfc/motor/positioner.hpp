@@ -150,21 +150,21 @@ public:
   /// \todo implicitly allow motor::errors::err_enum as param in token
   auto notify_at(absolute_position_t position, asio::completion_token_for<void(std::error_code)> auto&& token) ->
       typename asio::async_result<std::decay_t<decltype(token)>, void(std::error_code)>::return_type {
-    using cv = tfc::asio::condition_variable;
-    auto new_notification = std::make_shared<notification>(position, cv{ ctx_.get_executor() });
-    notifications_.emplace_back(new_notification);
     return asio::async_compose<decltype(token), void(std::error_code)>(
-        [first_call = true, new_notification](auto& self, std::error_code err = {}) mutable {
-          if (first_call) {
-            first_call = false;
-            new_notification->cv_.async_wait(std::move(self));
-            return;
-          }
-          if (err) {
-            self.complete(err);
-            return;
+        [this, position](auto& self) {
+          auto slot{ self.get_cancellation_state().slot() };
+          auto const scheduled{ notifications_.schedule(
+              position, notification{ .complete = [self_m = std::move(self), slot](std::error_code err) mutable {
+                slot.clear();
+                self_m.complete(err);
+              } }) };
+          if (slot.is_connected()) {
+            slot.assign([this, scheduled](asio::cancellation_type) {
+              if (auto cancelled{ notifications_.cancel(scheduled) }) {
+                complete(std::move(cancelled.value()), std::make_error_code(std::errc::operation_canceled));
+              }
+            });
           }
-          self.complete(motor_error(new_notification->err_));
         },
         token, ctx_);
   }
@@ -323,11 +323,11 @@ public:
 
 private:
   auto apply_error_to_pending_notifications(errors::err_enum err) -> void {
-    for (auto const& notification : notifications_) {
-      if (notification->err_ == errors::err_enum::success) {
-        notification->err_ = err;
+    notifications_.for_each([err](notification& pending) {
+      if (pending.err_ == errors::err_enum::success) {
+        pending.err_ = err;
       }
-    }
+    });
   }
   auto needs_homing(displacement_t increment) -> bool {
     if (!config_->needs_homing_after->has_value()) {
@@ -401,24 +401,22 @@ private:
   }
 
   void notify_if_applicable(absolute_position_t old_position, bool forward) {
-    auto const comparator{ detail::make_between_callable(old_position, absolute_position_, forward) };
-    std::erase_if(notifications_, [&comparator](auto& n) {
-      auto const pos{ n->abs_notify_pos_ };
-      if (comparator(pos)) {
-        n->cv_.notify_all();
-        return true;
-      }
-      return false;
+    notifications_.fire(old_position, absolute_position_, forward, [this](notification&& pending) {
+      auto const err{ motor_error(pending.err_) };
+      complete(std::move(pending), err);
     });
   }
 
   struct notification {
-    absolute_position_t abs_notify_pos_{};
-    tfc::asio::condition_variable cv_;
+    std::move_only_function<void(std::error_code)> complete;
     errors::err_enum err_{ errors::err_enum::success };
-    auto operator<=>(notification const& other) const noexcept { return abs_notify_pos_ <=> other.abs_notify_pos_; }
   };
 
+  /// Complete a notification from the executor, never inline from a position update or a cancellation
+  void complete(notification&& pending, std::error_code err) {
+    asio::post(ctx_, [callback = std::move(pending.complete), err]() mutable { std::invoke(callback, err); });
+  }
+
   absolute_position_t absolute_position_{};
   absolute_position_t travel_since_homed_{};
   absolute_position_t home_{};
@@ -443,7 +441,7 @@ private:
                detail::tachometer<manager_client_t>,
                detail::encoder<manager_client_t>>
       impl_{};
-  std::vector<std::shared_ptr<notification>> notifications_{};
+  detail::notification_scheduler<absolute_position_t, notification> notifications_{};
 
   bool missing_home_{ config_->needs_homing_after->has_value() };
 };
@@ -53,6 +53,8 @@ class motor_error_category_t : public std::error_category {
         return "Operation canceled";
       case frequency_drive_reports_fault:
         return "Frequency drive reports fault";
+      case timed_out:
+        return "Timed out";
       case unknown:
         return "Unknown error";
     }
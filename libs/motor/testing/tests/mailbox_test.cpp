@@ -0,0 +1,149 @@
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include <mp-units/systems/si.h>
+#include <boost/asio.hpp>
+#include <boost/ut.hpp>
+
+#include <tfc/motor/mailbox.hpp>
+
+namespace asio = boost::asio;
+namespace ut = boost::ut;
+namespace mailbox = tfc::motor::mailbox;
+using ut::expect;
+using ut::operator""_test;
+using ut::operator>>;
+using ut::fatal;
+using micrometre_t = tfc::motor::dbus::types::micrometre_t;
+using microsecond_t = tfc::motor::dbus::types::microsecond_t;
+using speedratio_t = tfc::motor::dbus::types::speedratio_t;
+using velocity_t = tfc::motor::dbus::types::velocity_t;
+
+auto main(int argc, char const* argv[]) -> int {
+  ut::detail::cfg::parse(argc, argv);
+
+  "D-Bus method calls map to commands"_test = [] {
+    namespace method = tfc::motor::dbus::method;
+    auto const cmd{ mailbox::make_command(method::move_speedratio_micrometre, 50.0 * mp_units::percent,
+                                          1200L * micrometre_t::reference) };
+    expect(fatal(cmd.has_value()));
+    expect(cmd->type == mailbox::command_e::move_speedratio_micrometre);
+    expect(cmd->speedratio == 50.0);
+    expect(cmd->micrometre == 1200);
+
+    auto const run{ mailbox::make_command(method::run_microsecond, 300L * microsecond_t::reference,
+                                          tfc::motor::direction_e::backward) };
+    expect(fatal(run.has_value()));
+    expect(run->microsecond == 300);
+    expect(run->direction == tfc::motor::direction_e::backward);
+
+    // only available over D-Bus
+    expect(!mailbox::make_command(method::ping).has_value());
+    expect(!mailbox::make_command(method::convey_micrometrepersecond_micrometre, 10L * velocity_t::reference,
+                                  10L * micrometre_t::reference)
+                .has_value());
+  };
+
+  "commands read after their read deadline are stale"_test = [] {
+    auto const now{ std::chrono::steady_clock::now() };
+    auto const read_by{ mailbox::make_read_by(now) };
+    expect(!mailbox::stale(read_by, now));
+    expect(!mailbox::stale(read_by, now + mailbox::read_deadline));
+    expect(mailbox::stale(read_by, now + mailbox::read_deadline + std::chrono::milliseconds{ 1 }));
+    // commands without a deadline never go stale
+    expect(!mailbox::stale(0, now + std::chrono::hours{ 1 }));
+  };
+
+  "commands are read in order"_test = [] {
+    asio::io_context ctx;
+    std::string const name{ mailbox::region_name("mailbox_test", 1, mailbox::channel_e::commands) };
+    auto writer{ mailbox::writer<mailbox::command>::create(name) };
+    expect(fatal(writer.has_value()));
+    // posted before the reader opened, not for this reader
+    writer->post({ .id = 1 });
+    auto reader{ mailbox::reader<mailbox::command>::open(ctx.get_executor(), name) };
+    expect(fatal(reader.has_value()));
+    expect(!reader.value()->next().has_value());
+
+    writer->post({ .id = 2, .type = mailbox::command_e::move_home });
+    writer->post({ .id = 3, .type = mailbox::command_e::quick_stop });
+    bool woken{ false };
+    reader.value()->async_wait([&](std::error_code const&) {
+      woken = true;
+      auto const first{ reader.value()->next() };
+      auto const second{ reader.value()->next() };
+      expect(fatal(first.has_value() && second.has_value()));
+      expect(first->id == 2 && first->type == mailbox::command_e::move_home);
+      expect(second->id == 3 && second->type == mailbox::command_e::quick_stop);
+      expect(!reader.value()->next().has_value());
+    });
+    ctx.run_for(std::chrono::seconds{ 1 });
+    expect(woken);
+    expect(reader.value()->lost() == 0);
+  };
+
+  "lapped commands are counted as lost"_test = [] {
+    asio::io_context ctx;
+    std::string const name{ mailbox::region_name("mailbox_test", 2, mailbox::channel_e::commands) };
+    auto writer{ mailbox::writer<mailbox::command>::create(name) };
+    expect(fatal(writer.has_value()));
+    auto reader{ mailbox::reader<mailbox::command>::open(ctx.get_executor(), name) };
+    expect(fatal(reader.has_value()));
+    std::uint64_t const posted{ tfc::ipc::details::shm::region::default_capacity + 4 };
+    for (std::uint64_t idx = 0; idx < posted; idx++) {
+      writer->post({ .id = idx });
+    }
+    std::uint64_t read{};
+    std::uint64_t last{};
+    while (auto cmd{ reader.value()->next() }) {
+      read++;
+      last = cmd->id;
+    }
+    expect(last == posted - 1);
+    expect(read + reader.value()->lost() == posted);
+    expect(reader.value()->lost() > 0);
+  };
+
+  "commands are not posted over unread ones"_test = [] {
+    asio::io_context ctx;
+    std::string const name{ mailbox::region_name("mailbox_test", 4, mailbox::channel_e::commands) };
+    auto writer{ mailbox::writer<mailbox::command>::create(name) };
+    expect(fatal(writer.has_value()));
+    auto reader{ mailbox::reader<mailbox::command>::open(ctx.get_executor(), name) };
+    expect(fatal(reader.has_value()));
+    std::uint64_t const capacity{ tfc::ipc::details::shm::region::default_capacity };
+    for (std::uint64_t idx = 0; idx < capacity; idx++) {
+      expect(writer->try_post({ .id = idx }, reader.value()->read_index()).has_value());
+    }
+    auto const full{ writer->try_post({ .id = capacity }, reader.value()->read_index()) };
+    expect(fatal(!full.has_value()));
+    expect(full.error() == std::errc::no_buffer_space);
+    expect(reader.value()->next()->id == 0);
+    expect(writer->try_post({ .id = capacity }, reader.value()->read_index()).has_value());
+    std::uint64_t last{};
+    while (auto cmd{ reader.value()->next() }) {
+      last = cmd->id;
+    }
+    expect(last == capacity);
+    expect(reader.value()->lost() == 0);
+    expect(reader.value()->read_index() == capacity + 1);
+  };
+
+  "status reads the latest"_test = [] {
+    std::string const name{ mailbox::region_name("mailbox_test", 3, mailbox::channel_e::status) };
+    auto writer{ mailbox::writer<mailbox::status>::create(name) };
+    expect(fatal(writer.has_value()));
+    auto region{ tfc::ipc::details::shm::region::open(name, mailbox::region_type, sizeof(mailbox::status)) };
+    expect(fatal(region.has_value()));
+    expect(!mailbox::latest<mailbox::status>(region.value()).has_value());
+    writer->post({ .position_from_home = 10 });
+    writer->post({ .position_from_home = 20, .frequency = 500 });
+    auto const status{ mailbox::latest<mailbox::status>(region.value()) };
+    expect(fatal(status.has_value()));
+    expect(status->position_from_home == 20);
+    expect(status->frequency == 500);
+  };
+
+  return 0;
+}
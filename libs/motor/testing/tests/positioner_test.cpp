@@ -225,11 +225,53 @@ PRAGMA_CLANG_WARNING_PUSH_OFF(-Wglobal-constructors)
               << fmt::format("expected stddev: {}, got stddev: {}\n", data.stddev, test.tachometer.statistics().stddev());
         };
       } |
-      // todo verify by hand the calculation is correct
-      std::vector{ data_t{ .time_between_teeth = 1ms, .stddev = 303315ns },
-                   data_t{ .time_between_teeth = 3ms, .stddev = 909945ns },
-                   data_t{ .time_between_teeth = 7ms, .stddev = 2123205ns },
-                   data_t{ .time_between_teeth = 17ms, .stddev = 5156355ns } };
+      // the window holds one doubled interval among nine, so the stddev is 0.3 times the interval
+      std::vector{ data_t{ .time_between_teeth = 1ms, .stddev = 300us },
+                   data_t{ .time_between_teeth = 3ms, .stddev = 900us },
+                   data_t{ .time_between_teeth = 7ms, .stddev = 2100us },
+                   data_t{ .time_between_teeth = 17ms, .stddev = 5100us } };
+
+  "tachometer estimated interval is less affected by a late event than the average"_test = [] {
+    tachometer_test test{};
+    tfc::testing::clock::set_ticks(tfc::testing::clock::time_point{});
+    for (std::size_t idx{ 0 }; idx < buffer_len * 2; idx++) {
+      tfc::testing::clock::set_ticks(tfc::testing::clock::now() + 1ms);
+      test.tachometer.update(true);
+    }
+    expect(test.tachometer.statistics().estimated_interval() == 1ms);
+    // an event stamped with its sampling time is on schedule however late it is delivered
+    test.tachometer.update(true, tfc::testing::clock::now() + 1ms);
+    expect(test.tachometer.statistics().estimated_interval() == 1ms);
+    // while one stamped on delivery is 500us late
+    tfc::testing::clock::set_ticks(tfc::testing::clock::now() + 2500us);
+    test.tachometer.update(true);
+    auto const average_error{ test.tachometer.statistics().average() - 1ms };
+    auto const estimate_error{ test.tachometer.statistics().estimated_interval() - 1ms };
+    expect(estimate_error > 0ms);
+    expect(estimate_error < average_error)
+        << fmt::format("estimate error {}, average error {}", estimate_error, average_error);
+  };
+
+  "tachometer estimated interval is kept up to date after the window has been replaced"_test = [] {
+    tachometer_test test{};
+    tfc::testing::clock::set_ticks(tfc::testing::clock::time_point{});
+    // alternating 900us and 1100us intervals, over more than two windows so the sums have been updated and recomputed
+    for (std::size_t idx{ 0 }; idx < buffer_len * 2 + 3; idx++) {
+      tfc::testing::clock::set_ticks(tfc::testing::clock::now() + (idx % 2 == 0 ? 900us : 1100us));
+      test.tachometer.update(true);
+    }
+    auto const& statistics{ test.tachometer.statistics() };
+    double weighted_sum{};
+    double weights{};
+    for (std::size_t age{ 0 }; age < buffer_len; age++) {
+      auto const weight{ static_cast<double>((age + 1) * (buffer_len - age)) };
+      weighted_sum += weight * static_cast<double>(statistics.buffer()[age].interval_duration.count());
+      weights += weight;
+    }
+    auto const expected{ std::chrono::nanoseconds{ std::llround(weighted_sum / weights) } };
+    expect(statistics.estimated_interval() == expected)
+        << fmt::format("expected {}, got {}", expected, statistics.estimated_interval());
+  };
 
   ut::skip / "tachometer average deviation threshold reached"_test = [] {
     bool called{};
@@ -803,5 +845,74 @@ int main(int argc, char** argv) {
     expect(buff[0] == 5);
   };
 
+  using scheduler_t = tfc::motor::positioner::detail::notification_scheduler<std::uint64_t, int>;
+  static constexpr auto max{ std::numeric_limits<std::uint64_t>::max() };
+
+  "notification_scheduler fires passed notifications in the order they are passed"_test = [] {
+    scheduler_t scheduler{};
+    scheduler.schedule(30, 3);
+    scheduler.schedule(10, 1);
+    scheduler.schedule(20, 2);
+    scheduler.schedule(40, 4);
+    std::vector<int> fired{};
+    auto const collect{ [&fired](int&& value) { fired.emplace_back(value); } };
+    expect(scheduler.fire(10, 30, true, collect) == 3);
+    expect(fired == std::vector{ 1, 2, 3 });
+    expect(scheduler.size() == 1);
+    fired.clear();
+    scheduler.schedule(20, 2);
+    scheduler.schedule(10, 1);
+    expect(scheduler.fire(40, 5, false, collect) == 3);
+    expect(fired == std::vector{ 4, 2, 1 });
+    expect(scheduler.empty());
+  };
+
+  "notification_scheduler fires across the wrap around of the position"_test = [] {
+    scheduler_t scheduler{};
+    scheduler.schedule(max - 1, 1);
+    scheduler.schedule(1, 2);
+    scheduler.schedule(100, 3);
+    std::vector<int> fired{};
+    auto const collect{ [&fired](int&& value) { fired.emplace_back(value); } };
+    expect(scheduler.fire(max - 10, 10, true, collect) == 2);
+    expect(fired == std::vector{ 1, 2 });
+    fired.clear();
+    scheduler.schedule(max - 1, 1);
+    scheduler.schedule(1, 2);
+    expect(scheduler.fire(10, max - 10, false, collect) == 2);
+    expect(fired == std::vector{ 2, 1 });
+    expect(scheduler.size() == 1);
+  };
+
+  "notification_scheduler keeps the schedule order at the same position"_test = [] {
+    scheduler_t scheduler{};
+    scheduler.schedule(10, 1);
+    scheduler.schedule(10, 2);
+    scheduler.schedule(10, 3);
+    std::vector<int> fired{};
+    expect(scheduler.fire(10, 10, true, [&fired](int&& value) { fired.emplace_back(value); }) == 3);
+    expect(fired == std::vector{ 1, 2, 3 });
+  };
+
+  "notification_scheduler cancel removes only the given notification"_test = [] {
+    scheduler_t scheduler{};
+    auto const first{ scheduler.schedule(10, 1) };
+    auto const second{ scheduler.schedule(10, 2) };
+    expect(scheduler.cancel(first) == 1);
+    expect(!scheduler.cancel(first).has_value());
+    std::vector<int> fired{};
+    expect(scheduler.fire(0, 20, true, [&fired](int&& value) { fired.emplace_back(value); }) == 1);
+    expect(fired == std::vector{ 2 });
+    expect(!scheduler.cancel(second).has_value());
+  };
+
+  "notification_scheduler callbacks may schedule new notifications"_test = [] {
+    scheduler_t scheduler{};
+    scheduler.schedule(10, 1);
+    expect(scheduler.fire(0, 20, true, [&scheduler](int&& value) { scheduler.schedule(15, value + 1); }) == 1);
+    expect(scheduler.size() == 1);
+    expect(scheduler.fire(15, 15, true, [](int&& value) { expect(value == 2); }) == 1);
+  };
+
   return EXIT_SUCCESS;
 }
@@ -115,6 +115,14 @@ constexpr auto make_mapping_value() -> uint32_t {
   return static_cast<working_counter_t>(ecx_receive_processdata(context, static_cast<int>(timeout.count())));
 }
 
+[[nodiscard, maybe_unused]] inline auto recieve_processdata_group(ecx_contextt* context,
+                                                                  uint8_t group_index,
+                                                                  microseconds timeout = constants::timeout_tx_to_rx)
+    -> working_counter_t {
+  return static_cast<working_counter_t>(
+      ecx_receive_processdata_group(context, group_index, static_cast<int>(timeout.count())));
+}
+
 /**
  *
  * @param context pointer to the soem context
@@ -146,7 +154,7 @@ constexpr auto make_mapping_value() -> uint32_t {
  * @return IOmap size
  */
 inline auto config_map_group(ecx_contextt* context, std::ranges::view auto buffer, uint8_t group_index) -> size_t {
-  return ecx_config_map_group(context, buffer.data(), group_index) > 0;
+  return static_cast<size_t>(ecx_config_map_group(context, buffer.data(), group_index));
 }
 
 inline auto write_state(ecx_contextt* context, uint16_t slave_index) -> working_counter_t {
@@ -154,11 +162,11 @@ inline auto write_state(ecx_contextt* context, uint16_t slave_index) -> working_
 }
 
 inline auto config_map_group_aligned(ecx_contextt* context, std::ranges::view auto buffer, uint8_t group_index) -> size_t {
-  return ecx_config_map_group_aligned(context, buffer.data(), group_index) > 0;
+  return static_cast<size_t>(ecx_config_map_group_aligned(context, buffer.data(), group_index));
 }
 
 inline auto config_overlap_map_group(ecx_contextt* context, std::ranges::view auto buffer, uint8_t group_index) -> size_t {
-  return ecx_config_overlap_map_group(context, buffer.data(), group_index) > 0;
+  return static_cast<size_t>(ecx_config_overlap_map_group(context, buffer.data(), group_index));
 }
 
 [[maybe_unused]] inline auto configdc(ecx_contextt* context) -> bool {
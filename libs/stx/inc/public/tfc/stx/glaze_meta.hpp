@@ -191,6 +191,26 @@ struct to_json<std::chrono::duration<rep_t, period_t>> {
   }
 };
 
+// BEVE stores the count only, the unit is given by the type on both ends
+template <typename rep_t, typename period_t>
+struct from_binary<std::chrono::duration<rep_t, period_t>> {
+  template <auto opts>
+  static void op(std::chrono::duration<rep_t, period_t>& value, auto&&... args) {
+    rep_t rep{};
+    from_binary<rep_t>::template op<opts>(rep, args...);
+    value = std::chrono::duration<rep_t, period_t>{ rep };
+  }
+};
+
+template <typename rep_t, typename period_t>
+struct to_binary<std::chrono::duration<rep_t, period_t>> {
+  template <auto opts>
+  static void op(auto&& value, auto&&... args) noexcept {
+    rep_t const rep{ value.count() };
+    to_binary<rep_t>::template op<opts>(rep, args...);
+  }
+};
+
 template <typename duration_t>
   requires(!std::is_same_v<duration_t, std::chrono::microseconds> && !std::is_same_v<duration_t, std::chrono::nanoseconds>)
 constexpr auto parse8601(const std::string& save) -> date::sys_time<duration_t> {